@@ -175,22 +175,32 @@ public:
         Py_INCREF(callback);
         m_callback = callback;
     }
+    %s(const %s &o)
+    {
+        Py_INCREF(o.m_callback);
+        m_callback = o.m_callback;
+    }
     virtual ~%s()
     {
         Py_DECREF(m_callback);
         m_callback = NULL;
     }
 
-    virtual bool IsEqual(ns3::Ptr<const ns3::CallbackImplBase> other_base) const
+    virtual bool IsEqual(const ns3::CallbackImplBase *other_base) const
     {
-        const %s *other = dynamic_cast<const %s*> (ns3::PeekPointer (other_base));
+        const %s *other = dynamic_cast<const %s*> (other_base);
         if (other != NULL)
             return (other->m_callback == m_callback);
         else
             return false;
     }
 
-''' % (class_name, ', '.join(template_parameters), class_name, class_name, class_name, class_name))
+    virtual ns3::CallbackImplBase *Copy(void *buffer) const
+    {
+        return ns3::CallbackImplCopy (*this, buffer);
+    }
+
+''' % (class_name, ', '.join(template_parameters), class_name, class_name, class_name, class_name, class_name, class_name, class_name))
         sink.indent()
         callback_return = template_parameters[0]
         return_ctype = ctypeparser.parse_type(callback_return)
@@ -0,0 +1,111 @@
+AR = '/usr/bin/ar'
+ARFLAGS = 'rcs'
+BOOST = False
+BOOST_VERSION = '1_74'
+CC = ['/usr/bin/gcc']
+CCDEFINES = ['NS3_ASSERT_ENABLE', 'NS3_LOG_ENABLE']
+CCDEFINES_ST = '-D%s'
+CCFLAGS = ['-w', '-std=gnu++98', '-g', '-O0', '-fpermissive', '-w', '-include', 'unistd.h', '-include', 'stddef.h', '-include', 'stdlib.h', '-Wno-error=deprecated-declarations', '-fstrict-aliasing', '-Wstrict-aliasing']
+CCFLAGS_DEBUG = ['-g']
+CCFLAGS_MACBUNDLE = ['-fPIC']
+CCFLAGS_PTHREAD = '-pthread'
+CCFLAGS_RELEASE = ['-O2']
+CCLNK_SRC_F = ''
+CCLNK_TGT_F = ['-o', '']
+CC_NAME = 'gcc'
+CC_SRC_F = ''
+CC_TGT_F = ['-c', '-o', '']
+CC_VERSION = ('12', '2', '0')
+COMPILER_CC = 'gcc'
+COMPILER_CXX = 'g++'
+CPP = '/usr/bin/cpp'
+CPPPATH_BOOST = '/usr/include'
+CPPPATH_ST = '-I%s'
+CXX = ['/usr/bin/g++']
+CXXDEFINES = ['NS3_ASSERT_ENABLE', 'NS3_LOG_ENABLE']
+CXXDEFINES_ST = '-D%s'
+CXXFLAGS = ['-std=gnu++98', '-g', '-O0', '-fpermissive', '-w', '-include', 'unistd.h', '-include', 'stddef.h', '-include', 'stdlib.h']
+CXXFLAGS_DEBUG = ['-g']
+CXXFLAGS_PTHREAD = '-pthread'
+CXXFLAGS_RELEASE = ['-O2']
+CXXLNK_SRC_F = ''
+CXXLNK_TGT_F = ['-o', '']
+CXX_NAME = 'gcc'
+CXX_SRC_F = ''
+CXX_TGT_F = ['-c', '-o', '']
+DEST_BINFMT = 'elf'
+DEST_CPU = 'x86_64'
+DEST_OS = 'linux'
+DOXYGEN = ''
+ENABLE_EMU = True
+ENABLE_EXAMPLES = True
+ENABLE_GSL = False
+ENABLE_GTK_CONFIG_STORE = False
+ENABLE_LIBXML2 = False
+ENABLE_NSC = False
+ENABLE_PYTHON_BINDINGS = False
+ENABLE_PYTHON_PCH = False
+ENABLE_REAL_TIME = True
+ENABLE_STATIC_NS3 = False
+ENABLE_SUDO = False
+ENABLE_TAP = True
+ENABLE_THREADING = True
+EXAMPLE_DIRECTORIES = ['tcp', 'energy', 'routing', 'stats', 'udp-client-server', 'error-model', 'wireless', 'tutorial', 'udp', 'socket', 'realtime', 'naming', 'ipv6', 'mpi', 'mobility', 'matrix-topology']
+FULLSTATIC_MARKER = '-static'
+GSL = False
+GTK_CONFIG_STORE = False
+HAVE_GETENV = 1
+HAVE_IF_TUN_H = 1
+HAVE_INTTYPES_H = 1
+HAVE_NETINET_IN_H = 1
+HAVE_PACKET_H = 1
+HAVE_PTHREAD_H = 1
+HAVE_SIGNAL_H = 1
+HAVE_STDINT_H = 1
+HAVE_STDLIB_H = 1
+HAVE_SYS_INT_TYPES_H = ()
+HAVE_SYS_SOCKET_H = 1
+HAVE_UINT128_T = ()
+HAVE___UINT128_T = 1
+LIBPATH_ST = '-L%s'
+LIBXML2 = False
+LIB_RT = ['rt']
+LIB_ST = '-l%s'
+LINKFLAGS = ['-Wl,--no-as-needed']
+LINKFLAGS_MACBUNDLE = ['-bundle', '-undefined', 'dynamic_lookup']
+LINKFLAGS_PTHREAD = '-pthread'
+LINK_CC = ['/usr/bin/gcc']
+LINK_CXX = ['/usr/bin/g++']
+MPI = '/usr/bin/mpic++'
+NS3_ACTIVE_VARIANT = 'debug'
+NS3_BUILDDIR = '/root/repo/build'
+NS3_ENABLED_MODULES = ['ns3-core', 'ns3-network', 'ns3-internet', 'ns3-wifi', 'ns3-csma', 'ns3-point-to-point', 'ns3-uan', 'ns3-mobility', 'ns3-aodv', 'ns3-olsr', 'ns3-mesh', 'ns3-emu', 'ns3-tap-bridge', 'ns3-applications', 'ns3-propagation', 'ns3-energy', 'ns3-stats', 'ns3-bridge', 'ns3-flow-monitor', 'ns3-dsdv', 'ns3-nix-vector-routing', 'ns3-config-store', 'ns3-tools', 'ns3-topology-read', 'ns3-virtual-net-device', 'ns3-spectrum', 'ns3-netanim', 'ns3-test', 'ns3-mpi', 'ns3-ns3tcp']
+NS3_EXECUTABLE_PATH = ['/root/repo/build/debug/src/devices/emu', '/root/repo/build/debug/src/devices/tap-bridge']
+NS3_MODULES = ['ns3-core', 'ns3-network', 'ns3-config-store', 'ns3-internet', 'ns3-propagation', 'ns3-point-to-point', 'ns3-csma', 'ns3-emu', 'ns3-bridge', 'ns3-tap-bridge', 'ns3-virtual-net-device', 'ns3-applications', 'ns3-nix-vector-routing', 'ns3-olsr', 'ns3-aodv', 'ns3-dsdv', 'ns3-click', 'ns3-openflow', 'ns3-mobility', 'ns3-wifi', 'ns3-netanim', 'ns3-stats', 'ns3-uan', 'ns3-spectrum', 'ns3-mesh', 'ns3-test', 'ns3-ns3tcp', 'ns3-ns3wifi', 'ns3-flow-monitor', 'ns3-wimax', 'ns3-lte', 'ns3-mpi', 'ns3-topology-read', 'ns3-energy', 'ns3-tools', 'ns3-visualizer']
+NS3_MODULE_PATH = ['/usr/lib/gcc/x86_64-linux-gnu/12', '/root/repo/build/debug']
+NS3_OPTIONAL_FEATURES = [('Threading', 'Threading Primitives', True, '<pthread.h> include not detected'), ('RealTime', 'Real Time Simulator', True, 'threading not enabled'), ('EventProfiler', 'Event Profiler', False, 'option --enable-event-profiler not selected'), ('EmuNetDevice', 'Emulated Net Device', True, '<netpacket/packet.h> include not detected'), ('TapBridge', 'Tap Bridge', True, '<linux/if_tun.h> include not detected'), ('GtkConfigStore', 'GtkConfigStore', False, "library 'gtk+-2.0 >= 2.12' not found"), ('XmlIo', 'XmlIo', False, "library 'libxml-2.0 >= 2.7' not found"), ('nsc', 'Network Simulation Cradle', False, 'NSC not found (see option --with-nsc)'), ('nsclick', 'NS-3 Click Integration', False, 'nsclick not enabled (see option --with-nsclick)'), ('openflow', 'NS-3 OpenFlow Integration', False, 'Required boost libraries not found'), ('python', 'Python Bindings', False, 'disabled by user request'), ('mpi', 'MPI Support', False, 'option --enable-mpi not selected'), ('ENABLE_SUDO', 'Use sudo to set suid bit', False, 'option --enable-sudo not selected'), ('ENABLE_EXAMPLES', 'Build examples and samples', True, 'defaults to enabled'), ('static', 'Static build', False, 'option --enable-static not selected'), ('GSL', 'GNU Scientific Library (GSL)', False, 'GSL not found')]
+PKG_CONFIG = '/usr/bin/pkg-config'
+PLATFORM = 'linux2'
+PREFIX = '/usr/local'
+RANLIB = '/usr/bin/ranlib'
+RPATH_ST = '-Wl,-rpath,%s'
+SHLIB_MARKER = '-Wl,-Bdynamic'
+SONAME_ST = '-Wl,-h,%s'
+STATICLIBPATH_ST = '-L%s'
+STATICLIB_MARKER = '-Wl,-Bstatic'
+STATICLIB_ST = '-l%s'
+SUDO = ''
+USE_HIGH_PRECISION_128 = 1
+VALGRIND = ''
+WL_SONAME_SUPPORTED = True
+_VARIANT_ = 'debug'
+cfg_files = ['ns3/core-config.h', 'ns3/config-store-config.h', 'ns3/net-anim-config.h']
+defines = {'HAVE___UINT128_T': 1, 'HAVE_SYS_SOCKET_H': 1, 'HAVE_SIGNAL_H': 1, 'HAVE_NETINET_IN_H': 1, 'HAVE_GETENV': 1, 'HAVE_IF_TUN_H': 1, 'HAVE_INTTYPES_H': 1, 'HAVE_UINT128_T': (), 'HAVE_STDLIB_H': 1, 'HAVE_PTHREAD_H': 1, 'HAVE_STDINT_H': 1, 'HAVE_SYS_INT_TYPES_H': (), 'HAVE_PACKET_H': 1, 'USE_HIGH_PRECISION_128': 1}
+macbundle_PATTERN = '%s.bundle'
+program_PATTERN = '%s'
+shlib_CCFLAGS = ['-fPIC', '-DPIC']
+shlib_CXXFLAGS = ['-fPIC', '-DPIC']
+shlib_LINKFLAGS = ['-shared']
+shlib_PATTERN = 'lib%s.so'
+staticlib_LINKFLAGS = ['-Wl,-Bstatic']
+staticlib_PATTERN = 'lib%s.a'
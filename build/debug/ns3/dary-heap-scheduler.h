@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DARY_HEAP_SCHEDULER_H
+#define DARY_HEAP_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a d-ary heap event scheduler
+ *
+ * This is an implicit heap in which each node has 4 children by
+ * default (the "Arity" attribute can be set to 2, 4, 8 or 16). Compared
+ * to the HeapScheduler, the tree is much shallower and it is laid out
+ * to make the most of the data caches:
+ *  - the keys of the events (16 bytes each) are stored in one array
+ *    and the EventImpl pointers in another one, so that sifting an event
+ *    down only reads keys,
+ *  - the key array is aligned on a 64 byte boundary and shifted so
+ *    that the children of a node always start a new cache line: with 4
+ *    children, each level of the tree touches exactly one cache line.
+ *
+ * A batch of events at least as large as the heap is inserted by
+ * rebuilding the heap, in linear time.
+ *
+ * Each event records its position in the heap with
+ * EventImpl::SetSchedulerIndex, so that Remove takes logarithmic time.
+ */
+class DaryHeapScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  DaryHeapScheduler ();
+  virtual ~DaryHeapScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual void InsertBatch (const std::vector<Event> &events);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+  virtual void RemoveCancelled (std::vector<Event> &removed);
+
+private:
+  void SetArity (uint32_t arity);
+  uint32_t GetArity (void) const;
+  void Reserve (uint32_t capacity);
+  inline uint32_t Parent (uint32_t index) const;
+  inline uint32_t FirstChild (uint32_t index) const;
+  inline void Set (uint32_t index, const EventKey &key, EventImpl *impl);
+  inline void Move (uint32_t to, uint32_t from);
+  void SiftUp (uint32_t index, const EventKey &key, EventImpl *impl);
+  void SiftDown (uint32_t index, const EventKey &key, EventImpl *impl);
+  void Heapify (void);
+
+  // m_keys and m_impls are indexed by the position of an event in the
+  // heap, plus m_arity - 1, the size of the padding which aligns the
+  // children of every node on a multiple of m_arity.
+  EventKey *m_keys;
+  EventImpl **m_impls;
+  uint32_t m_size;
+  uint32_t m_capacity;
+  uint32_t m_arity;
+  uint32_t m_log2Arity;
+};
+
+} // namespace ns3
+
+#endif /* DARY_HEAP_SCHEDULER_H */
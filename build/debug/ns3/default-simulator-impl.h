@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005,2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+
+#ifndef DEFAULT_SIMULATOR_IMPL_H
+#define DEFAULT_SIMULATOR_IMPL_H
+
+#include "simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "event-memory-pool.h"
+#include "event-profiler.h"
+
+#include "ns3/ptr.h"
+
+#include <list>
+
+namespace ns3 {
+
+class DefaultSimulatorImpl : public SimulatorImpl
+{
+public:
+  static TypeId GetTypeId (void);
+
+  DefaultSimulatorImpl ();
+  ~DefaultSimulatorImpl ();
+
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual Time Next (void) const;
+  virtual void Stop (void);
+  virtual void Stop (Time const &time);
+  virtual EventId Schedule (Time const &time, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event);
+  virtual void ScheduleBatch (const std::vector<BatchEvent> &events, std::vector<EventId> &ids);
+  virtual void ScheduleWithContextBatch (const std::vector<BatchEvent> &events);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &ev);
+  virtual void Cancel (const EventId &ev);
+  virtual bool IsExpired (const EventId &ev) const;
+  virtual void Run (void);
+  virtual void RunOneEvent (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const; 
+  virtual uint32_t GetContext (void) const;
+
+  /**
+   * \returns the number of events which are stored in the event list,
+   *          including those which have been cancelled.
+   */
+  uint32_t GetEventCount (void) const;
+  /**
+   * \returns the number of events which have been cancelled but which
+   *          are still stored in the event list.
+   */
+  uint32_t GetCancelledEventCount (void) const;
+  /**
+   * \returns the number of times the event list has been compacted.
+   */
+  uint64_t GetCompactionCount (void) const;
+  /**
+   * \returns the total number of cancelled events which have been
+   *          removed from the event list by compactions.
+   */
+  uint64_t GetCompactedEventCount (void) const;
+
+protected:
+  virtual void NotifyConstructionCompleted (void);
+
+private:
+  virtual void DoDispose (void);
+  void ProcessOneEvent (void);
+  void Compact (void);
+  void InsertBatch (const std::vector<BatchEvent> &events, bool withContext);
+  uint64_t NextTs (void) const;
+  typedef std::list<EventId> DestroyEvents;
+
+  DestroyEvents m_destroyEvents;
+  bool m_stop;
+  Ptr<Scheduler> m_events;
+  uint32_t m_uid;
+  uint32_t m_currentUid;
+  uint64_t m_currentTs;
+  uint32_t m_currentContext;
+  // number of events that have been inserted but not yet scheduled,
+  // not counting the "destroy" events; this is used for validation
+  int m_unscheduledEvents;
+  // if true, all events are allocated from m_eventPool
+  bool m_enableEventPool;
+  EventMemoryPool *m_eventPool;
+  // number of events in m_events which have been cancelled.
+  uint32_t m_cancelledEvents;
+  // the event list is compacted when the proportion of cancelled
+  // events goes above m_compactionRatio, provided that there are
+  // at least m_compactionMinEvents cancelled events.
+  double m_compactionRatio;
+  uint32_t m_compactionMinEvents;
+  uint64_t m_compactions;
+  uint64_t m_compactedEvents;
+  // only used when ns-3 was configured with --enable-event-profiler
+  bool m_enableProfiler;
+  EventProfiler *m_profiler;
+  // reused by InsertBatch to avoid an allocation per batch
+  std::vector<Scheduler::Event> m_batch;
+};
+
+} // namespace ns3
+
+#endif /* DEFAULT_SIMULATOR_IMPL_H */
@@ -0,0 +1,13 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_EMU
+    
+
+// Module headers:
+#include "emu-helper.h"
+#include "emu-net-device.h"
+#include "emu.h"
+#endif
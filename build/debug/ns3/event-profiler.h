@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <stdint.h>
+#include <map>
+#include <ostream>
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ * \brief accumulate the wall-clock time spent in each kind of event
+ *
+ * The time spent in each event is attributed to the concrete class of
+ * its EventImpl (that is, for the events created by MakeEvent, to the
+ * type of the object and of the member function or function which is
+ * invoked) and to the context of the event (the id of the node it runs
+ * on).
+ *
+ * DefaultSimulatorImpl uses an EventProfiler when its "EnableProfiler"
+ * attribute is set and ns-3 was configured with --enable-event-profiler.
+ * Otherwise, no time is measured at all, and this class is not built.
+ */
+class EventProfiler
+{
+public:
+  EventProfiler ();
+
+  /**
+   * Must be called just before an event is invoked.
+   */
+  void Start (void);
+  /**
+   * \param event the event which was just invoked
+   * \param context the context of this event
+   *
+   * Must be called just after an event was invoked.
+   */
+  void Stop (const EventImpl *event, uint32_t context);
+
+  /**
+   * \param os the stream to write the report to
+   *
+   * Write the number of events and the time spent in them for each
+   * kind of event and for the busiest contexts, most expensive first.
+   */
+  void Report (std::ostream &os) const;
+
+  /**
+   * \returns the total number of events profiled.
+   */
+  uint64_t GetEventCount (void) const;
+
+private:
+  struct Stats
+  {
+    Stats ();
+    uint64_t count;
+    uint64_t ns;
+  };
+  static uint64_t GetNanoSeconds (void);
+
+  // indexed by the mangled name of the class of the event, which
+  // is unique for each class within a library.
+  std::map<const char *, Stats> m_types;
+  std::map<uint32_t, Stats> m_contexts;
+  uint64_t m_start;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
@@ -0,0 +1,19 @@
+/* Configuration header created by Waf - do not edit */
+#ifndef _NS3_NET_ANIM_CONFIG_H_WAF
+#define _NS3_NET_ANIM_CONFIG_H_WAF
+
+#define HAVE_STDLIB_H 1
+#define HAVE_GETENV 1
+#define HAVE_SIGNAL_H 1
+#define HAVE_PTHREAD_H 1
+/* #undef HAVE_UINT128_T */
+#define HAVE___UINT128_T 1
+#define USE_HIGH_PRECISION_128 1
+#define HAVE_STDINT_H 1
+#define HAVE_INTTYPES_H 1
+/* #undef HAVE_SYS_INT_TYPES_H */
+#define HAVE_PACKET_H 1
+#define HAVE_IF_TUN_H 1
+#define HAVE_SYS_SOCKET_H 1
+#define HAVE_NETINET_IN_H 1
+#endif /* _NS3_NET_ANIM_CONFIG_H_WAF */
@@ -0,0 +1,15 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_NETANIM
+    
+
+// Module headers:
+#include "animation-interface.h"
+#include "canvas-location.h"
+#include "point-to-point-dumbbell-helper.h"
+#include "point-to-point-grid-helper.h"
+#include "point-to-point-star-helper.h"
+#endif
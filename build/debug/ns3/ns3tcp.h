@@ -0,0 +1,9 @@
+/**
+ * \ingroup tests
+ * \defgroup Ns3TcpTests ns-3 TCP Implementation Tests
+ *
+ * \section Ns3TcpTestsOverview ns-3 Tcp Implementation Tests Overview
+ *
+ * Includes tests of ns-3 TCP as well as tests involving the mix
+ * of ns-3 and Network Simulation Cradle (nsc) TCP models.
+ */
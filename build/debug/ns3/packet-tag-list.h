@@ -0,0 +1,208 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+#ifndef PACKET_TAG_LIST_H
+#define PACKET_TAG_LIST_H
+
+#include <stdint.h>
+#include <ostream>
+#include <string.h>
+#include "ns3/type-id.h"
+
+namespace ns3 {
+
+class Tag;
+
+/**
+ * \ingroup constants
+ * \brief Tag maximum size
+ * The maximum size (in bytes) of a Tag is stored
+ * in this constant.
+ */
+#define PACKET_TAG_MAX_SIZE 20
+
+class PacketTagIterator;
+
+/**
+ * \internal
+ * \brief the packet tags of a packet
+ *
+ * The first PACKET_TAG_INLINE tags added to a packet are stored
+ * inside the PacketTagList itself, with their TypeIds in an array of
+ * their own, so that copying a packet does not touch any other memory
+ * and finding one of these tags only scans this array. The tags added
+ * after these are kept in a list of TagData, which is shared by the
+ * copies of a packet until one of them removes a tag from it.
+ */
+class PacketTagList 
+{
+public:
+  struct TagData {
+    uint8_t data[PACKET_TAG_MAX_SIZE];
+    struct TagData *next;
+    TypeId tid;
+    uint32_t count;
+  };
+
+  inline PacketTagList ();
+  inline PacketTagList (PacketTagList const &o);
+  inline PacketTagList &operator = (PacketTagList const &o);
+  inline ~PacketTagList ();
+
+  void Add (Tag const&tag) const;
+  bool Remove (Tag &tag);
+  bool Peek (Tag &tag) const;
+  inline void RemoveAll (void);
+  /**
+   * \param o the list to copy
+   *
+   * Replace the content of this list by a copy of o which does not
+   * share any TagData with it.
+   */
+  void DeepCopy (PacketTagList const &o);
+
+private:
+  friend class PacketTagIterator;
+
+  enum {
+    PACKET_TAG_INLINE = 4
+  };
+
+  inline void CopyInline (PacketTagList const &o);
+  inline void RemoveList (void);
+  inline int32_t FindInline (TypeId tid) const;
+  bool RemoveFromList (Tag &tag);
+  struct PacketTagList::TagData *AllocData (void) const;
+  void FreeData (struct TagData *data) const;
+
+  TypeId m_inlineTid[PACKET_TAG_INLINE];
+  uint8_t m_inlineData[PACKET_TAG_INLINE][PACKET_TAG_MAX_SIZE];
+  uint32_t m_nInline;
+  struct TagData *m_next;
+};
+
+} // namespace ns3
+
+/****************************************************
+ *  Implementation of inline methods for performance
+ ****************************************************/
+
+namespace ns3 {
+
+PacketTagList::PacketTagList ()
+  : m_nInline (0),
+    m_next ()
+{
+}
+
+PacketTagList::PacketTagList (PacketTagList const &o)
+  : m_nInline (o.m_nInline),
+    m_next (o.m_next)
+{
+  CopyInline (o);
+  if (m_next != 0)
+    {
+      m_next->count++;
+    }
+}
+
+PacketTagList &
+PacketTagList::operator = (PacketTagList const &o)
+{
+  // self assignment
+  if (this == &o) 
+    {
+      return *this;
+    }
+  m_nInline = o.m_nInline;
+  CopyInline (o);
+  if (m_next != o.m_next)
+    {
+      RemoveList ();
+      m_next = o.m_next;
+      if (m_next != 0) 
+        {
+          m_next->count++;
+        }
+    }
+  return *this;
+}
+
+PacketTagList::~PacketTagList ()
+{
+  RemoveList ();
+}
+
+void
+PacketTagList::CopyInline (PacketTagList const &o)
+{
+  for (uint32_t i = 0; i < m_nInline; i++)
+    {
+      m_inlineTid[i] = o.m_inlineTid[i];
+    }
+  memcpy (m_inlineData, o.m_inlineData, m_nInline * PACKET_TAG_MAX_SIZE);
+}
+
+int32_t
+PacketTagList::FindInline (TypeId tid) const
+{
+  for (uint32_t i = 0; i < m_nInline; i++)
+    {
+      if (m_inlineTid[i] == tid)
+        {
+          return i;
+        }
+    }
+  return -1;
+}
+
+void
+PacketTagList::RemoveAll (void)
+{
+  m_nInline = 0;
+  RemoveList ();
+}
+
+void
+PacketTagList::RemoveList (void)
+{
+  struct TagData *prev = 0;
+  for (struct TagData *cur = m_next; cur != 0; cur = cur->next) 
+    {
+      cur->count--;
+      if (cur->count > 0) 
+        {
+          break;
+        }
+      if (prev != 0) 
+        {
+          FreeData (prev);
+        }
+      prev = cur;
+    }
+  if (prev != 0) 
+    {
+      FreeData (prev);
+    }
+  m_next = 0;
+}
+
+} // namespace ns3
+
+#endif /* PACKET_TAG_LIST_H */
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "event-id.h"
+#include <stdint.h>
+#include <map>
+
+namespace ns3 {
+
+class Timer;
+
+/**
+ * \ingroup simulator
+ * \brief a hierarchical timing wheel which holds the timers until they are due
+ *
+ * The Timer objects which use the wheel (see the "TimerWheel" global
+ * value) do not schedule a simulator event when they are started:
+ * they are put in a slot of the wheel, which takes constant time,
+ * and removed from it just as quickly if they are cancelled or
+ * restarted. The wheel schedules a single simulator event for the
+ * earliest slot which holds a timer and, when this slot comes due,
+ * schedules a simulator event at the exact expiration time of each
+ * of its timers. The timers of a slot which expire in another context
+ * than that of the wheel are first handed over to their context, so that
+ * their event is scheduled, and can be cancelled, from there. A timer
+ * which is restarted many times before it
+ * expires, like a retransmission timer, thus costs a simulator event
+ * only when it does expire.
+ *
+ * The wheel has 4 levels of 256 slots. A slot of the first level
+ * spans "TimerWheelGranularity" and a slot of each other level spans
+ * a full turn of the level below. The timers which are due further
+ * than the last level can hold, or in the current slot, are scheduled
+ * in the simulator directly.
+ *
+ * There is one wheel per simulation: it is not safe to use it from
+ * the multithreaded simulator.
+ */
+class TimerWheel
+{
+public:
+  /**
+   * The part of a Timer which is linked in a slot of the wheel.
+   */
+  struct Entry
+  {
+    Entry ();
+    Entry (const Entry &o);
+    Entry &operator = (const Entry &o);
+    // the expiration time, in time steps.
+    uint64_t ts;
+    // the context in which the timer expires.
+    uint32_t context;
+    Timer *timer;
+    // linkage in the slot: pprev points to the head of the slot or to the
+    // next field of the previous entry, and is zero if the entry is not
+    // in the wheel.
+    Entry *next;
+    Entry **pprev;
+    uint32_t slot;
+    TimerWheel *wheel;
+  };
+
+  TimerWheel ();
+  ~TimerWheel ();
+
+  /**
+   * \param entry an entry which is not in the wheel yet, with its
+   *        expiration time, context and timer set.
+   *
+   * The wheel calls Timer::Post on the timer of the entry, in the
+   * context of the entry and after it has removed the entry from the
+   * wheel, when the slot of the entry comes due. Timer::Post is called
+   * right away if the entry is due too soon or too late to be held in
+   * the wheel.
+   */
+  void Insert (Entry *entry);
+  /**
+   * \param entry an entry which is in the wheel.
+   */
+  static void Remove (Entry *entry);
+  /**
+   * \param entry an entry
+   * \returns true if the entry is in a wheel.
+   */
+  static bool IsLinked (const Entry *entry);
+
+private:
+  enum {
+    LEVELS = 4,
+    SLOT_BITS = 8,
+    SLOTS = 1 << SLOT_BITS,
+    WORDS = SLOTS / 64,
+    // the slot of the entries which wait to be posted in their context.
+    PENDING = LEVELS * SLOTS
+  };
+  void Link (Entry *entry, uint32_t slot);
+  void Unlink (Entry *entry);
+  uint64_t GetSlotStart (uint32_t level, uint32_t index) const;
+  bool FindNext (uint64_t *tick) const;
+  void ScheduleWakeUp (void);
+  void WakeUp (void);
+  void Expire (uint32_t slot);
+  void PostPending (uint32_t context);
+
+  Entry *m_slots[LEVELS * SLOTS];
+  // one bit per non-empty slot.
+  uint64_t m_bitmap[LEVELS * WORDS];
+  uint32_t m_size;
+  // the tick relative to which the entries are placed in the wheel.
+  uint64_t m_current;
+  uint64_t m_granularity;
+  EventId m_wakeUp;
+  uint64_t m_wakeUpTick;
+  // the due entries of each other context than that of the wake-up event.
+  std::map<uint32_t, Entry *> m_pending;
+};
+
+} // namespace ns3
+
+#endif /* TIMER_WHEEL_H */
@@ -0,0 +1,16 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_TOPOLOGY_READ
+    
+
+// Module headers:
+#include "inet-topology-reader.h"
+#include "orbis-topology-reader.h"
+#include "rocketfuel-topology-reader.h"
+#include "topology-reader-helper.h"
+#include "topology-reader.h"
+#include "topology.h"
+#endif
@@ -0,0 +1,50 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Leonard Tracy <lentracy@gmail.com>
+ */
+
+#ifndef UANPROPMODELIDEAL_H_
+#define UANPROPMODELIDEAL_H_
+
+#include "uan-prop-model.h"
+#include "ns3/mobility-model.h"
+#include "ns3/nstime.h"
+namespace ns3 {
+
+/**
+ * \class UanPropModelIdeal
+ *
+ * \brief Ideal propagation model (no pathloss, impulse PDP)
+ */
+class UanPropModelIdeal : public UanPropModel
+{
+public:
+  UanPropModelIdeal ();
+  virtual ~UanPropModelIdeal ();
+
+  static TypeId GetTypeId (void);
+
+  // Inherited methods
+  virtual double GetPathLossDb (Ptr<MobilityModel> a, Ptr<MobilityModel> b, UanTxMode mode);
+  virtual UanPdp GetPdp (Ptr<MobilityModel> a, Ptr<MobilityModel> b, UanTxMode mode);
+  virtual Time GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b, UanTxMode mode);
+};
+
+}
+
+#endif /*UANPROPMODELIDEAL_H_*/
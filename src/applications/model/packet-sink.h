@@ -21,6 +21,7 @@
 #ifndef __packet_sink_h__
 #define __packet_sink_h__
 
+#include <list>
 #include "ns3/application.h"
 #include "ns3/event-id.h"
 #include "ns3/ptr.h"
@@ -518,6 +518,16 @@ def register_Ns3CallbackBase_methods(root_module, cls):
     ## callback.h (module 'core'): ns3::CallbackBase::CallbackBase(ns3::Ptr<ns3::CallbackImplBase> impl) [constructor]
     cls.add_constructor([param('ns3::Ptr< ns3::CallbackImplBase >', 'impl')], 
                         visibility='protected')
+    ## callback.h (module 'core'): void ns3::CallbackBase::DoRelease() [member function]
+    cls.add_method('DoRelease', 
+                   'void', 
+                   [], 
+                   visibility='protected')
+    ## callback.h (module 'core'): static ns3::CallbackImplBase * ns3::CallbackBase::PeekImpl(ns3::CallbackBase const & callback) [member function]
+    cls.add_method('PeekImpl', 
+                   'ns3::CallbackImplBase *', 
+                   [param('ns3::CallbackBase const &', 'callback')], 
+                   is_static=True, visibility='protected')
     ## callback.h (module 'core'): static std::string ns3::CallbackBase::Demangle(std::string const & mangled) [member function]
     cls.add_method('Demangle', 
                    'std::string', 
@@ -3064,10 +3074,15 @@ def register_Ns3CallbackImplBase_methods(root_module, cls):
     cls.add_constructor([])
     ## callback.h (module 'core'): ns3::CallbackImplBase::CallbackImplBase(ns3::CallbackImplBase const & arg0) [copy constructor]
     cls.add_constructor([param('ns3::CallbackImplBase const &', 'arg0')])
-    ## callback.h (module 'core'): bool ns3::CallbackImplBase::IsEqual(ns3::Ptr<ns3::CallbackImplBase const> other) const [member function]
+    ## callback.h (module 'core'): ns3::CallbackImplBase * ns3::CallbackImplBase::Copy(void * buffer) const [member function]
+    cls.add_method('Copy', 
+                   'ns3::CallbackImplBase *', 
+                   [param('void *', 'buffer')], 
+                   is_pure_virtual=True, is_const=True, is_virtual=True)
+    ## callback.h (module 'core'): bool ns3::CallbackImplBase::IsEqual(ns3::CallbackImplBase const * other) const [member function]
     cls.add_method('IsEqual', 
                    'bool', 
-                   [param('ns3::Ptr< ns3::CallbackImplBase const >', 'other')], 
+                   [param('ns3::CallbackImplBase const *', 'other')], 
                    is_pure_virtual=True, is_const=True, is_virtual=True)
     return
 
@@ -0,0 +1,55 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef BATCH_EVENT_H
+#define BATCH_EVENT_H
+
+#include "nstime.h"
+#include <stdint.h>
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ * \brief an event to schedule with Simulator::ScheduleBatch or
+ *        Simulator::ScheduleWithContextBatch
+ *
+ * As with Simulator::ScheduleWithContext, the reference to the event
+ * returned by MakeEvent is transferred to the simulator when the
+ * batch is scheduled. Also known as Simulator::BatchEvent.
+ */
+struct BatchEvent
+{
+  /**
+   * \param delay delay until the event expires
+   * \param event the event to schedule, in the current context
+   */
+  BatchEvent (Time const &delay, EventImpl *event);
+  /**
+   * \param context the context of the event
+   * \param delay delay until the event expires
+   * \param event the event to schedule
+   */
+  BatchEvent (uint32_t context, Time const &delay, EventImpl *event);
+  uint32_t context;
+  Time delay;
+  EventImpl *event;
+};
+
+} // namespace ns3
+
+#endif /* BATCH_EVENT_H */
@@ -24,7 +24,7 @@ std::string
 CallbackValue::SerializeToString (Ptr<const AttributeChecker> checker) const
 {
   std::ostringstream oss;
-  oss << PeekPointer (m_value.GetImpl ());
+  oss << m_value.m_impl;
   return oss.str ();
 }
 bool 
@@ -29,6 +29,7 @@
 #include "attribute-helper.h"
 #include "simple-ref-count.h"
 #include <typeinfo>
+#include <new>
 
 namespace ns3 {
 
@@ -53,6 +54,9 @@ namespace ns3 {
  *     member functions.
  *   - a reference list implementation to implement the Callback's
  *     value semantics.
+ *   - a small buffer in each Callback, in which the pimpl is stored
+ *     without a heap allocation when it fits, as it does for
+ *     functions, member functions and a single bound argument.
  *
  * This code most notably departs from the alexandrescu 
  * implementation in that it does not use type lists to specify
@@ -77,9 +81,25 @@ class CallbackImplBase : public SimpleRefCount<CallbackImplBase>
 {
 public:
   virtual ~CallbackImplBase () {}
-  virtual bool IsEqual (Ptr<const CallbackImplBase> other) const = 0;
+  virtual bool IsEqual (CallbackImplBase const *other) const = 0;
+  /**
+   * \param buffer the memory in which to build the copy, or zero to
+   *        allocate it on the heap.
+   * \returns a copy of this implementation.
+   */
+  virtual CallbackImplBase *Copy (void *buffer) const = 0;
 };
 
+template <typename T>
+CallbackImplBase *CallbackImplCopy (T const &impl, void *buffer)
+{
+  if (buffer == 0)
+    {
+      return new T (impl);
+    }
+  return new (buffer) T (impl);
+}
+
 // declare the CallbackImpl class
 template <typename R, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9>
 class CallbackImpl;
@@ -192,14 +212,19 @@ public:
   R operator() (T1 a1,T2 a2,T3 a3,T4 a4,T5 a5,T6 a6,T7 a7,T8 a8,T9 a9) {
     return m_functor (a1,a2,a3,a4,a5,a6,a7,a8,a9);
   }
-  virtual bool IsEqual (Ptr<const CallbackImplBase> other) const {
-    FunctorCallbackImpl<T,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> const *otherDerived = 
-      dynamic_cast<FunctorCallbackImpl<T,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> const *> (PeekPointer(other));
-    if (otherDerived == 0)
+  virtual CallbackImplBase *Copy (void *buffer) const {
+    return CallbackImplCopy (*this, buffer);
+  }
+  virtual bool IsEqual (CallbackImplBase const *other) const {
+    // impls are leaf classes: an exact type match is cheaper than
+    // a dynamic_cast
+    if (other == 0 || typeid (*other) != typeid (*this))
       {
         return false;
       }
-    else if (otherDerived->m_functor != m_functor)
+    FunctorCallbackImpl<T,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> const *otherDerived = 
+      static_cast<FunctorCallbackImpl<T,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> const *> (other);
+    if (otherDerived->m_functor != m_functor)
       {
         return false;
       }
@@ -246,14 +271,17 @@ public:
   R operator() (T1 a1,T2 a2,T3 a3,T4 a4,T5 a5,T6 a6,T7 a7,T8 a8, T9 a9) {
     return ((CallbackTraits<OBJ_PTR>::GetReference (m_objPtr)).*m_memPtr) (a1, a2, a3, a4, a5, a6, a7, a8, a9);
   }
-  virtual bool IsEqual (Ptr<const CallbackImplBase> other) const {
-    MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> const *otherDerived = 
-      dynamic_cast<MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> const *> (PeekPointer (other));
-    if (otherDerived == 0)
+  virtual CallbackImplBase *Copy (void *buffer) const {
+    return CallbackImplCopy (*this, buffer);
+  }
+  virtual bool IsEqual (CallbackImplBase const *other) const {
+    if (other == 0 || typeid (*other) != typeid (*this))
       {
         return false;
       }
-    else if (otherDerived->m_objPtr != m_objPtr ||
+    MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> const *otherDerived = 
+      static_cast<MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> const *> (other);
+    if (otherDerived->m_objPtr != m_objPtr ||
              otherDerived->m_memPtr != m_memPtr)
       {
         return false;
@@ -300,14 +328,17 @@ public:
   R operator() (T1 a1,T2 a2,T3 a3,T4 a4,T5 a5,T6 a6,T7 a7,T8 a8) {
     return m_functor (m_a,a1,a2,a3,a4,a5,a6,a7,a8);
   }
-  virtual bool IsEqual (Ptr<const CallbackImplBase> other) const {
-    BoundFunctorCallbackImpl<T,R,TX,T1,T2,T3,T4,T5,T6,T7,T8> const *otherDerived = 
-      dynamic_cast<BoundFunctorCallbackImpl<T,R,TX,T1,T2,T3,T4,T5,T6,T7,T8> const *> (PeekPointer (other));
-    if (otherDerived == 0)
+  virtual CallbackImplBase *Copy (void *buffer) const {
+    return CallbackImplCopy (*this, buffer);
+  }
+  virtual bool IsEqual (CallbackImplBase const *other) const {
+    if (other == 0 || typeid (*other) != typeid (*this))
       {
         return false;
       }
-    else if (otherDerived->m_functor != m_functor ||
+    BoundFunctorCallbackImpl<T,R,TX,T1,T2,T3,T4,T5,T6,T7,T8> const *otherDerived = 
+      static_cast<BoundFunctorCallbackImpl<T,R,TX,T1,T2,T3,T4,T5,T6,T7,T8> const *> (other);
+    if (otherDerived->m_functor != m_functor ||
              otherDerived->m_a != m_a)
       {
         return false;
@@ -320,15 +351,136 @@ private:
 };
 
 
+/**
+ * \internal
+ * Selects the Callback constructor which binds the first argument,
+ * of type TX, of a function.
+ */
+template <typename TX>
+struct CallbackBoundArgument {};
+
+// build a callback implementation in the buffer of a callback, or on
+// the heap, as selected at compile time so that no placement new is
+// instantiated for an implementation larger than the buffer.
+template <bool INLINE>
+struct CallbackStorage;
+
+template <>
+struct CallbackStorage<true>
+{
+  template <typename IMPL, typename A1>
+  static CallbackImplBase *Create (void *buffer, A1 const &a1) {
+    return new (buffer) IMPL (a1);
+  }
+  template <typename IMPL, typename A1, typename A2>
+  static CallbackImplBase *Create (void *buffer, A1 const &a1, A2 const &a2) {
+    return new (buffer) IMPL (a1, a2);
+  }
+};
+
+template <>
+struct CallbackStorage<false>
+{
+  template <typename IMPL, typename A1>
+  static CallbackImplBase *Create (void *buffer, A1 const &a1) {
+    return new IMPL (a1);
+  }
+  template <typename IMPL, typename A1, typename A2>
+  static CallbackImplBase *Create (void *buffer, A1 const &a1, A2 const &a2) {
+    return new IMPL (a1, a2);
+  }
+};
+
 class CallbackBase {
 public:
-  CallbackBase () : m_impl () {}
-  Ptr<CallbackImplBase> GetImpl (void) const {return m_impl;}
+  CallbackBase () : m_impl (0) {}
+  CallbackBase (const CallbackBase &o) : m_impl (0) { DoCopy (o); }
+  CallbackBase &operator = (const CallbackBase &o) {
+    if (&o != this)
+      {
+        DoRelease ();
+        DoCopy (o);
+      }
+    return *this;
+  }
+  ~CallbackBase () { DoRelease (); }
+  /**
+   * \returns the implementation of this callback. When it is stored
+   * within this callback, this is a copy of it.
+   */
+  Ptr<CallbackImplBase> GetImpl (void) const {
+    if (IsStoredInline ())
+      {
+        return Ptr<CallbackImplBase> (m_impl->Copy (0), false);
+      }
+    return Ptr<CallbackImplBase> (m_impl);
+  }
 protected:
-  CallbackBase (Ptr<CallbackImplBase> impl) : m_impl (impl) {}
-  Ptr<CallbackImplBase> m_impl;
+  CallbackBase (Ptr<CallbackImplBase> impl) : m_impl (PeekPointer (impl)) {
+    if (m_impl != 0)
+      {
+        m_impl->Ref ();
+      }
+  }
+  /**
+   * Build the implementation of type IMPL with the given arguments,
+   * within this callback if it fits, on the heap otherwise.
+   */
+  template <typename IMPL, typename A1>
+  void DoCreate (A1 const &a1) {
+    m_impl = CallbackStorage<sizeof (IMPL) <= sizeof (Buffer)>::template Create<IMPL> (&m_buffer, a1);
+  }
+  template <typename IMPL, typename A1, typename A2>
+  void DoCreate (A1 const &a1, A2 const &a2) {
+    m_impl = CallbackStorage<sizeof (IMPL) <= sizeof (Buffer)>::template Create<IMPL> (&m_buffer, a1, a2);
+  }
+  void DoRelease (void) {
+    if (IsStoredInline ())
+      {
+        m_impl->~CallbackImplBase ();
+      }
+    else if (m_impl != 0)
+      {
+        m_impl->Unref ();
+      }
+    m_impl = 0;
+  }
+  static CallbackImplBase *PeekImpl (const CallbackBase &callback) {
+    return callback.m_impl;
+  }
+
+  CallbackImplBase *m_impl;
 
   static std::string Demangle(const std::string& mangled);
+private:
+  friend class CallbackValue;
+  bool IsStoredInline (void) const {
+    return m_impl == reinterpret_cast<const CallbackImplBase *> (&m_buffer);
+  }
+  void DoCopy (const CallbackBase &o) {
+    if (o.IsStoredInline ())
+      {
+        m_impl = o.m_impl->Copy (&m_buffer);
+      }
+    else
+      {
+        m_impl = o.m_impl;
+        if (m_impl != 0)
+          {
+            m_impl->Ref ();
+          }
+      }
+  }
+
+  // large enough for a member function pointer and its object, or
+  // a function pointer and one bound argument.
+  union Buffer {
+    char bytes[48];
+    void *pointer;
+    double real;
+    uint64_t integer;
+  };
+  Buffer m_buffer;
 };
 
 /**
@@ -374,13 +526,21 @@ public:
   // always properly disambiguated by the c++ compiler
   template <typename FUNCTOR>
   Callback (FUNCTOR const &functor, bool, bool) 
-    : CallbackBase (Create<FunctorCallbackImpl<FUNCTOR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> > (functor))
-  {}
+  {
+    DoCreate<FunctorCallbackImpl<FUNCTOR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> > (functor);
+  }
 
   template <typename OBJ_PTR, typename MEM_PTR>
   Callback (OBJ_PTR const &objPtr, MEM_PTR mem_ptr)
-    : CallbackBase (Create<MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> > (objPtr, mem_ptr))
-  {}
+  {
+    DoCreate<MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> > (objPtr, mem_ptr);
+  }
+
+  template <typename TX, typename FUNCTOR, typename ARG>
+  Callback (FUNCTOR const &functor, ARG const &a, CallbackBoundArgument<TX>)
+  {
+    DoCreate<BoundFunctorCallbackImpl<FUNCTOR,R,TX,T1,T2,T3,T4,T5,T6,T7,T8> > (functor, a);
+  }
 
   Callback (Ptr<CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9> > const &impl)
     : CallbackBase (impl)
@@ -388,19 +548,14 @@ public:
 
   template <typename T>
   Callback<R,T2,T3,T4,T5,T6,T7,T8,T9> Bind (T a) {
-    Ptr<CallbackImpl<R,T2,T3,T4,T5,T6,T7,T8,T9,empty> > impl =
-      Ptr<CallbackImpl<R,T2,T3,T4,T5,T6,T7,T8,T9,empty> > (
-                                                  new BoundFunctorCallbackImpl<
-                                                  Callback<R,T1,T2,T3,T4,T5,T6,T7,T8,T9>,
-                                                  R,T1,T2,T3,T4,T5,T6,T7,T8,T9> (*this, a), false);
-    return Callback<R,T2,T3,T4,T5,T6,T7,T8,T9> (impl);
+    return Callback<R,T2,T3,T4,T5,T6,T7,T8,T9> (*this, a, CallbackBoundArgument<T1> ());
   }
 
   bool IsNull (void) const {
     return (DoPeekImpl () == 0)?true:false;
   }
   void Nullify (void) {
-    m_impl = 0;
+    DoRelease ();
   }
 
   R operator() (void) const {
@@ -435,21 +590,21 @@ public:
   }
 
   bool IsEqual (const CallbackBase &other) const {
-    return m_impl->IsEqual (other.GetImpl ());
+    return m_impl->IsEqual (PeekImpl (other));
   }
 
   bool CheckType (const CallbackBase & other) const {
-    return DoCheckType (other.GetImpl ());
+    return DoCheckType (PeekImpl (other));
   }
   void Assign (const CallbackBase &other) {
-    DoAssign (other.GetImpl ());
+    DoAssign (other);
   }
 private:
   CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9> *DoPeekImpl (void) const {
-    return static_cast<CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9> *> (PeekPointer (m_impl));
+    return static_cast<CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9> *> (m_impl);
   }
-  bool DoCheckType (Ptr<const CallbackImplBase> other) const {
-    if (other != 0 && dynamic_cast<const CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9> *> (PeekPointer (other)) != 0)
+  bool DoCheckType (CallbackImplBase const *other) const {
+    if (other != 0 && dynamic_cast<const CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9> *> (other) != 0)
       {
         return true;
       }
@@ -462,14 +617,14 @@ private:
         return false;
       }
   }
-  void DoAssign (Ptr<const CallbackImplBase> other) {
-    if (!DoCheckType (other))
+  void DoAssign (const CallbackBase &other) {
+    if (!DoCheckType (PeekImpl (other)))
       {
         NS_FATAL_ERROR ("Incompatible types. (feed to \"c++filt -t\" if needed)" << std::endl <<
-                        "got=" << Demangle ( typeid (*other).name () ) << std::endl <<
+                        "got=" << Demangle ( typeid (*PeekImpl (other)).name () ) << std::endl <<
                         "expected=" << Demangle ( typeid (CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9> *).name () ));
       }
-    m_impl = const_cast<CallbackImplBase *> (PeekPointer (other));
+    CallbackBase::operator = (other);
   }
 };
 
@@ -893,66 +1048,48 @@ Callback<R,T1,T2,T3,T4,T5,T6,T7,T8,T9> MakeNullCallback (void) {
 
 template <typename R, typename TX, typename ARG>
 Callback<R> MakeBoundCallback (R (*fnPtr) (TX), ARG a) {
-  Ptr<CallbackImpl<R,empty,empty,empty,empty,empty,empty,empty,empty,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*) (TX),R,TX,empty,empty,empty,empty,empty,empty,empty,empty> >(fnPtr, a);
-  return Callback<R> (impl);
+  return Callback<R> (fnPtr, a, CallbackBoundArgument<TX> ());
 }
 
 template <typename R, typename TX, typename ARG, 
           typename T1>
 Callback<R,T1> MakeBoundCallback (R (*fnPtr) (TX,T1), ARG a) {
-  Ptr<CallbackImpl<R,T1,empty,empty,empty,empty,empty,empty,empty,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*) (TX,T1),R,TX,T1,empty,empty,empty,empty,empty,empty,empty> > (fnPtr, a);
-  return Callback<R,T1> (impl);
+  return Callback<R,T1> (fnPtr, a, CallbackBoundArgument<TX> ());
 }
 template <typename R, typename TX, typename ARG, 
           typename T1, typename T2>
 Callback<R,T1,T2> MakeBoundCallback (R (*fnPtr) (TX,T1,T2), ARG a) {
-  Ptr<CallbackImpl<R,T1,T2,empty,empty,empty,empty,empty,empty,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*) (TX,T1,T2),R,TX,T1,T2,empty,empty,empty,empty,empty,empty> > (fnPtr, a);
-  return Callback<R,T1,T2> (impl);
+  return Callback<R,T1,T2> (fnPtr, a, CallbackBoundArgument<TX> ());
 }
 template <typename R, typename TX, typename ARG,
           typename T1, typename T2,typename T3>
 Callback<R,T1,T2,T3> MakeBoundCallback (R (*fnPtr) (TX,T1,T2,T3), ARG a) {
-  Ptr<CallbackImpl<R,T1,T2,T3,empty,empty,empty,empty,empty,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*) (TX,T1,T2,T3),R,TX,T1,T2,T3,empty,empty,empty,empty,empty> > (fnPtr, a);
-  return Callback<R,T1,T2,T3> (impl);
+  return Callback<R,T1,T2,T3> (fnPtr, a, CallbackBoundArgument<TX> ());
 }
 template <typename R, typename TX, typename ARG,
           typename T1, typename T2,typename T3,typename T4>
 Callback<R,T1,T2,T3,T4> MakeBoundCallback (R (*fnPtr) (TX,T1,T2,T3,T4), ARG a) {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,empty,empty,empty,empty,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*) (TX,T1,T2,T3,T4),R,TX,T1,T2,T3,T4,empty,empty,empty,empty> > (fnPtr, a);
-  return Callback<R,T1,T2,T3,T4> (impl);
+  return Callback<R,T1,T2,T3,T4> (fnPtr, a, CallbackBoundArgument<TX> ());
 }
 template <typename R, typename TX, typename ARG,
           typename T1, typename T2,typename T3,typename T4,typename T5>
 Callback<R,T1,T2,T3,T4,T5> MakeBoundCallback (R (*fnPtr) (TX,T1,T2,T3,T4,T5), ARG a) {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,T5,empty,empty,empty,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*) (TX,T1,T2,T3,T4,T5),R,TX,T1,T2,T3,T4,T5,empty,empty,empty> > (fnPtr, a);
-  return Callback<R,T1,T2,T3,T4,T5> (impl);
+  return Callback<R,T1,T2,T3,T4,T5> (fnPtr, a, CallbackBoundArgument<TX> ());
 }
 template <typename R, typename TX, typename ARG,
           typename T1, typename T2,typename T3,typename T4,typename T5, typename T6>
 Callback<R,T1,T2,T3,T4,T5,T6> MakeBoundCallback (R (*fnPtr) (TX,T1,T2,T3,T4,T5,T6), ARG a) {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,T5,T6,empty,empty,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*) (TX,T1,T2,T3,T4,T5,T6),R,TX,T1,T2,T3,T4,T5,T6,empty,empty> > (fnPtr, a);
-  return Callback<R,T1,T2,T3,T4,T5,T6> (impl);
+  return Callback<R,T1,T2,T3,T4,T5,T6> (fnPtr, a, CallbackBoundArgument<TX> ());
 }
 template <typename R, typename TX, typename ARG,
           typename T1, typename T2,typename T3,typename T4,typename T5, typename T6, typename T7>
 Callback<R,T1,T2,T3,T4,T5,T6,T7> MakeBoundCallback (R (*fnPtr) (TX,T1,T2,T3,T4,T5,T6,T7), ARG a) {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,empty,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*) (TX,T1,T2,T3,T4,T5,T6,T7),R,TX,T1,T2,T3,T4,T5,T6,T7,empty> > (fnPtr, a);
-  return Callback<R,T1,T2,T3,T4,T5,T6,T7> (impl);
+  return Callback<R,T1,T2,T3,T4,T5,T6,T7> (fnPtr, a, CallbackBoundArgument<TX> ());
 }
 template <typename R, typename TX, typename ARG,
           typename T1, typename T2,typename T3,typename T4,typename T5, typename T6, typename T7, typename T8>
 Callback<R,T1,T2,T3,T4,T5,T6,T7,T8> MakeBoundCallback (R (*fnPtr) (TX,T1,T2,T3,T4,T5,T6,T7,T8), ARG a) {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*) (TX,T1,T2,T3,T4,T5,T6,T7,T8),R,TX,T1,T2,T3,T4,T5,T6,T7,T8> > (fnPtr, a);
-  return Callback<R,T1,T2,T3,T4,T5,T6,T7,T8> (impl);
+  return Callback<R,T1,T2,T3,T4,T5,T6,T7,T8> (fnPtr, a, CallbackBoundArgument<TX> ());
 }
 } // namespace ns3
 
@@ -33,6 +33,7 @@
 #include "callback.h"
 
 #include <sstream>
+#include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE ("Config");
 
@@ -136,77 +137,100 @@ class ArrayMatcher
 {
 public:
   ArrayMatcher (std::string element);
-  bool Matches (uint32_t i) const;
+  /**
+   * \param i an index
+   * \param n the number of items in the array
+   * \returns the first index at least equal to i which matches, or
+   *          n if none below n matches.
+   */
+  uint32_t Next (uint32_t i, uint32_t n) const;
 private:
+  void Parse (std::string element);
   bool StringToUint32 (std::string str, uint32_t *value) const;
   std::string m_element;
+  bool m_all;
+  // the sorted and disjoint [first, second] ranges matched by m_element
+  std::vector<std::pair<uint32_t, uint32_t> > m_ranges;
 };
 
 
 ArrayMatcher::ArrayMatcher (std::string element)
-  : m_element (element)
-{}
-bool 
-ArrayMatcher::Matches (uint32_t i) const
+  : m_element (element),
+    m_all (false)
 {
-  if (m_element == "*")
+  Parse (element);
+  std::sort (m_ranges.begin (), m_ranges.end ());
+  std::vector<std::pair<uint32_t, uint32_t> > merged;
+  for (uint32_t i = 0; i < m_ranges.size (); i++)
     {
-      NS_LOG_DEBUG ("Array "<<i<<" matches *");
-      return true;
+      if (!merged.empty () && m_ranges[i].first <= merged.back ().second + 1ULL)
+        {
+          merged.back ().second = std::max (merged.back ().second, m_ranges[i].second);
+        }
+      else
+        {
+          merged.push_back (m_ranges[i]);
+        }
+    }
+  m_ranges = merged;
+}
+void
+ArrayMatcher::Parse (std::string element)
+{
+  if (element == "*")
+    {
+      m_all = true;
+      return;
     }
   std::string::size_type tmp;
-  tmp = m_element.find ("|");
+  tmp = element.find ("|");
   if (tmp != std::string::npos)
     {
-      std::string left = m_element.substr (0, tmp-0);
-      std::string right = m_element.substr (tmp+1, m_element.size () - (tmp + 1));
-      ArrayMatcher matcher = ArrayMatcher (left);
-      if (matcher.Matches (i))
-	{
-	  NS_LOG_DEBUG ("Array "<<i<<" matches "<<left);
-	  return true;
-	}
-      matcher = ArrayMatcher (right);
-      if (matcher.Matches (i))
-	{
-	  NS_LOG_DEBUG ("Array "<<i<<" matches "<<right);
-	  return true;
-	}
-      NS_LOG_DEBUG ("Array "<<i<<" does not match "<<m_element);
-      return false;
+      std::string left = element.substr (0, tmp-0);
+      std::string right = element.substr (tmp+1, element.size () - (tmp + 1));
+      Parse (left);
+      Parse (right);
+      return;
     }
-  std::string::size_type leftBracket = m_element.find ("[");
-  std::string::size_type rightBracket = m_element.find ("]");
-  std::string::size_type dash = m_element.find ("-");
-  if (leftBracket == 0 && rightBracket == m_element.size () - 1 &&
+  std::string::size_type leftBracket = element.find ("[");
+  std::string::size_type rightBracket = element.find ("]");
+  std::string::size_type dash = element.find ("-");
+  if (leftBracket == 0 && rightBracket == element.size () - 1 &&
       dash > leftBracket && dash < rightBracket)
     {
-      std::string lowerBound = m_element.substr (leftBracket + 1, dash - (leftBracket + 1));
-      std::string upperBound = m_element.substr (dash + 1, rightBracket - (dash + 1));
+      std::string lowerBound = element.substr (leftBracket + 1, dash - (leftBracket + 1));
+      std::string upperBound = element.substr (dash + 1, rightBracket - (dash + 1));
       uint32_t min;
       uint32_t max;
       if (StringToUint32 (lowerBound, &min) && 
 	  StringToUint32 (upperBound, &max) &&
-	  i >= min && i <= max)
+	  min <= max)
         {
-	  NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
-          return true;
+          m_ranges.push_back (std::make_pair (min, max));
         }
-      else
-	{
-	  NS_LOG_DEBUG ("Array "<<i<<" does not "<<m_element);
-	  return false;
-	}
+      return;
     }
   uint32_t value;
-  if (StringToUint32 (m_element, &value) &&
-      i == value)
+  if (StringToUint32 (element, &value))
     {
-      NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
-      return true;
+      m_ranges.push_back (std::make_pair (value, value));
     }
-  NS_LOG_DEBUG ("Array "<<i<<" does not match "<<m_element);
-  return false;
+}
+uint32_t
+ArrayMatcher::Next (uint32_t i, uint32_t n) const
+{
+  if (m_all)
+    {
+      return std::min (i, n);
+    }
+  for (uint32_t j = 0; j < m_ranges.size (); j++)
+    {
+      if (m_ranges[j].second >= i)
+        {
+          return std::min (std::max (i, m_ranges[j].first), n);
+        }
+    }
+  return n;
 }
 
 bool
@@ -222,50 +246,55 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
 class Resolver
 {
 public:
-  Resolver (std::string path);
+  Resolver (const std::vector<std::string> &items);
   virtual ~Resolver ();
 
   void Resolve (Ptr<Object> root);
 private:
-  void Canonicalize (void);
-  void DoResolve (std::string path, Ptr<Object> root);
-  void DoArrayResolve (std::string path, const ObjectVectorValue &vector);
+  struct Segment
+  {
+    Segment (std::string item);
+    std::string item;
+    ArrayMatcher matcher;
+    // The result of the last lookup of the item by DoResolve: the
+    // objects along the path have the same types most of the time.
+    bool cached;
+    TypeId tid;
+    bool found;
+    struct TypeId::AttributeInfo info;
+    const ObjectVectorAccessor *vectorAccessor;
+  };
+  void DoResolve (uint32_t index, Ptr<Object> root);
+  void DoArrayResolve (uint32_t index, Ptr<Object> root, const struct Segment &vector);
   void DoResolveOne (Ptr<Object> object);
   std::string GetResolvedPath (void) const;
   virtual void DoOne (Ptr<Object> object, std::string path) = 0;
+  std::vector<struct Segment> m_segments;
   std::vector<std::string> m_workStack;
-  std::string m_path;
 };
 
-Resolver::Resolver (std::string path)
-  : m_path (path)
-{
-  Canonicalize ();
-}
-Resolver::~Resolver ()
+Resolver::Segment::Segment (std::string item)
+  : item (item),
+    matcher (item),
+    cached (false),
+    found (false),
+    vectorAccessor (0)
 {}
-void
-Resolver::Canonicalize (void)
+
+Resolver::Resolver (const std::vector<std::string> &items)
 {
-  // ensure that we start and end with a '/'
-  std::string::size_type tmp = m_path.find ("/");
-  if (tmp != 0)
-    {
-      // no slash at start
-      m_path = "/" + m_path;
-    }
-  tmp = m_path.find_last_of ("/");
-  if (tmp != (m_path.size () - 1))
+  for (std::vector<std::string>::const_iterator i = items.begin (); i != items.end (); ++i)
     {
-      // no slash at end
-      m_path = m_path + "/";
+      m_segments.push_back (Segment (*i));
     }
 }
+Resolver::~Resolver ()
+{}
 
 void 
 Resolver::Resolve (Ptr<Object> root)
 {
-  DoResolve (m_path, root);
+  DoResolve (0, root);
 }
 
 std::string
@@ -287,15 +316,11 @@ Resolver::DoResolveOne (Ptr<Object> object)
 }
 
 void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
+Resolver::DoResolve (uint32_t index, Ptr<Object> root)
 {
-  NS_LOG_FUNCTION (path << root);
-  std::string::size_type tmp;
-  tmp = path.find ("/");
-  NS_ASSERT (tmp == 0);
-  std::string::size_type next = path.find ("/", 1);
+  NS_LOG_FUNCTION (index << root);
 
-  if (next == std::string::npos)
+  if (index == m_segments.size ())
     {
       //
       // If root is zero, we're beginning to see if we can use the object name 
@@ -311,8 +336,8 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
         }
       return;
     }
-  std::string item = path.substr (1, next-1);
-  std::string pathLeft = path.substr (next, path.size ()-next);
+  struct Segment &segment = m_segments[index];
+  const std::string &item = segment.item;
 
   //
   // If root is zero, we're beginning to see if we can use the object name 
@@ -323,11 +348,10 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   //
   if (root == 0)
     {
-      std::string::size_type offset = path.find ("/Names");
-      if (offset == 0)
+      if (item.compare (0, 5, "Names") == 0)
         {
           m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
+          DoResolve (index + 1, root);
           m_workStack.pop_back ();
           return;
         }
@@ -344,7 +368,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
       m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
+      DoResolve (index + 1, namedObject);
       m_workStack.pop_back ();
       return;
     }
@@ -364,31 +388,44 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   if (dollarPos == 0)
     {
       // This is a call to GetObject
-      std::string tidString = item.substr (1, item.size () - 1);
-      NS_LOG_DEBUG ("GetObject="<<tidString<<" on path="<<GetResolvedPath ());
-      TypeId tid = TypeId::LookupByName (tidString);
-      Ptr<Object> object = root->GetObject<Object> (tid);
+      if (!segment.cached)
+        {
+          segment.tid = TypeId::LookupByName (item.substr (1, item.size () - 1));
+          segment.cached = true;
+        }
+      NS_LOG_DEBUG ("GetObject="<<segment.tid.GetName ()<<" on path="<<GetResolvedPath ());
+      Ptr<Object> object = root->GetObject<Object> (segment.tid);
       if (object == 0)
 	{
-	  NS_LOG_DEBUG ("GetObject ("<<tidString<<") failed on path="<<GetResolvedPath ());
+	  NS_LOG_DEBUG ("GetObject ("<<segment.tid.GetName ()<<") failed on path="<<GetResolvedPath ());
 	  return;
 	}
       m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
+      DoResolve (index + 1, object);
       m_workStack.pop_back ();
     }
   else 
     {
       // this is a normal attribute.
       TypeId tid = root->GetInstanceTypeId ();
-      struct TypeId::AttributeInfo info;
-      if (!tid.LookupAttributeByName (item, &info))
+      if (!segment.cached || segment.tid != tid)
+        {
+          segment.found = tid.LookupAttributeByName (item, &segment.info);
+          segment.vectorAccessor = 0;
+          if (segment.found)
+            {
+              segment.vectorAccessor = dynamic_cast<const ObjectVectorAccessor *> (PeekPointer (segment.info.accessor));
+            }
+          segment.tid = tid;
+          segment.cached = true;
+        }
+      if (!segment.found)
 	{
 	  NS_LOG_DEBUG ("Requested item="<<item<<" does not exist on path="<<GetResolvedPath ());
 	  return;
 	}
       // attempt to cast to a pointer checker.
-      const PointerChecker *ptr = dynamic_cast<const PointerChecker *> (PeekPointer (info.checker));
+      const PointerChecker *ptr = dynamic_cast<const PointerChecker *> (PeekPointer (segment.info.checker));
       if (ptr != 0)
 	{
 	  NS_LOG_DEBUG ("GetAttribute(ptr)="<<item<<" on path="<<GetResolvedPath ());
@@ -403,18 +440,16 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
 	      return;
 	    }
 	  m_workStack.push_back (item);
-	  DoResolve (pathLeft, object);
+	  DoResolve (index + 1, object);
 	  m_workStack.pop_back ();
 	}
       // attempt to cast to an object vector.
-      const ObjectVectorChecker *vectorChecker = dynamic_cast<const ObjectVectorChecker *> (PeekPointer (info.checker));
+      const ObjectVectorChecker *vectorChecker = dynamic_cast<const ObjectVectorChecker *> (PeekPointer (segment.info.checker));
       if (vectorChecker != 0)
 	{
 	  NS_LOG_DEBUG ("GetAttribute(vector)="<<item<<" on path="<<GetResolvedPath ());
-	  ObjectVectorValue vector;
-          root->GetAttribute (item, vector);
 	  m_workStack.push_back (item);
-	  DoArrayResolve (pathLeft, vector);
+	  DoArrayResolve (index + 1, root, segment);
 	  m_workStack.pop_back ();
 	}
       // this could be anything else and we don't know what to do with it.
@@ -423,31 +458,42 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
 }
 
 void 
-Resolver::DoArrayResolve (std::string path, const ObjectVectorValue &vector)
+Resolver::DoArrayResolve (uint32_t index, Ptr<Object> root, const struct Segment &vector)
 {
-  NS_ASSERT (path != "");
-  std::string::size_type tmp;
-  tmp = path.find ("/");
-  NS_ASSERT (tmp == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
+  if (index == m_segments.size ())
     {
-      NS_FATAL_ERROR ("vector path includes no index data on path=\""<<path<<"\"");
+      NS_FATAL_ERROR ("vector path includes no index data on path=\""<<GetResolvedPath ()<<"\"");
     }
-  std::string item = path.substr (1, next-1);
-  std::string pathLeft = path.substr (next, path.size ()-next);
-
-  ArrayMatcher matcher = ArrayMatcher (item);
-  for (uint32_t i = 0; i < vector.GetN (); i++)
+  // The matcher enumerates the matching indexes, and the accessor reads
+  // the matching objects only, without a copy of the whole vector.
+  const ArrayMatcher &matcher = m_segments[index].matcher;
+  if (vector.vectorAccessor != 0)
     {
-      if (matcher.Matches (i))
-	{
-	  std::ostringstream oss;
-	  oss << i;
-	  m_workStack.push_back (oss.str ());
-	  DoResolve (pathLeft, vector.Get (i));
-	  m_workStack.pop_back ();
-	}
+      uint32_t n;
+      if (!vector.vectorAccessor->GetN (PeekPointer (root), &n))
+        {
+          return;
+        }
+      for (uint32_t i = matcher.Next (0, n); i < n; i = matcher.Next (i + 1, n))
+        {
+          std::ostringstream oss;
+          oss << i;
+          m_workStack.push_back (oss.str ());
+          DoResolve (index + 1, vector.vectorAccessor->Get (PeekPointer (root), i));
+          m_workStack.pop_back ();
+        }
+      return;
+    }
+  ObjectVectorValue objects;
+  root->GetAttribute (vector.item, objects);
+  uint32_t n = objects.GetN ();
+  for (uint32_t i = matcher.Next (0, n); i < n; i = matcher.Next (i + 1, n))
+    {
+      std::ostringstream oss;
+      oss << i;
+      m_workStack.push_back (oss.str ());
+      DoResolve (index + 1, objects.Get (i));
+      m_workStack.pop_back ();
     }
 }
 
@@ -455,12 +501,7 @@ Resolver::DoArrayResolve (std::string path, const ObjectVectorValue &vector)
 class ConfigImpl 
 {
 public:
-  void Set (std::string path, const AttributeValue &value);
-  void ConnectWithoutContext (std::string path, const CallbackBase &cb);
-  void Connect (std::string path, const CallbackBase &cb);
-  void DisconnectWithoutContext (std::string path, const CallbackBase &cb);
-  void Disconnect (std::string path, const CallbackBase &cb);
-  Config::MatchContainer LookupMatches (std::string path);
+  Config::MatchContainer LookupMatches (const std::vector<std::string> &items, std::string path);
 
   void RegisterRootNamespaceObject (Ptr<Object> obj);
   void UnregisterRootNamespaceObject (Ptr<Object> obj);
@@ -469,71 +510,19 @@ public:
   Ptr<Object> GetRootNamespaceObject (uint32_t i) const;
   
 private:
-  void ParsePath (std::string path, std::string *root, std::string *leaf) const;
   typedef std::vector<Ptr<Object> > Roots;
   Roots m_roots;
 };
 
-void 
-ConfigImpl::ParsePath (std::string path, std::string *root, std::string *leaf) const
-{
-  std::string::size_type slash = path.find_last_of ("/");
-  NS_ASSERT (slash != std::string::npos);
-  *root = path.substr (0, slash);
-  *leaf = path.substr (slash+1, path.size ()-(slash+1));
-  NS_LOG_FUNCTION (path << *root << *leaf);
-}
-
-void 
-ConfigImpl::Set (std::string path, const AttributeValue &value)
-{
-  std::string root, leaf;
-  ParsePath (path, &root, &leaf);
-  Config::MatchContainer container = LookupMatches (root);
-  container.Set (leaf, value);
-}
-void 
-ConfigImpl::ConnectWithoutContext (std::string path, const CallbackBase &cb)
-{
-  std::string root, leaf;
-  ParsePath (path, &root, &leaf);
-  Config::MatchContainer container = LookupMatches (root);
-  container.ConnectWithoutContext (leaf, cb);
-}
-void 
-ConfigImpl::DisconnectWithoutContext (std::string path, const CallbackBase &cb)
-{
-  std::string root, leaf;
-  ParsePath (path, &root, &leaf);
-  Config::MatchContainer container = LookupMatches (root);
-  container.DisconnectWithoutContext (leaf, cb);
-}
-void 
-ConfigImpl::Connect (std::string path, const CallbackBase &cb)
-{
-  std::string root, leaf;
-  ParsePath (path, &root, &leaf);
-  Config::MatchContainer container = LookupMatches (root);
-  container.Connect (leaf, cb);
-}
-void 
-ConfigImpl::Disconnect (std::string path, const CallbackBase &cb)
-{
-  std::string root, leaf;
-  ParsePath (path, &root, &leaf);
-  Config::MatchContainer container = LookupMatches (root);
-  container.Disconnect (leaf, cb);
-}
-
 Config::MatchContainer 
-ConfigImpl::LookupMatches (std::string path)
+ConfigImpl::LookupMatches (const std::vector<std::string> &items, std::string path)
 {
   NS_LOG_FUNCTION (path);
   class LookupMatchesResolver : public Resolver 
   {
   public:
-    LookupMatchesResolver (std::string path)
-      : Resolver (path)
+    LookupMatchesResolver (const std::vector<std::string> &items)
+      : Resolver (items)
     {}
     virtual void DoOne (Ptr<Object> object, std::string path) {
       m_objects.push_back (object);
@@ -541,7 +530,7 @@ ConfigImpl::LookupMatches (std::string path)
     }
     std::vector<Ptr<Object> > m_objects;
     std::vector<std::string> m_contexts;
-  } resolver = LookupMatchesResolver (path);
+  } resolver = LookupMatchesResolver (items);
   for (Roots::const_iterator i = m_roots.begin (); i != m_roots.end (); i++)
     {
       resolver.Resolve (*i);
@@ -589,9 +578,102 @@ ConfigImpl::GetRootNamespaceObject (uint32_t i) const
 
 namespace Config {
 
+static std::vector<std::string>
+SplitPath (std::string path)
+{
+  // ensure that we start and end with a '/'
+  if (path.find ("/") != 0)
+    {
+      path = "/" + path;
+    }
+  if (path.find_last_of ("/") != path.size () - 1)
+    {
+      path = path + "/";
+    }
+  std::vector<std::string> items;
+  std::string::size_type start = 1;
+  while (start < path.size ())
+    {
+      std::string::size_type next = path.find ("/", start);
+      items.push_back (path.substr (start, next - start));
+      start = next + 1;
+    }
+  return items;
+}
+
+Path::Path (std::string path)
+  : m_path (path)
+{
+  std::string::size_type slash = path.find_last_of ("/");
+  NS_ASSERT (slash != std::string::npos);
+  m_root = path.substr (0, slash);
+  m_leaf = path.substr (slash+1, path.size ()-(slash+1));
+  m_items = SplitPath (m_root);
+  NS_LOG_FUNCTION (path << m_root << m_leaf);
+}
+std::string
+Path::GetPath (void) const
+{
+  return m_path;
+}
+MatchContainer
+Path::LookupMatches (void) const
+{
+  return Singleton<ConfigImpl>::Get ()->LookupMatches (m_items, m_root);
+}
+void
+Path::Set (const AttributeValue &value) const
+{
+  LookupMatches ().Set (m_leaf, value);
+}
+void
+Path::Connect (const CallbackBase &cb) const
+{
+  LookupMatches ().Connect (m_leaf, cb);
+}
+void
+Path::ConnectWithoutContext (const CallbackBase &cb) const
+{
+  LookupMatches ().ConnectWithoutContext (m_leaf, cb);
+}
+void
+Path::Disconnect (const CallbackBase &cb) const
+{
+  LookupMatches ().Disconnect (m_leaf, cb);
+}
+void
+Path::DisconnectWithoutContext (const CallbackBase &cb) const
+{
+  LookupMatches ().DisconnectWithoutContext (m_leaf, cb);
+}
+
+void ConnectMany (const std::vector<std::string> &paths, 
+                  const std::vector<CallbackBase> &cbs)
+{
+  NS_ASSERT (paths.size () == cbs.size ());
+  uint32_t i = 0;
+  while (i < paths.size ())
+    {
+      Path path = Path (paths[i]);
+      MatchContainer container = path.LookupMatches ();
+      container.Connect (path.m_leaf, cbs[i]);
+      // the next paths with the same root reuse the same matches
+      for (i++; i < paths.size (); i++)
+        {
+          std::string::size_type slash = paths[i].find_last_of ("/");
+          NS_ASSERT (slash != std::string::npos);
+          if (paths[i].compare (0, slash, path.m_root) != 0 || slash != path.m_root.size ())
+            {
+              break;
+            }
+          container.Connect (paths[i].substr (slash + 1), cbs[i]);
+        }
+    }
+}
+
 void Set (std::string path, const AttributeValue &value)
 {
-  Singleton<ConfigImpl>::Get ()->Set (path, value);
+  Path (path).Set (value);
 }
 void SetDefault (std::string name, const AttributeValue &value)
 {
@@ -611,25 +693,25 @@ bool SetGlobalFailSafe (std::string name, const AttributeValue &value)
 }
 void ConnectWithoutContext (std::string path, const CallbackBase &cb)
 {
-  Singleton<ConfigImpl>::Get ()->ConnectWithoutContext (path, cb);
+  Path (path).ConnectWithoutContext (cb);
 }
 void DisconnectWithoutContext (std::string path, const CallbackBase &cb)
 {
-  Singleton<ConfigImpl>::Get ()->DisconnectWithoutContext (path, cb);
+  Path (path).DisconnectWithoutContext (cb);
 }
 void 
 Connect (std::string path, const CallbackBase &cb)
 {
-  Singleton<ConfigImpl>::Get ()->Connect (path, cb);
+  Path (path).Connect (cb);
 }
 void 
 Disconnect (std::string path, const CallbackBase &cb)
 {
-  Singleton<ConfigImpl>::Get ()->Disconnect (path, cb);
+  Path (path).Disconnect (cb);
 }
 Config::MatchContainer LookupMatches (std::string path)
 {
-  return Singleton<ConfigImpl>::Get ()->LookupMatches (path);
+  return Singleton<ConfigImpl>::Get ()->LookupMatches (SplitPath (path), path);
 }
 
 void RegisterRootNamespaceObject (Ptr<Object> obj)
@@ -1213,6 +1295,98 @@ ObjectVectorTraceConfigTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_path, "/NodeA/NodeB/NodesB/1/Source", "Trace 1 did not provide expected context");
 }
 
+// ===========================================================================
+// Test for the reuse of a Config::Path and for Config::ConnectMany
+// ===========================================================================
+class PathConfigTestCase : public TestCase
+{
+public:
+  PathConfigTestCase ();
+  virtual ~PathConfigTestCase () {}
+
+  void Trace (std::string path, int16_t oldValue, int16_t newValue) {m_count++; m_path = path;}
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_count;
+  std::string m_path;
+};
+
+PathConfigTestCase::PathConfigTestCase ()
+  : TestCase ("Check that a Config::Path can be reused and Config::ConnectMany")
+{
+}
+
+void
+PathConfigTestCase::DoRun (void)
+{
+  IntegerValue iv;
+
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+  std::vector<Ptr<ConfigTestObject> > nodes;
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      nodes.push_back (CreateObject<ConfigTestObject> ());
+      root->AddNodeA (nodes[i]);
+    }
+
+  //
+  // Overlapping and unsorted ranges match each index once.
+  //
+  Config::Path path = Config::Path ("/NodesA/3|[0-1]|[1-2]|7/A");
+  path.Set (IntegerValue (1));
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      nodes[i]->GetAttribute ("A", iv);
+      int64_t expected = i <= 3 ? 1 : 10;
+      NS_TEST_ASSERT_MSG_EQ (iv.Get (), expected, "Object " << i << " not set as expected");
+    }
+
+  //
+  // The path matches the objects which exist when it is used.
+  //
+  nodes.push_back (CreateObject<ConfigTestObject> ());
+  nodes.push_back (CreateObject<ConfigTestObject> ());
+  root->AddNodeA (nodes[6]);
+  root->AddNodeA (nodes[7]);
+  path.Set (IntegerValue (2));
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      nodes[i]->GetAttribute ("A", iv);
+      int64_t expected = i <= 3 || i == 7 ? 2 : 10;
+      NS_TEST_ASSERT_MSG_EQ (iv.Get (), expected, "Object " << i << " not set as expected");
+    }
+
+  //
+  // Connect twice to the first source and once to the second one. 
+  //
+  std::vector<std::string> paths;
+  std::vector<CallbackBase> cbs;
+  paths.push_back ("/NodesA/4/Source");
+  cbs.push_back (MakeCallback (&PathConfigTestCase::Trace, this));
+  paths.push_back ("/NodesA/4/Source");
+  cbs.push_back (MakeCallback (&PathConfigTestCase::Trace, this));
+  paths.push_back ("/NodesA/5/Source");
+  cbs.push_back (MakeCallback (&PathConfigTestCase::Trace, this));
+  Config::ConnectMany (paths, cbs);
+
+  m_count = 0;
+  nodes[4]->SetAttribute ("Source", IntegerValue (4));
+  NS_TEST_ASSERT_MSG_EQ (m_count, 2, "Trace 4 did not fire twice");
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/NodesA/4/Source", "Trace 4 did not provide expected context");
+  m_count = 0;
+  nodes[5]->SetAttribute ("Source", IntegerValue (5));
+  NS_TEST_ASSERT_MSG_EQ (m_count, 1, "Trace 5 did not fire once");
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/NodesA/5/Source", "Trace 5 did not provide expected context");
+  m_count = 0;
+  nodes[3]->SetAttribute ("Source", IntegerValue (3));
+  NS_TEST_ASSERT_MSG_EQ (m_count, 0, "Trace 3 fired unexpectedly");
+
+  Config::UnregisterRootNamespaceObject (root);
+}
+
 // ===========================================================================
 // The Test Suite that glues all of the Test Cases together.
 // ===========================================================================
@@ -1228,6 +1402,7 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new RootNamespaceConfigTestCase);
   AddTestCase (new UnderRootNamespaceConfigTestCase);
   AddTestCase (new ObjectVectorConfigTestCase);
+  AddTestCase (new PathConfigTestCase);
 }
 
 static ConfigTestSuite configTestSuite;
@@ -216,6 +216,80 @@ private:
  */
 MatchContainer LookupMatches (std::string path);
 
+/**
+ * \brief a path parsed once to match attributes or trace sources many times.
+ *
+ * Config::Set, Config::Connect and the other functions of this
+ * namespace parse their path at each call. A Path parses it once, when
+ * it is created, and each of its methods then matches the objects
+ * which exist when it is called.
+ */
+class Path
+{
+public:
+  /**
+   * \param path a path to match attributes or trace sources.
+   */
+  Path (std::string path);
+
+  /**
+   * \returns the path used to perform the object matching.
+   */
+  std::string GetPath (void) const;
+  /**
+   * \returns a container which contains all the objects which hold
+   *          the attribute or trace source matched by this path.
+   */
+  MatchContainer LookupMatches (void) const;
+  /**
+   * \param value the value to set in all matching attributes.
+   * \sa ns3::Config::Set
+   */
+  void Set (const AttributeValue &value) const;
+  /**
+   * \param cb the callback to connect to the matching trace sources.
+   * \sa ns3::Config::Connect
+   */
+  void Connect (const CallbackBase &cb) const;
+  /**
+   * \param cb the callback to connect to the matching trace sources.
+   * \sa ns3::Config::ConnectWithoutContext
+   */
+  void ConnectWithoutContext (const CallbackBase &cb) const;
+  /**
+   * \param cb the callback to disconnect from the matching trace sources.
+   * \sa ns3::Config::Disconnect
+   */
+  void Disconnect (const CallbackBase &cb) const;
+  /**
+   * \param cb the callback to disconnect from the matching trace sources.
+   * \sa ns3::Config::DisconnectWithoutContext
+   */
+  void DisconnectWithoutContext (const CallbackBase &cb) const;
+private:
+  friend void ConnectMany (const std::vector<std::string> &paths, 
+                           const std::vector<CallbackBase> &cbs);
+  std::string m_path;
+  // the path up to the last '/', and its elements
+  std::string m_root;
+  std::vector<std::string> m_items;
+  // the name of the attribute or trace source
+  std::string m_leaf;
+};
+
+/**
+ * \param paths paths to match trace sources.
+ * \param cbs the callbacks to connect to the trace sources matched by
+ *        the path of the same index.
+ *
+ * This function is equivalent to a call to Config::Connect for each
+ * path and callback, but it matches the objects only once for each
+ * run of consecutive paths which differ only by the name of their
+ * trace source, such as the trace sources of a device.
+ */
+void ConnectMany (const std::vector<std::string> &paths, 
+                  const std::vector<CallbackBase> &cbs);
+
 /**
  * \param obj a new root object
  *
@@ -0,0 +1,348 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "dary-heap-scheduler.h"
+#include "event-impl.h"
+#include "ns3/uinteger.h"
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+#include "ns3/log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+
+NS_LOG_COMPONENT_DEFINE ("DaryHeapScheduler");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (DaryHeapScheduler);
+
+TypeId
+DaryHeapScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::DaryHeapScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<DaryHeapScheduler> ()
+    .AddAttribute ("Arity",
+                   "The number of children of each node of the heap: 2, 4, 8 or 16.",
+                   UintegerValue (4),
+                   MakeUintegerAccessor (&DaryHeapScheduler::SetArity,
+                                         &DaryHeapScheduler::GetArity),
+                   MakeUintegerChecker<uint32_t> (2, 16))
+  ;
+  return tid;
+}
+
+DaryHeapScheduler::DaryHeapScheduler ()
+  : m_keys (0),
+    m_impls (0),
+    m_size (0),
+    m_capacity (0),
+    m_arity (4),
+    m_log2Arity (2)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+DaryHeapScheduler::~DaryHeapScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_keys != 0)
+    {
+      free (m_keys - (m_arity - 1));
+      free (m_impls - (m_arity - 1));
+    }
+  m_keys = 0;
+  m_impls = 0;
+}
+
+void
+DaryHeapScheduler::SetArity (uint32_t arity)
+{
+  NS_LOG_FUNCTION (this << arity);
+  NS_ASSERT (m_size == 0);
+  uint32_t log2Arity = 0;
+  while ((1U << log2Arity) < arity)
+    {
+      log2Arity++;
+    }
+  if ((1U << log2Arity) != arity)
+    {
+      NS_FATAL_ERROR ("The arity of a DaryHeapScheduler must be a power of two, not " << arity);
+    }
+  // the padding at the start of the arrays depends on the arity.
+  if (m_keys != 0)
+    {
+      free (m_keys - (m_arity - 1));
+      free (m_impls - (m_arity - 1));
+      m_keys = 0;
+      m_impls = 0;
+      m_capacity = 0;
+    }
+  m_arity = arity;
+  m_log2Arity = log2Arity;
+}
+
+uint32_t
+DaryHeapScheduler::GetArity (void) const
+{
+  return m_arity;
+}
+
+void
+DaryHeapScheduler::Reserve (uint32_t capacity)
+{
+  NS_LOG_FUNCTION (this << capacity);
+  uint32_t padding = m_arity - 1;
+  void *keys;
+  if (posix_memalign (&keys, 64, (capacity + padding) * sizeof (EventKey)) != 0)
+    {
+      throw std::bad_alloc ();
+    }
+  EventImpl **impls = static_cast<EventImpl **> (malloc ((capacity + padding) * sizeof (EventImpl *)));
+  if (impls == 0)
+    {
+      free (keys);
+      throw std::bad_alloc ();
+    }
+  if (m_keys != 0)
+    {
+      memcpy (static_cast<EventKey *> (keys) + padding, m_keys, m_size * sizeof (EventKey));
+      memcpy (impls + padding, m_impls, m_size * sizeof (EventImpl *));
+      free (m_keys - padding);
+      free (m_impls - padding);
+    }
+  m_keys = static_cast<EventKey *> (keys) + padding;
+  m_impls = impls + padding;
+  m_capacity = capacity;
+}
+
+uint32_t
+DaryHeapScheduler::Parent (uint32_t index) const
+{
+  return (index - 1) >> m_log2Arity;
+}
+
+uint32_t
+DaryHeapScheduler::FirstChild (uint32_t index) const
+{
+  return (index << m_log2Arity) + 1;
+}
+
+void
+DaryHeapScheduler::Set (uint32_t index, const EventKey &key, EventImpl *impl)
+{
+  m_keys[index] = key;
+  m_impls[index] = impl;
+  impl->SetSchedulerIndex (index);
+}
+
+void
+DaryHeapScheduler::Move (uint32_t to, uint32_t from)
+{
+  Set (to, m_keys[from], m_impls[from]);
+}
+
+void
+DaryHeapScheduler::SiftUp (uint32_t index, const EventKey &key, EventImpl *impl)
+{
+  while (index > 0)
+    {
+      uint32_t parent = Parent (index);
+      if (!(key < m_keys[parent]))
+        {
+          break;
+        }
+      Move (index, parent);
+      index = parent;
+    }
+  Set (index, key, impl);
+}
+
+void
+DaryHeapScheduler::SiftDown (uint32_t index, const EventKey &key, EventImpl *impl)
+{
+  while (true)
+    {
+      uint32_t first = FirstChild (index);
+      if (first >= m_size)
+        {
+          break;
+        }
+      uint32_t last = first + m_arity;
+      if (last > m_size)
+        {
+          last = m_size;
+        }
+      // all the children are in the same cache line(s)
+      uint32_t smallest = first;
+      for (uint32_t child = first + 1; child < last; child++)
+        {
+          if (m_keys[child] < m_keys[smallest])
+            {
+              smallest = child;
+            }
+        }
+      if (!(m_keys[smallest] < key))
+        {
+          break;
+        }
+      Move (index, smallest);
+      index = smallest;
+    }
+  Set (index, key, impl);
+}
+
+void
+DaryHeapScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  if (m_size == m_capacity)
+    {
+      Reserve (m_capacity == 0 ? 64 : m_capacity * 2);
+    }
+  m_size++;
+  SiftUp (m_size - 1, ev.key, ev.impl);
+}
+
+void
+DaryHeapScheduler::InsertBatch (const std::vector<Event> &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  uint32_t size = m_size + events.size ();
+  if (size > m_capacity)
+    {
+      uint32_t capacity = m_capacity == 0 ? 64 : m_capacity;
+      while (capacity < size)
+        {
+          capacity *= 2;
+        }
+      Reserve (capacity);
+    }
+  if (events.size () < m_size)
+    {
+      for (std::vector<Event>::const_iterator i = events.begin (); i != events.end (); i++)
+        {
+          m_size++;
+          SiftUp (m_size - 1, i->key, i->impl);
+        }
+      return;
+    }
+  for (std::vector<Event>::const_iterator i = events.begin (); i != events.end (); i++)
+    {
+      Set (m_size, i->key, i->impl);
+      m_size++;
+    }
+  Heapify ();
+}
+
+bool
+DaryHeapScheduler::IsEmpty (void) const
+{
+  return m_size == 0;
+}
+
+Scheduler::Event
+DaryHeapScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  Event ev;
+  ev.impl = m_impls[0];
+  ev.key = m_keys[0];
+  return ev;
+}
+
+Scheduler::Event
+DaryHeapScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  Event ev;
+  ev.impl = m_impls[0];
+  ev.key = m_keys[0];
+  m_size--;
+  if (m_size > 0)
+    {
+      SiftDown (0, m_keys[m_size], m_impls[m_size]);
+    }
+  return ev;
+}
+
+void
+DaryHeapScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (!IsEmpty ());
+  uint32_t index = ev.impl->GetSchedulerIndex ();
+  NS_ASSERT (index < m_size && m_impls[index] == ev.impl);
+  m_size--;
+  if (index == m_size)
+    {
+      return;
+    }
+  EventKey key = m_keys[m_size];
+  EventImpl *impl = m_impls[m_size];
+  if (index > 0 && key < m_keys[Parent (index)])
+    {
+      SiftUp (index, key, impl);
+    }
+  else
+    {
+      SiftDown (index, key, impl);
+    }
+}
+
+void
+DaryHeapScheduler::RemoveCancelled (std::vector<Event> &removed)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t size = 0;
+  for (uint32_t i = 0; i < m_size; i++)
+    {
+      if (m_impls[i]->IsCancelled ())
+        {
+          Event ev;
+          ev.impl = m_impls[i];
+          ev.key = m_keys[i];
+          removed.push_back (ev);
+        }
+      else
+        {
+          Move (size, i);
+          size++;
+        }
+    }
+  m_size = size;
+  Heapify ();
+}
+
+void
+DaryHeapScheduler::Heapify (void)
+{
+  if (m_size <= 1)
+    {
+      return;
+    }
+  // rebuild the heap from the bottom up.
+  for (uint32_t i = Parent (m_size - 1) + 1; i > 0; i--)
+    {
+      EventKey key = m_keys[i - 1];
+      SiftDown (i - 1, key, m_impls[i - 1]);
+    }
+}
+
+} // namespace ns3
@@ -25,10 +25,15 @@
 
 #include "ns3/ptr.h"
 #include "ns3/pointer.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/core-config.h"
 
 #include <math.h>
+#include <iostream>
 
 NS_LOG_COMPONENT_DEFINE ("DefaultSimulatorImpl");
 
@@ -42,6 +47,34 @@ DefaultSimulatorImpl::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::DefaultSimulatorImpl")
     .SetParent<SimulatorImpl> ()
     .AddConstructor<DefaultSimulatorImpl> ()
+    .AddAttribute ("EnableEventPool",
+                   "If true, events are allocated from a memory pool owned by this simulator "
+                   "rather than from the system allocator. Disable it to debug memory errors "
+                   "in event handlers with tools such as valgrind.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&DefaultSimulatorImpl::m_enableEventPool),
+                   MakeBooleanChecker ())
+    .AddAttribute ("CompactionRatio",
+                   "The proportion of cancelled events in the event list above which "
+                   "these events are removed from it, instead of waiting for their "
+                   "expiration time. Zero disables compaction.",
+                   DoubleValue (0.5),
+                   MakeDoubleAccessor (&DefaultSimulatorImpl::m_compactionRatio),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("CompactionMinEvents",
+                   "The minimum number of cancelled events in the event list "
+                   "before it is compacted.",
+                   UintegerValue (1024),
+                   MakeUintegerAccessor (&DefaultSimulatorImpl::m_compactionMinEvents),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("EnableProfiler",
+                   "If true, the wall-clock time spent in each kind of event and in each "
+                   "context is measured and reported on std::clog when the simulation is "
+                   "destroyed. This has no effect unless ns-3 was configured with "
+                   "--enable-event-profiler.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&DefaultSimulatorImpl::m_enableProfiler),
+                   MakeBooleanChecker ())
     ;
   return tid;
 }
@@ -59,11 +92,33 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = 0xffffffff;
   m_unscheduledEvents = 0;
+  m_eventPool = 0;
+  m_cancelledEvents = 0;
+  m_compactions = 0;
+  m_compactedEvents = 0;
+  m_profiler = 0;
 }
 
 DefaultSimulatorImpl::~DefaultSimulatorImpl ()
 {}
 
+void
+DefaultSimulatorImpl::NotifyConstructionCompleted (void)
+{
+  if (m_enableEventPool)
+    {
+      m_eventPool = new EventMemoryPool ();
+      EventMemoryPool::SetCurrent (m_eventPool);
+    }
+#ifdef ENABLE_EVENT_PROFILER
+  if (m_enableProfiler)
+    {
+      m_profiler = new EventProfiler ();
+    }
+#endif /* ENABLE_EVENT_PROFILER */
+  SimulatorImpl::NotifyConstructionCompleted ();
+}
+
 void 
 DefaultSimulatorImpl::DoDispose (void)
 {
@@ -73,6 +128,15 @@ DefaultSimulatorImpl::DoDispose (void)
       next.impl->Unref ();
     }
   m_events = 0;
+  if (m_eventPool != 0)
+    {
+      // the pool deletes itself when the last event which
+      // references it is deleted.
+      m_eventPool->Release ();
+      m_eventPool = 0;
+    }
+  delete m_profiler;
+  m_profiler = 0;
   SimulatorImpl::DoDispose ();
 }
 void
@@ -88,6 +152,12 @@ DefaultSimulatorImpl::Destroy ()
           ev->Invoke ();
         }
     }
+#ifdef ENABLE_EVENT_PROFILER
+  if (m_profiler != 0)
+    {
+      m_profiler->Report (std::clog);
+    }
+#endif /* ENABLE_EVENT_PROFILER */
 }
 
 void
@@ -120,11 +190,26 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
 
   NS_ASSERT (next.key.m_ts >= m_currentTs);
   m_unscheduledEvents--;
+  if (next.impl->IsCancelled ())
+    {
+      NS_ASSERT (m_cancelledEvents > 0);
+      m_cancelledEvents--;
+    }
 
   NS_LOG_LOGIC ("handle " << next.key.m_ts);
   m_currentTs = next.key.m_ts;
   m_currentContext = next.key.m_context;
   m_currentUid = next.key.m_uid;
+#ifdef ENABLE_EVENT_PROFILER
+  if (m_profiler != 0 && !next.impl->IsCancelled ())
+    {
+      m_profiler->Start ();
+      next.impl->Invoke ();
+      m_profiler->Stop (next.impl, next.key.m_context);
+      next.impl->Unref ();
+      return;
+    }
+#endif /* ENABLE_EVENT_PROFILER */
   next.impl->Invoke ();
   next.impl->Unref ();
 }
@@ -217,6 +302,45 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &time, E
   m_events->Insert (ev);
 }
 
+void
+DefaultSimulatorImpl::InsertBatch (const std::vector<BatchEvent> &events, bool withContext)
+{
+  m_batch.clear ();
+  m_batch.reserve (events.size ());
+  uint32_t currentContext = GetContext ();
+  for (std::vector<BatchEvent>::const_iterator i = events.begin (); i != events.end (); i++)
+    {
+      NS_ASSERT (!i->delay.IsStrictlyNegative ());
+      Scheduler::Event ev;
+      ev.impl = i->event;
+      ev.key.m_ts = m_currentTs + i->delay.GetTimeStep ();
+      ev.key.m_context = withContext ? i->context : currentContext;
+      ev.key.m_uid = m_uid;
+      m_uid++;
+      m_batch.push_back (ev);
+    }
+  m_unscheduledEvents += events.size ();
+  m_events->InsertBatch (m_batch);
+}
+
+void
+DefaultSimulatorImpl::ScheduleBatch (const std::vector<BatchEvent> &events, std::vector<EventId> &ids)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  InsertBatch (events, false);
+  for (std::vector<Scheduler::Event>::const_iterator i = m_batch.begin (); i != m_batch.end (); i++)
+    {
+      ids.push_back (EventId (i->impl, i->key.m_ts, i->key.m_context, i->key.m_uid));
+    }
+}
+
+void
+DefaultSimulatorImpl::ScheduleWithContextBatch (const std::vector<BatchEvent> &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  InsertBatch (events, true);
+}
+
 EventId
 DefaultSimulatorImpl::ScheduleNow (EventImpl *event)
 {
@@ -298,9 +422,63 @@ DefaultSimulatorImpl::Cancel (const EventId &id)
   if (!IsExpired (id))
     {
       id.PeekEventImpl ()->Cancel ();
+      if (id.GetUid () == 2)
+        {
+          // destroy events are not stored in m_events.
+          return;
+        }
+      m_cancelledEvents++;
+      if (m_compactionRatio > 0
+          && m_cancelledEvents >= m_compactionMinEvents
+          && m_cancelledEvents > m_compactionRatio * m_unscheduledEvents)
+        {
+          Compact ();
+        }
     }
 }
 
+void
+DefaultSimulatorImpl::Compact (void)
+{
+  NS_LOG_FUNCTION (this << m_cancelledEvents << m_unscheduledEvents);
+  std::vector<Scheduler::Event> removed;
+  removed.reserve (m_cancelledEvents);
+  m_events->RemoveCancelled (removed);
+  NS_ASSERT (removed.size () == m_cancelledEvents);
+  for (std::vector<Scheduler::Event>::const_iterator i = removed.begin (); i != removed.end (); i++)
+    {
+      i->impl->Unref ();
+    }
+  m_unscheduledEvents -= removed.size ();
+  m_cancelledEvents = 0;
+  m_compactions++;
+  m_compactedEvents += removed.size ();
+}
+
+uint32_t
+DefaultSimulatorImpl::GetEventCount (void) const
+{
+  return m_unscheduledEvents;
+}
+
+uint32_t
+DefaultSimulatorImpl::GetCancelledEventCount (void) const
+{
+  return m_cancelledEvents;
+}
+
+uint64_t
+DefaultSimulatorImpl::GetCompactionCount (void) const
+{
+  return m_compactions;
+}
+
+uint64_t
+DefaultSimulatorImpl::GetCompactedEventCount (void) const
+{
+  return m_compactedEvents;
+}
+
 bool
 DefaultSimulatorImpl::IsExpired (const EventId &ev) const
 {
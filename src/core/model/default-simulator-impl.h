@@ -24,6 +24,8 @@
 #include "simulator-impl.h"
 #include "scheduler.h"
 #include "event-impl.h"
+#include "event-memory-pool.h"
+#include "event-profiler.h"
 
 #include "ns3/ptr.h"
 
@@ -46,6 +48,8 @@ public:
   virtual void Stop (Time const &time);
   virtual EventId Schedule (Time const &time, EventImpl *event);
   virtual void ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event);
+  virtual void ScheduleBatch (const std::vector<BatchEvent> &events, std::vector<EventId> &ids);
+  virtual void ScheduleWithContextBatch (const std::vector<BatchEvent> &events);
   virtual EventId ScheduleNow (EventImpl *event);
   virtual EventId ScheduleDestroy (EventImpl *event);
   virtual void Remove (const EventId &ev);
@@ -60,9 +64,34 @@ public:
   virtual uint32_t GetSystemId (void) const; 
   virtual uint32_t GetContext (void) const;
 
+  /**
+   * \returns the number of events which are stored in the event list,
+   *          including those which have been cancelled.
+   */
+  uint32_t GetEventCount (void) const;
+  /**
+   * \returns the number of events which have been cancelled but which
+   *          are still stored in the event list.
+   */
+  uint32_t GetCancelledEventCount (void) const;
+  /**
+   * \returns the number of times the event list has been compacted.
+   */
+  uint64_t GetCompactionCount (void) const;
+  /**
+   * \returns the total number of cancelled events which have been
+   *          removed from the event list by compactions.
+   */
+  uint64_t GetCompactedEventCount (void) const;
+
+protected:
+  virtual void NotifyConstructionCompleted (void);
+
 private:
   virtual void DoDispose (void);
   void ProcessOneEvent (void);
+  void Compact (void);
+  void InsertBatch (const std::vector<BatchEvent> &events, bool withContext);
   uint64_t NextTs (void) const;
   typedef std::list<EventId> DestroyEvents;
 
@@ -76,6 +105,23 @@ private:
   // number of events that have been inserted but not yet scheduled,
   // not counting the "destroy" events; this is used for validation
   int m_unscheduledEvents;
+  // if true, all events are allocated from m_eventPool
+  bool m_enableEventPool;
+  EventMemoryPool *m_eventPool;
+  // number of events in m_events which have been cancelled.
+  uint32_t m_cancelledEvents;
+  // the event list is compacted when the proportion of cancelled
+  // events goes above m_compactionRatio, provided that there are
+  // at least m_compactionMinEvents cancelled events.
+  double m_compactionRatio;
+  uint32_t m_compactionMinEvents;
+  uint64_t m_compactions;
+  uint64_t m_compactedEvents;
+  // only used when ns-3 was configured with --enable-event-profiler
+  bool m_enableProfiler;
+  EventProfiler *m_profiler;
+  // reused by InsertBatch to avoid an allocation per batch
+  std::vector<Scheduler::Event> m_batch;
 };
 
 } // namespace ns3
@@ -19,6 +19,7 @@
  */
 
 #include "event-impl.h"
+#include "event-memory-pool.h"
 
 namespace ns3 {
 
@@ -26,7 +27,8 @@ EventImpl::~EventImpl ()
 {}
 
 EventImpl::EventImpl ()
-  : m_cancel (false)
+  : m_cancel (false),
+    m_schedulerIndex (0)
 {}
 
 void 
@@ -50,4 +52,16 @@ EventImpl::IsCancelled (void)
   return m_cancel;
 }
 
+void *
+EventImpl::operator new (size_t size)
+{
+  return EventMemoryPool::Allocate (size);
+}
+
+void
+EventImpl::operator delete (void *buffer, size_t size)
+{
+  EventMemoryPool::Deallocate (buffer, size);
+}
+
 } // namespace ns3
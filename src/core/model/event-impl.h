@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <stddef.h>
 #include "ns3/simple-ref-count.h"
 
 namespace ns3 {
@@ -58,13 +59,50 @@ public:
    */
   bool IsCancelled (void);
 
+  /**
+   * \param index the position of this event in the scheduler which
+   *        holds it.
+   *
+   * Schedulers which need to find an event from its EventId, such as
+   * the DaryHeapScheduler, can record its position here and keep it up
+   * to date while they hold the event.
+   */
+  inline void SetSchedulerIndex (uint32_t index);
+  /**
+   * \returns the position last recorded by SetSchedulerIndex.
+   */
+  inline uint32_t GetSchedulerIndex (void) const;
+
+  /**
+   * All events are allocated from the current EventMemoryPool, if any.
+   */
+  static void *operator new (size_t size);
+  static void operator delete (void *buffer, size_t size);
+
 protected:
   virtual void Notify (void) = 0;
 
 private:
   bool m_cancel;
+  uint32_t m_schedulerIndex;
 };
 
 } // namespace ns3
 
+namespace ns3 {
+
+void
+EventImpl::SetSchedulerIndex (uint32_t index)
+{
+  m_schedulerIndex = index;
+}
+
+uint32_t
+EventImpl::GetSchedulerIndex (void) const
+{
+  return m_schedulerIndex;
+}
+
+} // namespace ns3
+
 #endif /* EVENT_IMPL_H */
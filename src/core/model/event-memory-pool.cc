@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "event-memory-pool.h"
+#include "ns3/assert.h"
+#include <stdlib.h>
+#include <new>
+
+namespace ns3 {
+
+__thread EventMemoryPool *EventMemoryPool::g_current = 0;
+__thread uint64_t EventMemoryPool::g_allocations = 0;
+__thread uint64_t EventMemoryPool::g_systemAllocations = 0;
+
+EventMemoryPool::EventMemoryPool ()
+  : m_remote (0),
+    m_allocated (0),
+    m_freed (0),
+    m_balance (RELEASE_BIAS)
+{
+  for (uint32_t i = 0; i < N_SIZE_CLASSES; i++)
+    {
+      m_free[i] = 0;
+    }
+}
+
+EventMemoryPool::~EventMemoryPool ()
+{
+  NS_ASSERT (m_balance == 0);
+  for (std::vector<uint8_t *>::const_iterator i = m_chunks.begin (); i != m_chunks.end (); i++)
+    {
+      free (*i);
+    }
+  m_chunks.clear ();
+}
+
+void
+EventMemoryPool::Release (void)
+{
+  NS_ASSERT (m_balance >= RELEASE_BIAS);
+  if (g_current == this)
+    {
+      g_current = 0;
+    }
+  int64_t live = m_allocated - m_freed;
+  if (__sync_sub_and_fetch (&m_balance, RELEASE_BIAS + live) == 0)
+    {
+      delete this;
+    }
+}
+
+uint32_t
+EventMemoryPool::GetSizeClass (size_t size)
+{
+  return (size + sizeof (Header) + GRANULARITY - 1) / GRANULARITY - 1;
+}
+
+void
+EventMemoryPool::Refill (uint32_t sizeClass)
+{
+  uint32_t blockSize = (sizeClass + 1) * GRANULARITY;
+  uint32_t nBlocks = CHUNK_SIZE / blockSize;
+  uint8_t *chunk = static_cast<uint8_t *> (malloc (nBlocks * blockSize));
+  if (chunk == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  g_systemAllocations++;
+  m_chunks.push_back (chunk);
+  for (uint32_t i = 0; i < nBlocks; i++)
+    {
+      FreeBlock *block = reinterpret_cast<FreeBlock *> (chunk + i * blockSize);
+      block->next = m_free[sizeClass];
+      m_free[sizeClass] = block;
+    }
+}
+
+void
+EventMemoryPool::TakeRemote (void)
+{
+  if (m_remote == 0)
+    {
+      return;
+    }
+  FreeBlock *block = __sync_lock_test_and_set (&m_remote, (FreeBlock *)0);
+  while (block != 0)
+    {
+      FreeBlock *next = block->next;
+      block->next = m_free[block->sizeClass];
+      m_free[block->sizeClass] = block;
+      block = next;
+    }
+}
+
+EventMemoryPool::Header *
+EventMemoryPool::DoAllocate (uint32_t sizeClass)
+{
+  if (m_free[sizeClass] == 0)
+    {
+      TakeRemote ();
+    }
+  if (m_free[sizeClass] == 0)
+    {
+      Refill (sizeClass);
+    }
+  FreeBlock *block = m_free[sizeClass];
+  m_free[sizeClass] = block->next;
+  m_allocated++;
+  Header *header = reinterpret_cast<Header *> (block);
+  header->pool = this;
+  return header;
+}
+
+void
+EventMemoryPool::DoDeallocate (Header *header, uint32_t sizeClass)
+{
+  FreeBlock *block = reinterpret_cast<FreeBlock *> (header);
+  if (g_current == this)
+    {
+      NS_ASSERT (m_allocated > m_freed);
+      block->next = m_free[sizeClass];
+      m_free[sizeClass] = block;
+      m_freed++;
+      return;
+    }
+  block->sizeClass = sizeClass;
+  FreeBlock *head;
+  do
+    {
+      head = m_remote;
+      block->next = head;
+    }
+  while (!__sync_bool_compare_and_swap (&m_remote, head, block));
+  if (__sync_add_and_fetch (&m_balance, 1) == 0)
+    {
+      delete this;
+    }
+}
+
+void *
+EventMemoryPool::Allocate (size_t size)
+{
+  g_allocations++;
+  uint32_t sizeClass = GetSizeClass (size);
+  Header *header;
+  if (g_current != 0 && sizeClass < N_SIZE_CLASSES)
+    {
+      header = g_current->DoAllocate (sizeClass);
+    }
+  else
+    {
+      header = static_cast<Header *> (malloc (size + sizeof (Header)));
+      if (header == 0)
+        {
+          throw std::bad_alloc ();
+        }
+      g_systemAllocations++;
+      header->pool = 0;
+    }
+  return header + 1;
+}
+
+void
+EventMemoryPool::Deallocate (void *buffer, size_t size)
+{
+  if (buffer == 0)
+    {
+      return;
+    }
+  Header *header = static_cast<Header *> (buffer) - 1;
+  if (header->pool == 0)
+    {
+      free (header);
+    }
+  else
+    {
+      header->pool->DoDeallocate (header, GetSizeClass (size));
+    }
+}
+
+void
+EventMemoryPool::SetCurrent (EventMemoryPool *pool)
+{
+  g_current = pool;
+}
+
+EventMemoryPool *
+EventMemoryPool::GetCurrent (void)
+{
+  return g_current;
+}
+
+uint64_t
+EventMemoryPool::GetAllocations (void)
+{
+  return g_allocations;
+}
+
+uint64_t
+EventMemoryPool::GetSystemAllocations (void)
+{
+  return g_systemAllocations;
+}
+
+} // namespace ns3
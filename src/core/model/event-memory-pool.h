@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef EVENT_MEMORY_POOL_H
+#define EVENT_MEMORY_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ * \brief a size-class memory pool for EventImpl instances
+ *
+ * Every EventImpl (and, thus, every event created by MakeEvent) is
+ * allocated through EventImpl::operator new which forwards the request
+ * to EventMemoryPool::Allocate. If a pool has been made current with
+ * SetCurrent, the memory is carved from one of its per-size free lists
+ * and returned to that same list when the event is deleted. Otherwise,
+ * the memory comes straight from the system allocator.
+ *
+ * Each block starts with a small header which records the pool it was
+ * taken from so that events which outlive the simulator which owns
+ * the pool (i.e., events still referenced by an EventId after
+ * Simulator::Destroy) are returned to the right pool. A pool which has
+ * been released by its owner deletes itself once its last block has
+ * been returned.
+ *
+ * The current pool is a property of the calling thread: the events
+ * created by the other threads come from the system allocator. An
+ * event may be deleted by any thread: the blocks returned by a thread
+ * other than the one which made the pool current are pushed on a
+ * lock-free list, which this thread takes back when it runs out of
+ * blocks of some size.
+ */
+class EventMemoryPool
+{
+public:
+  EventMemoryPool ();
+  /**
+   * Called by the owner of this pool when it does not need it anymore,
+   * from the thread which made it current. The pool is deleted as soon
+   * as all its blocks have been returned.
+   */
+  void Release (void);
+
+  /**
+   * \param size the number of bytes to allocate
+   * \returns a buffer of at least size bytes
+   */
+  static void *Allocate (size_t size);
+  /**
+   * \param buffer a buffer returned by Allocate
+   * \param size the size which was passed to Allocate
+   */
+  static void Deallocate (void *buffer, size_t size);
+
+  /**
+   * \param pool the pool to use for all subsequent allocations made
+   *        by the calling thread, or zero to use the system allocator.
+   */
+  static void SetCurrent (EventMemoryPool *pool);
+  /**
+   * \returns the pool used for the allocations made by the calling
+   *          thread, or zero if none.
+   */
+  static EventMemoryPool *GetCurrent (void);
+
+  /**
+   * \returns the number of buffers handed out by Allocate to the
+   *          calling thread since it started.
+   */
+  static uint64_t GetAllocations (void);
+  /**
+   * \returns the number of calls made to the system allocator on
+   *          behalf of Allocate by the calling thread since it started.
+   */
+  static uint64_t GetSystemAllocations (void);
+
+private:
+  union Header
+  {
+    EventMemoryPool *pool;
+    // make sure the buffer which follows the header is suitably
+    // aligned for any kind of member.
+    long double alignLongDouble;
+    uint64_t alignUint64;
+    void *alignPointer;
+  };
+  struct FreeBlock
+  {
+    struct FreeBlock *next;
+    // only set in the blocks of m_remote.
+    uint32_t sizeClass;
+  };
+  enum {
+    GRANULARITY = 16,
+    N_SIZE_CLASSES = 16,
+    CHUNK_SIZE = 16384
+  };
+
+  ~EventMemoryPool ();
+  Header *DoAllocate (uint32_t sizeClass);
+  void DoDeallocate (Header *header, uint32_t sizeClass);
+  void TakeRemote (void);
+  void Refill (uint32_t sizeClass);
+  static uint32_t GetSizeClass (size_t size);
+
+  FreeBlock *m_free[N_SIZE_CLASSES];
+  std::vector<uint8_t *> m_chunks;
+  // the blocks returned by the other threads.
+  FreeBlock * volatile m_remote;
+  // the number of blocks taken from and returned to m_free.
+  uint64_t m_allocated;
+  uint64_t m_freed;
+  // RELEASE_BIAS plus the number of blocks pushed on m_remote, until
+  // Release subtracts the bias and the blocks not returned to m_free:
+  // the operation which brings it to zero deletes the pool.
+  volatile int64_t m_balance;
+
+  static const int64_t RELEASE_BIAS = 1LL << 62;
+  static __thread EventMemoryPool *g_current;
+  static __thread uint64_t g_allocations;
+  static __thread uint64_t g_systemAllocations;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_MEMORY_POOL_H */
@@ -0,0 +1,199 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "event-profiler.h"
+#include "event-impl.h"
+#include <typeinfo>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <iomanip>
+#include <sstream>
+#include <stdlib.h>
+#include <time.h>
+#ifdef __GNUC__
+#include <cxxabi.h>
+#endif
+
+namespace ns3 {
+
+// the number of contexts listed in the report.
+static const uint32_t MAX_CONTEXTS = 20;
+
+EventProfiler::Stats::Stats ()
+  : count (0),
+    ns (0)
+{}
+
+EventProfiler::EventProfiler ()
+  : m_start (0)
+{}
+
+uint64_t
+EventProfiler::GetNanoSeconds (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void
+EventProfiler::Start (void)
+{
+  m_start = GetNanoSeconds ();
+}
+
+void
+EventProfiler::Stop (const EventImpl *event, uint32_t context)
+{
+  uint64_t delta = GetNanoSeconds () - m_start;
+  Stats &type = m_types[typeid (*event).name ()];
+  type.count++;
+  type.ns += delta;
+  Stats &ctx = m_contexts[context];
+  ctx.count++;
+  ctx.ns += delta;
+}
+
+uint64_t
+EventProfiler::GetEventCount (void) const
+{
+  uint64_t count = 0;
+  for (std::map<const char *, Stats>::const_iterator i = m_types.begin (); i != m_types.end (); i++)
+    {
+      count += i->second.count;
+    }
+  return count;
+}
+
+static std::string
+Demangle (const char *name)
+{
+#ifdef __GNUC__
+  int status;
+  char *demangled = abi::__cxa_demangle (name, 0, 0, &status);
+  if (status == 0 && demangled != 0)
+    {
+      std::string result = demangled;
+      free (demangled);
+      return result;
+    }
+#endif
+  return name;
+}
+
+// the events created by MakeEvent are local classes of MakeEvent: only
+// keep the template arguments, that is, the type of the function and
+// of its arguments, to make the report readable.
+static std::string
+Simplify (std::string name)
+{
+  std::string prefix = "ns3::MakeEvent<";
+  if (name.compare (0, prefix.size (), prefix) != 0)
+    {
+      return name;
+    }
+  uint32_t depth = 1;
+  for (std::string::size_type i = prefix.size (); i < name.size (); i++)
+    {
+      if (name[i] == '<')
+        {
+          depth++;
+        }
+      else if (name[i] == '>')
+        {
+          depth--;
+          if (depth == 0)
+            {
+              std::string::size_type end = name.find_last_not_of (' ', i - 1);
+              return name.substr (prefix.size (), end + 1 - prefix.size ());
+            }
+        }
+    }
+  return name;
+}
+
+static void
+PrintLine (std::ostream &os, uint64_t ns, uint64_t count, uint64_t totalNs, std::string what)
+{
+  os << std::setw (12) << ns / 1e6
+     << std::setw (8) << (totalNs == 0 ? 0.0 : 100.0 * ns / totalNs)
+     << std::setw (12) << count
+     << std::setw (12) << (count == 0 ? 0 : ns / count)
+     << "  " << what << std::endl;
+}
+
+void
+EventProfiler::Report (std::ostream &os) const
+{
+  // the same class can have a different name pointer in
+  // each library: merge them by name.
+  std::map<std::string, Stats> types;
+  uint64_t totalNs = 0;
+  uint64_t totalCount = 0;
+  for (std::map<const char *, Stats>::const_iterator i = m_types.begin (); i != m_types.end (); i++)
+    {
+      Stats &stats = types[Simplify (Demangle (i->first))];
+      stats.count += i->second.count;
+      stats.ns += i->second.ns;
+      totalNs += i->second.ns;
+      totalCount += i->second.count;
+    }
+  std::vector<std::pair<uint64_t, std::string> > sortedTypes;
+  for (std::map<std::string, Stats>::const_iterator i = types.begin (); i != types.end (); i++)
+    {
+      sortedTypes.push_back (std::make_pair (i->second.ns, i->first));
+    }
+  std::sort (sortedTypes.rbegin (), sortedTypes.rend ());
+  std::vector<std::pair<uint64_t, uint32_t> > sortedContexts;
+  for (std::map<uint32_t, Stats>::const_iterator i = m_contexts.begin (); i != m_contexts.end (); i++)
+    {
+      sortedContexts.push_back (std::make_pair (i->second.ns, i->first));
+    }
+  std::sort (sortedContexts.rbegin (), sortedContexts.rend ());
+
+  std::ios::fmtflags flags = os.flags ();
+  os.setf (std::ios::fixed);
+  std::streamsize precision = os.precision (3);
+  os << "Event profile: " << totalCount << " events, " << totalNs / 1e6 << "ms" << std::endl;
+  os << std::setw (12) << "time(ms)" << std::setw (8) << "%"
+     << std::setw (12) << "count" << std::setw (12) << "ns/event" << "  event" << std::endl;
+  for (std::vector<std::pair<uint64_t, std::string> >::const_iterator i = sortedTypes.begin ();
+       i != sortedTypes.end (); i++)
+    {
+      const Stats &stats = types.find (i->second)->second;
+      PrintLine (os, stats.ns, stats.count, totalNs, i->second);
+    }
+  os << std::setw (12) << "time(ms)" << std::setw (8) << "%"
+     << std::setw (12) << "count" << std::setw (12) << "ns/event" << "  context" << std::endl;
+  for (uint32_t i = 0; i < sortedContexts.size () && i < MAX_CONTEXTS; i++)
+    {
+      const Stats &stats = m_contexts.find (sortedContexts[i].second)->second;
+      std::ostringstream context;
+      if (sortedContexts[i].second == 0xffffffff)
+        {
+          context << "none";
+        }
+      else
+        {
+          context << sortedContexts[i].second;
+        }
+      PrintLine (os, stats.ns, stats.count, totalNs, context.str ());
+    }
+  os.precision (precision);
+  os.flags (flags);
+}
+
+} // namespace ns3
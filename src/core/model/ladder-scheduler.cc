@@ -0,0 +1,331 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+static bool
+IsLater (const Scheduler::Event &a, const Scheduler::Event &b)
+{
+  return a.key > b.key;
+}
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<LadderScheduler> ()
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_topMin (~(uint64_t)0),
+    m_topMax (0),
+    m_topStart (0),
+    m_rungs (MAX_RUNGS),
+    m_nRungs (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+LadderScheduler::~LadderScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint64_t
+LadderScheduler::GetCurrentStart (const Rung &rung) const
+{
+  return rung.start + rung.current * rung.width;
+}
+
+uint32_t
+LadderScheduler::GetBucket (const Rung &rung, uint64_t ts) const
+{
+  uint64_t bucket = (ts - rung.start) / rung.width;
+  NS_ASSERT (bucket < rung.nBuckets);
+  return bucket;
+}
+
+LadderScheduler::Rung *
+LadderScheduler::CreateRung (uint64_t start, uint64_t end, uint32_t nEvents)
+{
+  NS_LOG_FUNCTION (this << start << end << nEvents);
+  NS_ASSERT (m_nRungs < MAX_RUNGS);
+  NS_ASSERT (start < end);
+  uint64_t range = end - start;
+  uint64_t nBuckets = std::max<uint32_t> (1, std::min<uint32_t> (nEvents, MAX_BUCKETS));
+  uint64_t width = range / nBuckets + ((range % nBuckets) != 0 ? 1 : 0);
+  // with very narrow buckets, fewer of them are needed to cover
+  // the range.
+  nBuckets = range / width + ((range % width) != 0 ? 1 : 0);
+
+  Rung *rung = &m_rungs[m_nRungs];
+  m_nRungs++;
+  if (rung->buckets.size () < nBuckets)
+    {
+      rung->buckets.resize (nBuckets);
+    }
+  rung->nBuckets = nBuckets;
+  rung->start = start;
+  rung->width = width;
+  rung->current = 0;
+  rung->count = 0;
+  return rung;
+}
+
+void
+LadderScheduler::MoveToBottom (Bucket &bucket)
+{
+  NS_ASSERT (m_bottom.empty ());
+  m_bottom.swap (bucket);
+  std::sort (m_bottom.begin (), m_bottom.end (), IsLater);
+}
+
+void
+LadderScheduler::SpawnFromTop (void)
+{
+  NS_LOG_FUNCTION (this << m_top.size () << m_topMin << m_topMax);
+  NS_ASSERT (m_nRungs == 0);
+  if (m_top.size () <= THRESHOLD || m_topMin == m_topMax)
+    {
+      MoveToBottom (m_top);
+      m_topStart = m_topMax + 1;
+    }
+  else
+    {
+      Rung *rung = CreateRung (m_topMin, m_topMax + 1, m_top.size ());
+      for (Bucket::const_iterator i = m_top.begin (); i != m_top.end (); i++)
+        {
+          rung->buckets[GetBucket (*rung, i->key.m_ts)].push_back (*i);
+        }
+      rung->count = m_top.size ();
+      m_top.clear ();
+      m_topStart = rung->start + rung->nBuckets * rung->width;
+    }
+  m_topMin = ~(uint64_t)0;
+  m_topMax = 0;
+}
+
+void
+LadderScheduler::SpawnFromBucket (Rung *rung)
+{
+  Bucket &bucket = rung->buckets[rung->current];
+  uint64_t start = GetCurrentStart (*rung);
+  NS_LOG_FUNCTION (this << start << bucket.size ());
+  Rung *child = CreateRung (start, start + rung->width, bucket.size ());
+  for (Bucket::const_iterator i = bucket.begin (); i != bucket.end (); i++)
+    {
+      child->buckets[GetBucket (*child, i->key.m_ts)].push_back (*i);
+    }
+  child->count = bucket.size ();
+  rung->count -= bucket.size ();
+  rung->current++;
+  bucket.clear ();
+}
+
+void
+LadderScheduler::SpawnFromBottom (void)
+{
+  NS_LOG_FUNCTION (this << m_bottom.size ());
+  uint64_t end = m_nRungs > 0 ? GetCurrentStart (m_rungs[m_nRungs - 1]) : m_topStart;
+  Rung *rung = CreateRung (m_bottom.back ().key.m_ts, end, m_bottom.size ());
+  for (Bucket::const_iterator i = m_bottom.begin (); i != m_bottom.end (); i++)
+    {
+      rung->buckets[GetBucket (*rung, i->key.m_ts)].push_back (*i);
+    }
+  rung->count = m_bottom.size ();
+  m_bottom.clear ();
+}
+
+void
+LadderScheduler::RefillBottom (void)
+{
+  while (m_bottom.empty ())
+    {
+      if (m_nRungs == 0)
+        {
+          if (m_top.empty ())
+            {
+              return;
+            }
+          SpawnFromTop ();
+          continue;
+        }
+      Rung *rung = &m_rungs[m_nRungs - 1];
+      if (rung->count == 0)
+        {
+          m_nRungs--;
+          continue;
+        }
+      while (rung->buckets[rung->current].empty ())
+        {
+          rung->current++;
+        }
+      Bucket &bucket = rung->buckets[rung->current];
+      if (bucket.size () > THRESHOLD && rung->width > 1 && m_nRungs < MAX_RUNGS)
+        {
+          SpawnFromBucket (rung);
+        }
+      else
+        {
+          rung->count -= bucket.size ();
+          rung->current++;
+          MoveToBottom (bucket);
+        }
+    }
+}
+
+void
+LadderScheduler::InsertInBottom (const Event &ev)
+{
+  Bucket::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, IsLater);
+  m_bottom.insert (i, ev);
+  if (m_bottom.size () > BOTTOM_THRESHOLD
+      && m_nRungs < MAX_RUNGS
+      && m_bottom.front ().key.m_ts != m_bottom.back ().key.m_ts)
+    {
+      SpawnFromBottom ();
+      RefillBottom ();
+    }
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+  if (ts >= m_topStart)
+    {
+      m_top.push_back (ev);
+      m_topMin = std::min (m_topMin, ts);
+      m_topMax = std::max (m_topMax, ts);
+    }
+  else
+    {
+      uint32_t i;
+      for (i = 0; i < m_nRungs; i++)
+        {
+          Rung &rung = m_rungs[i];
+          if (ts >= GetCurrentStart (rung))
+            {
+              rung.buckets[GetBucket (rung, ts)].push_back (ev);
+              rung.count++;
+              break;
+            }
+        }
+      if (i == m_nRungs)
+        {
+          InsertInBottom (ev);
+        }
+    }
+  if (m_bottom.empty ())
+    {
+      RefillBottom ();
+    }
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  // the bottom is refilled as soon as it becomes empty.
+  return m_bottom.empty ();
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  return m_bottom.back ();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  Event ev = m_bottom.back ();
+  m_bottom.pop_back ();
+  if (m_bottom.empty ())
+    {
+      RefillBottom ();
+    }
+  NS_LOG_DEBUG (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  return ev;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+  Bucket *bucket = 0;
+  if (ts >= m_topStart)
+    {
+      bucket = &m_top;
+    }
+  else
+    {
+      for (uint32_t i = 0; i < m_nRungs; i++)
+        {
+          Rung &rung = m_rungs[i];
+          if (ts >= GetCurrentStart (rung))
+            {
+              bucket = &rung.buckets[GetBucket (rung, ts)];
+              rung.count--;
+              break;
+            }
+        }
+    }
+  if (bucket != 0)
+    {
+      // buckets are not sorted.
+      for (Bucket::iterator i = bucket->begin (); i != bucket->end (); i++)
+        {
+          if (i->key.m_uid == ev.key.m_uid)
+            {
+              NS_ASSERT (ev.impl == i->impl);
+              *i = bucket->back ();
+              bucket->pop_back ();
+              return;
+            }
+        }
+      NS_ASSERT (false);
+    }
+  else
+    {
+      Bucket::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, IsLater);
+      NS_ASSERT (i != m_bottom.end () && i->key.m_uid == ev.key.m_uid);
+      m_bottom.erase (i);
+      if (m_bottom.empty ())
+        {
+          RefillBottom ();
+        }
+    }
+}
+
+} // namespace ns3
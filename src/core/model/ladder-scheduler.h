@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler is an implementation of the algorithm published
+ * in 2005 in "Ladder Queue: An O(1) Priority Queue Structure for
+ * Large-Scale Discrete Event Simulation" by Wai Teng Tang, Rick Siow
+ * Mong Goh and Ian Li-Jin Thng. Events are stored in three tiers:
+ *  - the top: an unsorted list of all the events which are later than
+ *    any event stored in the ladder,
+ *  - the ladder: a set of rungs, each of which is an array of unsorted
+ *    buckets. The buckets of a rung are narrower than the bucket of
+ *    the rung above from which they were created,
+ *  - the bottom: a small sorted list of the earliest events.
+ *
+ * Events are only sorted once they reach the bottom, in small sets,
+ * so that the amortized cost of Insert and RemoveNext does not depend
+ * on the number of pending events, whatever their distribution. Unlike
+ * the CalendarScheduler, the ladder never needs to be resized: buckets
+ * which hold too many events are spread over a new rung when they are
+ * about to be dequeued.
+ *
+ * Remove needs to look for the event in the tier which holds it: this
+ * is a linear search if the event is still in the top.
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  LadderScheduler ();
+  virtual ~LadderScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+
+private:
+  typedef std::vector<Scheduler::Event> Bucket;
+  struct Rung
+  {
+    std::vector<Bucket> buckets;
+    uint32_t nBuckets;
+    // timestamp of the start of the first bucket
+    uint64_t start;
+    uint64_t width;
+    // index of the first bucket which may contain events
+    uint32_t current;
+    uint32_t count;
+  };
+  enum {
+    // largest number of events which is sorted into the bottom
+    THRESHOLD = 50,
+    // largest number of events which can accumulate in the bottom
+    // before it is spread over a new rung.
+    BOTTOM_THRESHOLD = 8 * THRESHOLD,
+    MAX_RUNGS = 8,
+    MAX_BUCKETS = 65536
+  };
+
+  uint64_t GetCurrentStart (const Rung &rung) const;
+  uint32_t GetBucket (const Rung &rung, uint64_t ts) const;
+  Rung *CreateRung (uint64_t start, uint64_t end, uint32_t nEvents);
+  void InsertInBottom (const Event &ev);
+  void SpawnFromTop (void);
+  void SpawnFromBottom (void);
+  void SpawnFromBucket (Rung *rung);
+  void MoveToBottom (Bucket &bucket);
+  void RefillBottom (void);
+
+  Bucket m_top;
+  uint64_t m_topMin;
+  uint64_t m_topMax;
+  // all events earlier than this timestamp are stored
+  // in the ladder or in the bottom.
+  uint64_t m_topStart;
+  // m_rungs[0] is the top-most rung, m_rungs[m_nRungs-1] the
+  // lowest rung. Unused rungs are kept to recycle their buckets.
+  std::vector<Rung> m_rungs;
+  uint32_t m_nRungs;
+  // sorted in decreasing order so that the earliest event is last.
+  Bucket m_bottom;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
@@ -59,6 +59,19 @@ ListScheduler::Insert (const Event &ev)
     }
   m_events.push_back (ev);
 }
+static bool
+EventLess (const Scheduler::Event &a, const Scheduler::Event &b)
+{
+  return a.key < b.key;
+}
+void
+ListScheduler::InsertBatch (const std::vector<Event> &events)
+{
+  // sort the new events and walk the list only once to insert them.
+  Events batch (events.begin (), events.end ());
+  batch.sort (EventLess);
+  m_events.merge (batch, EventLess);
+}
 bool
 ListScheduler::IsEmpty (void) const
 {
@@ -93,4 +106,22 @@ ListScheduler::Remove (const Event &ev)
   NS_ASSERT (false);
 }
 
+void
+ListScheduler::RemoveCancelled (std::vector<Event> &removed)
+{
+  EventsI i = m_events.begin ();
+  while (i != m_events.end ())
+    {
+      if (i->impl->IsCancelled ())
+        {
+          removed.push_back (*i);
+          i = m_events.erase (i);
+        }
+      else
+        {
+          i++;
+        }
+    }
+}
+
 } // namespace ns3
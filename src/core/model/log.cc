@@ -32,6 +32,14 @@
 #include <stdlib.h>
 #endif
 
+#ifdef HAVE_PTHREAD_H
+#include <string>
+#include <streambuf>
+#include <unistd.h>
+#include "system-thread.h"
+#include "fatal-impl.h"
+#endif
+
 namespace ns3 {
 
 LogTimePrinter g_logTimePrinter = 0;
@@ -76,6 +84,10 @@ PrintList::PrintList ()
           exit (0);
           break;
         }
+      if (tmp == "async")
+        {
+          LogEnableAsync ();
+        }
       cur = next + 1;
     }
 #endif  
@@ -222,13 +234,6 @@ LogComponent::EnvVarCheck (char const * name)
 }
 
 
-bool 
-LogComponent::IsEnabled (enum LogLevel level) const
-{
-  //  LogComponentEnableEnvVar ();
-  return (level & m_levels) ? 1 : 0;
-}
-
 bool
 LogComponent::IsNoneEnabled (void) const
 {
@@ -374,6 +379,450 @@ LogNodePrinter LogGetNodePrinter(void)
   return g_logNodePrinter;
 }
 
+#ifdef HAVE_PTHREAD_H
+
+/**
+ * A bounded queue of formatted log messages, which any thread can
+ * push to without taking a lock, and which the LogWriter thread pops
+ * from. Each slot carries a sequence number which tells whether it
+ * is free for the push at this position, or filled for the pop at
+ * this position. The strings are swapped in and out of the slots so
+ * that their storage is recycled.
+ */
+class LogQueue
+{
+public:
+  LogQueue ();
+  /**
+   * Move the content of \a line in the queue, and wait while the
+   * queue is full. \a line is left with some unspecified content.
+   * \returns the number of messages pushed so far, this one included.
+   */
+  uint32_t Push (std::string &line);
+  /**
+   * \returns false if the queue is empty, or move the next message in
+   * \a line and return true.
+   */
+  bool Pop (std::string &line);
+private:
+  enum {
+    SIZE = 4096
+  };
+  struct Slot
+  {
+    volatile uint32_t sequence;
+    std::string line;
+  };
+  Slot m_slots[SIZE];
+  volatile uint32_t m_head;
+  uint32_t m_tail;
+};
+
+LogQueue::LogQueue ()
+  : m_head (0),
+    m_tail (0)
+{
+  for (uint32_t i = 0; i < SIZE; i++)
+    {
+      m_slots[i].sequence = i;
+    }
+}
+
+uint32_t
+LogQueue::Push (std::string &line)
+{
+  while (true)
+    {
+      uint32_t head = m_head;
+      Slot *slot = &m_slots[head % SIZE];
+      int32_t delta = slot->sequence - head;
+      if (delta == 0)
+        {
+          if (__sync_bool_compare_and_swap (&m_head, head, head + 1))
+            {
+              slot->line.swap (line);
+              __sync_synchronize ();
+              slot->sequence = head + 1;
+              return head + 1;
+            }
+        }
+      else if (delta < 0)
+        {
+          // the writer did not pop this slot yet: the queue is full.
+          usleep (100);
+        }
+    }
+}
+
+bool
+LogQueue::Pop (std::string &line)
+{
+  Slot *slot = &m_slots[m_tail % SIZE];
+  if (slot->sequence != m_tail + 1)
+    {
+      return false;
+    }
+  __sync_synchronize ();
+  slot->line.swap (line);
+  __sync_synchronize ();
+  slot->sequence = m_tail + SIZE;
+  m_tail++;
+  return true;
+}
+
+/**
+ * The per-thread buffer in which the NS_LOG macros format a message
+ * when the messages are written asynchronously.
+ */
+class LogLineBuffer : public std::streambuf
+{
+public:
+  std::string m_line;
+protected:
+  virtual int_type overflow (int_type c);
+  virtual std::streamsize xsputn (const char *s, std::streamsize n);
+};
+
+LogLineBuffer::int_type
+LogLineBuffer::overflow (int_type c)
+{
+  if (c != traits_type::eof ())
+    {
+      m_line.push_back (traits_type::to_char_type (c));
+    }
+  return traits_type::not_eof (c);
+}
+
+std::streamsize
+LogLineBuffer::xsputn (const char *s, std::streamsize n)
+{
+  m_line.append (s, n);
+  return n;
+}
+
+struct LogLine
+{
+  LogLine ();
+  LogLineBuffer buffer;
+  std::ostream stream;
+};
+
+LogLine::LogLine ()
+  : stream (&buffer)
+{}
+
+/**
+ * Flushing this buffer waits, for a bounded time, for the queued log
+ * messages to be written, so that FatalImpl::FlushStreams writes them
+ * out before the program stops.
+ */
+class LogFlushBuffer : public std::streambuf
+{
+protected:
+  virtual int sync (void);
+};
+
+/**
+ * The background thread which writes the queued log messages.
+ */
+class LogWriter
+{
+public:
+  LogWriter ();
+  ~LogWriter ();
+  void Enable (void);
+  void Disable (void);
+  /**
+   * \param timeout the longest time to wait, in microseconds, or zero
+   *        to wait as long as needed.
+   */
+  void Flush (uint32_t timeout);
+  /**
+   * \returns false if the asynchronous logging has been disabled in
+   *          the meantime: the caller must write the message itself.
+   */
+  bool Write (std::string &line);
+private:
+  void Run (void);
+
+  LogQueue m_queue;
+  Ptr<SystemThread> m_thread;
+  LogFlushBuffer m_flushBuffer;
+  std::ostream m_flushStream;
+  volatile bool m_starting;
+  volatile bool m_stop;
+  volatile bool m_destroyed;
+  // the number of threads in Write.
+  volatile uint32_t m_writers;
+  volatile uint32_t m_pushed;
+  volatile uint32_t m_written;
+};
+
+// how long the flush done by a fatal error waits for the writer thread.
+static const uint32_t FATAL_FLUSH_TIMEOUT = 1000000;
+
+static volatile bool g_logAsync = false;
+// true while LogDisableAsync writes out the queued messages.
+static volatile bool g_logDisabling = false;
+static __thread LogLine *g_logLine = 0;
+static __thread bool g_logWriterThread = false;
+
+static LogWriter *
+GetLogWriter (void)
+{
+  static LogWriter writer;
+  return &writer;
+}
+
+int
+LogFlushBuffer::sync (void)
+{
+  // the writer thread may be the one which stops the program, or be
+  // stuck: do not wait for it forever.
+  GetLogWriter ()->Flush (FATAL_FLUSH_TIMEOUT);
+  return 0;
+}
+
+LogWriter::LogWriter ()
+  : m_thread (0),
+    m_flushStream (&m_flushBuffer),
+    m_starting (false),
+    m_stop (false),
+    m_destroyed (false),
+    m_writers (0),
+    m_pushed (0),
+    m_written (0)
+{}
+
+LogWriter::~LogWriter ()
+{
+  Disable ();
+  // the destructors which run after this one may still log, and
+  // must not start the thread again.
+  m_destroyed = true;
+}
+
+void
+LogWriter::Enable (void)
+{
+  if (!g_logAsync && !m_destroyed)
+    {
+      FatalImpl::RegisterStream (&m_flushStream);
+      g_logAsync = true;
+    }
+}
+
+void
+LogWriter::Disable (void)
+{
+  if (!g_logAsync)
+    {
+      return;
+    }
+  g_logDisabling = true;
+  __sync_synchronize ();
+  g_logAsync = false;
+  FatalImpl::UnregisterStream (&m_flushStream);
+  // the threads which entered Write before they could see the flag
+  // push their message: wait for them. The next ones write theirs
+  // themselves, once the queued messages are written.
+  __sync_synchronize ();
+  while (m_writers != 0)
+    {
+      usleep (100);
+    }
+  if (m_thread != 0)
+    {
+      m_stop = true;
+      m_thread->Join ();
+      m_thread = 0;
+      m_starting = false;
+      m_stop = false;
+    }
+  // write the messages pushed while the thread was stopping.
+  std::string line;
+  while (m_queue.Pop (line))
+    {
+      std::clog << line;
+    }
+  std::clog.flush ();
+  m_written = m_pushed;
+  __sync_synchronize ();
+  g_logDisabling = false;
+}
+
+void
+LogWriter::Flush (uint32_t timeout)
+{
+  if (g_logWriterThread)
+    {
+      // it would wait for itself.
+      return;
+    }
+  uint32_t pushed = m_pushed;
+  uint32_t waited = 0;
+  while (m_thread != 0 && (int32_t)(m_written - pushed) < 0
+         && (timeout == 0 || waited < timeout))
+    {
+      usleep (100);
+      waited += 100;
+    }
+}
+
+bool
+LogWriter::Write (std::string &line)
+{
+  __sync_fetch_and_add (&m_writers, 1);
+  if (!g_logAsync)
+    {
+      __sync_fetch_and_sub (&m_writers, 1);
+      while (g_logDisabling)
+        {
+          usleep (100);
+        }
+      return false;
+    }
+  // the thread is started by the first message. The messages
+  // logged while it is created, by this or another thread, are only
+  // queued. A lock would log messages too.
+  if (m_thread == 0 && __sync_bool_compare_and_swap (&m_starting, false, true))
+    {
+      Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&LogWriter::Run, this));
+      thread->Start ();
+      m_thread = thread;
+    }
+  uint32_t pushed = m_queue.Push (line);
+  // m_pushed only grows, even when several threads race here.
+  uint32_t current = m_pushed;
+  while ((int32_t)(pushed - current) > 0
+         && !__sync_bool_compare_and_swap (&m_pushed, current, pushed))
+    {
+      current = m_pushed;
+    }
+  __sync_fetch_and_sub (&m_writers, 1);
+  return true;
+}
+
+void
+LogWriter::Run (void)
+{
+  g_logWriterThread = true;
+  std::string batch;
+  std::string line;
+  uint32_t popped = m_written;
+  while (true)
+    {
+      while (batch.size () < 65536 && m_queue.Pop (line))
+        {
+          batch.append (line);
+          popped++;
+        }
+      if (!batch.empty ())
+        {
+          std::clog.write (batch.data (), batch.size ());
+          std::clog.flush ();
+          batch.clear ();
+          __sync_synchronize ();
+          m_written = popped;
+          continue;
+        }
+      if (m_stop)
+        {
+          break;
+        }
+      usleep (1000);
+    }
+}
+
+void
+LogEnableAsync (void)
+{
+  GetLogWriter ()->Enable ();
+}
+
+void
+LogDisableAsync (void)
+{
+  GetLogWriter ()->Disable ();
+}
+
+void
+LogFlush (void)
+{
+  if (g_logAsync)
+    {
+      GetLogWriter ()->Flush (0);
+    }
+}
+
+std::ostream &
+LogStream (void)
+{
+  // keep formatting in the buffer of the thread while the queued
+  // messages are written out, and until the end of the current
+  // message, so that it is written after them, and whole.
+  if (g_logAsync || g_logDisabling
+      || (g_logLine != 0 && !g_logLine->buffer.m_line.empty ()))
+    {
+      if (g_logLine == 0)
+        {
+          // kept until the end of the program, one per logging thread.
+          g_logLine = new LogLine ();
+        }
+      return g_logLine->stream;
+    }
+  return std::clog;
+}
+
+void
+LogEndLine (void)
+{
+  if (g_logLine == 0 || g_logLine->buffer.m_line.empty ())
+    {
+      return;
+    }
+  // take the message out of the buffer first: writing it may log
+  // other messages.
+  std::string line;
+  line.swap (g_logLine->buffer.m_line);
+  if ((!g_logAsync && !g_logDisabling) || !GetLogWriter ()->Write (line))
+    {
+      std::clog << line;
+    }
+  line.clear ();
+  if (g_logLine->buffer.m_line.empty ())
+    {
+      // keep the storage of the string for the next message.
+      g_logLine->buffer.m_line.swap (line);
+    }
+}
+
+#else /* HAVE_PTHREAD_H */
+
+void
+LogEnableAsync (void)
+{}
+
+void
+LogDisableAsync (void)
+{}
+
+void
+LogFlush (void)
+{}
+
+std::ostream &
+LogStream (void)
+{
+  return std::clog;
+}
+
+void
+LogEndLine (void)
+{}
+
+#endif /* HAVE_PTHREAD_H */
+
 
 ParameterLogger::ParameterLogger (std::ostream &os)
   : m_itemNumber (0),
@@ -148,7 +148,40 @@ void LogComponentDisableAll (enum LogLevel level);
  * environment variable.
  */
 #define NS_LOG_COMPONENT_DEFINE(name)                           \
-  static ns3::LogComponent g_log = ns3::LogComponent (name)
+  NS_LOG_COMPONENT_DEFINE_MASK (name, NS_LOG_COMPILE_MASK)
+
+/**
+ * \ingroup logging
+ * \param name a string
+ * \param mask the log levels which can be enabled at runtime
+ *
+ * Define a Log component like NS_LOG_COMPONENT_DEFINE, but compile
+ * only the NS_LOG statements of the log levels in \a mask. The
+ * others are removed by the compiler, and they cannot be enabled
+ * with ns3::LogComponentEnable or the NS_LOG environment variable.
+ * For example:
+ * \code
+ * NS_LOG_COMPONENT_DEFINE_MASK ("MyHotLoop", ns3::LOG_LEVEL_WARN);
+ * \endcode
+ */
+#define NS_LOG_COMPONENT_DEFINE_MASK(name, mask)                \
+  static ns3::LogComponent g_log = ns3::LogComponent (name);    \
+  static const int32_t g_logMask = (mask)
+
+/**
+ * \ingroup logging
+ *
+ * The log levels compiled in the components defined with
+ * NS_LOG_COMPONENT_DEFINE. Define it on the compiler command line
+ * (e.g. -DNS_LOG_COMPILE_MASK=ns3::LOG_LEVEL_INFO) to remove the
+ * other log levels from the whole build.
+ */
+#ifndef NS_LOG_COMPILE_MASK
+#define NS_LOG_COMPILE_MASK ns3::LOG_ALL
+#endif /* NS_LOG_COMPILE_MASK */
+
+#define NS_LOG_IS_ENABLED(level)                                \
+  (((level) & g_logMask) && g_log.IsEnabled (level))
 
 #define NS_LOG_APPEND_TIME_PREFIX                               \
   if (g_log.IsEnabled (ns3::LOG_PREFIX_TIME))                   \
@@ -156,8 +189,8 @@ void LogComponentDisableAll (enum LogLevel level);
       ns3::LogTimePrinter printer = ns3::LogGetTimePrinter ();  \
       if (printer != 0)                                         \
         {                                                       \
-          (*printer) (std::clog);                               \
-          std::clog << " ";                                     \
+          (*printer) (ns3::LogStream ());                       \
+          ns3::LogStream () << " ";                             \
         }                                                       \
     }
 
@@ -167,15 +200,15 @@ void LogComponentDisableAll (enum LogLevel level);
       ns3::LogNodePrinter printer = ns3::LogGetNodePrinter ();  \
       if (printer != 0)                                         \
         {                                                       \
-          (*printer) (std::clog);                               \
-          std::clog << " ";                                     \
+          (*printer) (ns3::LogStream ());                       \
+          ns3::LogStream () << " ";                             \
         }                                                       \
     }
 
 #define NS_LOG_APPEND_FUNC_PREFIX                               \
   if (g_log.IsEnabled (ns3::LOG_PREFIX_FUNC))                   \
     {                                                           \
-      std::clog << g_log.Name () << ":" <<                      \
+      ns3::LogStream () << g_log.Name () << ":" <<              \
         __FUNCTION__ << "(): ";                                 \
     }                                                           \
 
@@ -201,13 +234,14 @@ void LogComponentDisableAll (enum LogLevel level);
 #define NS_LOG(level, msg)                                      \
   do                                                            \
     {                                                           \
-      if (g_log.IsEnabled (level))                              \
+      if (NS_LOG_IS_ENABLED (level))                            \
         {                                                       \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
           NS_LOG_APPEND_CONTEXT;                                \
           NS_LOG_APPEND_FUNC_PREFIX;                            \
-          std::clog << msg << std::endl;                        \
+          ns3::LogStream () << msg << std::endl;                \
+          ns3::LogEndLine ();                                   \
         }                                                       \
     }                                                           \
   while (false)
@@ -256,13 +290,14 @@ void LogComponentDisableAll (enum LogLevel level);
 #define NS_LOG_FUNCTION_NOARGS()                                \
   do                                                            \
     {                                                           \
-      if (g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
+      if (NS_LOG_IS_ENABLED (ns3::LOG_FUNCTION))                \
         {                                                       \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
           NS_LOG_APPEND_CONTEXT;                                \
-          std::clog << g_log.Name () << ":"                     \
-                    << __FUNCTION__ << "()" << std::endl;       \
+          ns3::LogStream () << g_log.Name () << ":"             \
+                            << __FUNCTION__ << "()" << std::endl; \
+          ns3::LogEndLine ();                                   \
         }                                                       \
     }                                                           \
   while (false)
@@ -287,15 +322,16 @@ void LogComponentDisableAll (enum LogLevel level);
 #define NS_LOG_FUNCTION(parameters)                             \
   do                                                            \
     {                                                           \
-      if (g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
+      if (NS_LOG_IS_ENABLED (ns3::LOG_FUNCTION))                \
         {                                                       \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
           NS_LOG_APPEND_CONTEXT;                                \
-          std::clog << g_log.Name () << ":"                     \
-                    << __FUNCTION__ << "(";                     \
-          ns3::ParameterLogger (std::clog)  << parameters;      \
-          std::clog << ")" << std::endl;                        \
+          ns3::LogStream () << g_log.Name () << ":"             \
+                            << __FUNCTION__ << "(";             \
+          ns3::ParameterLogger (ns3::LogStream ()) << parameters; \
+          ns3::LogStream () << ")" << std::endl;                \
+          ns3::LogEndLine ();                                   \
         }                                                       \
     }                                                           \
   while (false)
@@ -316,11 +352,12 @@ void LogComponentDisableAll (enum LogLevel level);
  *
  * Output the requested message unconditionaly.
  */
-#define NS_LOG_UNCOND(msg)              \
-  do                                    \
-    {                                   \
-      std::clog << msg << std::endl;    \
-    }                                   \
+#define NS_LOG_UNCOND(msg)                      \
+  do                                            \
+    {                                           \
+      ns3::LogStream () << msg << std::endl;    \
+      ns3::LogEndLine ();                       \
+    }                                           \
   while (false)
 
 namespace ns3 {
@@ -344,6 +381,54 @@ LogTimePrinter LogGetTimePrinter(void);
 void LogSetNodePrinter (LogNodePrinter);
 LogNodePrinter LogGetNodePrinter(void);
 
+/**
+ * \ingroup logging
+ *
+ * Write the log messages from a background thread: the thread which
+ * logs a message only formats it into a buffer and queues it, and
+ * the background thread writes it to std::clog. The messages of each
+ * thread stay in order, and a fatal error writes out the queued
+ * messages before the program stops.
+ *
+ * Same as adding "async" to the NS_LOG environment variable, as in
+ * NS_LOG='async:Component1=info'. Without threads support, the
+ * messages are still written synchronously. This function and
+ * ns3::LogDisableAsync must be called from the main thread.
+ */
+void LogEnableAsync (void);
+/**
+ * \ingroup logging
+ *
+ * Write the queued messages, stop the background thread started by
+ * ns3::LogEnableAsync, and write the next messages synchronously.
+ * This is done automatically at the end of the program.
+ */
+void LogDisableAsync (void);
+/**
+ * \ingroup logging
+ *
+ * Wait until the background thread has written all the log messages
+ * queued so far. Does nothing if ns3::LogEnableAsync was not called.
+ */
+void LogFlush (void);
+
+/**
+ * \internal
+ * \returns the stream in which the NS_LOG macros format a message:
+ * std::clog, or a buffer of the calling thread once
+ * ns3::LogEnableAsync was called.
+ *
+ * The NS_LOG_APPEND_CONTEXT macros must write to this stream.
+ */
+std::ostream &LogStream (void);
+/**
+ * \internal
+ *
+ * Called by the NS_LOG macros after each message, to queue the
+ * buffer returned by ns3::LogStream.
+ */
+void LogEndLine (void);
+
 
 class LogComponent {
 public:
@@ -359,6 +444,12 @@ private:
   char const *m_name;
 };
 
+inline bool
+LogComponent::IsEnabled (enum LogLevel level) const
+{
+  return (level & m_levels) ? 1 : 0;
+}
+
 class ParameterLogger : public std::ostream
 {
   int m_itemNumber;
@@ -388,6 +479,7 @@ public:
 #else /* LOG_ENABLE */
 
 #define NS_LOG_COMPONENT_DEFINE(component)
+#define NS_LOG_COMPONENT_DEFINE_MASK(component, mask)
 #define NS_LOG(level, msg)
 #define NS_LOG_ERROR(msg)
 #define NS_LOG_WARN(msg)
@@ -406,6 +498,10 @@ public:
 #define LogSetNodePrinter(printer)
 #define LogGetNodePrinter
 
+#define LogEnableAsync()
+#define LogDisableAsync()
+#define LogFlush()
+
 #endif /* LOG_ENABLE */
 
 #endif // __LOG_H__
@@ -21,6 +21,8 @@
 #define TIME_H
 
 #include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+#include "ns3/core-config.h"
 #include "ns3/attribute.h"
 #include "ns3/attribute-helper.h"
 #include <stdint.h>
@@ -30,6 +32,17 @@
 
 namespace ns3 {
 
+#ifdef USE_INT64_TIME
+// internal function not publicly documented
+inline void TimeStepCheckRange (double steps)
+{
+  // written so that a NaN fails too
+  if (!(steps >= -9223372036854775808.0 && steps < 9223372036854775808.0))
+    {
+      NS_FATAL_ERROR ("Time overflow: " << steps << " time steps");
+    }
+}
+#endif /* USE_INT64_TIME */
 
 /**
  * \ingroup simulator
@@ -146,6 +159,20 @@ namespace ns3 {
  * use one of these models (and it's likely), it's going to be hard to change
  * the global simulation resolution in a way which gives reasonable results. This
  * issue has been filed as bug 954 in the ns-3 bugzilla installation.
+ *
+ * When ns-3 is configured with --enable-int64-time, a Time object
+ * holds a plain 64-bit integer number of time steps rather than a
+ * HighPrecision value: additions, substractions and comparisons, which
+ * are what the simulator spends its time on, are then simple integer
+ * operations. The HighPrecision type is only used to convert a time
+ * from and to other units and to multiply or divide it by a Scalar,
+ * and the fractional part of a time step is always truncated. An
+ * addition, a substraction, a multiplication, a division or a
+ * conversion from another unit whose result does not fit in 64 bits
+ * is a fatal error, in optimized builds too. The conversions to other
+ * units (GetMilliSeconds, ToInteger, etc.) are not checked.
+ *
+ * In both representations, the division of two times returns a Scalar.
  */
 class Time
 {
@@ -175,9 +202,17 @@ public:
   inline Time(const Time &o)
     : m_data (o.m_data)
   {}
+#ifdef USE_INT64_TIME
+  explicit inline Time (const HighPrecision &data)
+    : m_data (data.GetInteger ())
+  {
+    TimeStepCheckRange (data.GetDouble ());
+  }
+#else /* USE_INT64_TIME */
   explicit inline Time (const HighPrecision &data)
     : m_data (data)
   {}
+#endif /* USE_INT64_TIME */
 
   /**
    * \brief String constructor
@@ -202,40 +237,44 @@ public:
    */
   inline bool IsZero (void) const
   {
-    return m_data.Compare (HighPrecision::Zero ()) == 0;
+    return Compare (Time ()) == 0;
   }
   /**
    * \return true if the time is negative or zero, false otherwise.
    */
   inline bool IsNegative (void) const
   {
-    return m_data.Compare (HighPrecision::Zero ()) <= 0;
+    return Compare (Time ()) <= 0;
   }
   /**
    * \return true if the time is positive or zero, false otherwise.
    */
   inline bool IsPositive (void) const
   {
-    return m_data.Compare (HighPrecision::Zero ()) >= 0;
+    return Compare (Time ()) >= 0;
   }
   /**
    * \return true if the time is strictly negative, false otherwise.
    */
   inline bool IsStrictlyNegative (void) const
   {
-    return m_data.Compare (HighPrecision::Zero ()) < 0;
+    return Compare (Time ()) < 0;
   }
   /**
    * \return true if the time is strictly positive, false otherwise.
    */
   inline bool IsStrictlyPositive (void) const
   {
-    return m_data.Compare (HighPrecision::Zero ()) > 0;
+    return Compare (Time ()) > 0;
   }
 
   inline int Compare (const Time &o) const
   {
+#ifdef USE_INT64_TIME
+    return (m_data < o.m_data) ? -1 : (m_data == o.m_data) ? 0 : 1;
+#else /* USE_INT64_TIME */
     return m_data.Compare (o.m_data);
+#endif /* USE_INT64_TIME */
   }
 
   /**
@@ -245,6 +284,12 @@ public:
    * \return the ns3::HighPrecision object which holds the value
    *         stored in this instance of Time type.
    */
+#ifdef USE_INT64_TIME
+  inline HighPrecision GetHighPrecision (void) const
+  {
+    return HighPrecision (m_data, false);
+  }
+#else /* USE_INT64_TIME */
   inline HighPrecision const &GetHighPrecision (void) const
   {
     return m_data;
@@ -253,6 +298,7 @@ public:
   {
     return &m_data;
   }
+#endif /* USE_INT64_TIME */
 
   /**
    * \returns an approximation in seconds of the time stored in this
@@ -309,8 +355,12 @@ public:
    */
   inline int64_t GetTimeStep (void) const
   {
+#ifdef USE_INT64_TIME
+    return m_data;
+#else /* USE_INT64_TIME */
     int64_t timeValue = m_data.GetInteger ();
     return timeValue;
+#endif /* USE_INT64_TIME */
   }
 
 
@@ -341,8 +391,17 @@ public:
     struct Information *info = PeekInformation (timeUnit);
     if (info->fromMul)
       {
+#ifdef USE_INT64_TIME
+        if (value > ((~(uint64_t)0) >> 1) / info->factor)
+          {
+            NS_FATAL_ERROR ("Time overflow: " << value << " * " << info->factor);
+          }
+        value *= info->factor;
+        return Time ((int64_t)value, false);
+#else /* USE_INT64_TIME */
         value *= info->factor;
         return Time (HighPrecision (value, false));
+#endif /* USE_INT64_TIME */
       }
     return From (HighPrecision (value, false), timeUnit);
   }
@@ -367,7 +426,7 @@ public:
   inline static uint64_t ToInteger (const Time &time, enum Unit timeUnit)
   {
     struct Information *info = PeekInformation (timeUnit);
-    uint64_t v = time.m_data.GetInteger ();
+    uint64_t v = time.GetTimeStep ();
     if (info->toMul)
       {
         v *= info->factor;
@@ -420,6 +479,11 @@ private:
     // DO NOT REMOVE this temporary variable. It's here
     // to work around a compiler bug in gcc 3.4
     HighPrecision tmp = from; 
+#ifdef USE_INT64_TIME
+    // the high precision product may wrap before it reaches Time (HighPrecision)
+    TimeStepCheckRange (info->fromMul ? from.GetDouble () * info->factor :
+                        from.GetDouble () / info->factor);
+#endif /* USE_INT64_TIME */
     if (info->fromMul)
       {
         tmp.Mul (info->timeFrom);
@@ -448,7 +512,15 @@ private:
   static struct Resolution GetNsResolution (void);
   static void SetResolution (enum Unit unit, struct Resolution *resolution);
 
+#ifdef USE_INT64_TIME
+  friend Time TimeStep (uint64_t ts);
+  explicit inline Time (int64_t ts, bool dummy)
+    : m_data (ts)
+  {}
+  int64_t m_data;
+#else /* USE_INT64_TIME */
   HighPrecision m_data;
+#endif /* USE_INT64_TIME */
 };
 
 inline bool
@@ -481,6 +553,58 @@ operator > (Time const &lhs, Time const &rhs)
 {
   return lhs.Compare (rhs) > 0;
 }
+#ifdef USE_INT64_TIME
+inline Time TimeStep (uint64_t ts);
+// internal functions not publicly documented
+inline int64_t TimeStepAdd (int64_t a, int64_t b)
+{
+  int64_t retval = (int64_t)((uint64_t)a + (uint64_t)b);
+  if (((a ^ retval) & (b ^ retval)) < 0)
+    {
+      NS_FATAL_ERROR ("Time overflow: " << a << "+" << b);
+    }
+  return retval;
+}
+inline int64_t TimeStepSub (int64_t a, int64_t b)
+{
+  int64_t retval = (int64_t)((uint64_t)a - (uint64_t)b);
+  if (((a ^ b) & (a ^ retval)) < 0)
+    {
+      NS_FATAL_ERROR ("Time overflow: " << a << "-" << b);
+    }
+  return retval;
+}
+inline Time operator + (Time const &lhs, Time const &rhs)
+{
+  return TimeStep (TimeStepAdd (lhs.GetTimeStep (), rhs.GetTimeStep ()));
+}
+inline Time operator - (Time const &lhs, Time const &rhs)
+{
+  return TimeStep (TimeStepSub (lhs.GetTimeStep (), rhs.GetTimeStep ()));
+}
+inline Time operator * (Time const &lhs, Time const &rhs)
+{
+  TimeStepCheckRange ((double)lhs.GetTimeStep () * rhs.GetTimeStep ());
+  HighPrecision retval = lhs.GetHighPrecision ();
+  retval.Mul (rhs.GetHighPrecision ());
+  return Time (retval);
+}
+inline Time &operator += (Time &lhs, Time const &rhs)
+{
+  lhs = lhs + rhs;
+  return lhs;
+}
+inline Time &operator -= (Time &lhs, Time const &rhs)
+{
+  lhs = lhs - rhs;
+  return lhs;
+}
+inline Time &operator *= (Time &lhs, Time const &rhs)
+{
+  lhs = lhs * rhs;
+  return lhs;
+}
+#else /* USE_INT64_TIME */
 inline Time operator + (Time const &lhs, Time const &rhs)
 {
   HighPrecision retval = lhs.GetHighPrecision ();
@@ -499,13 +623,6 @@ inline Time operator * (Time const &lhs, Time const &rhs)
   retval.Mul (rhs.GetHighPrecision ());
   return Time (retval);
 }
-inline Time operator / (Time const &lhs, Time const &rhs)
-{
-  NS_ASSERT (rhs.GetHighPrecision ().GetDouble () != 0);
-  HighPrecision retval = lhs.GetHighPrecision ();
-  retval.Div (rhs.GetHighPrecision ());
-  return Time (retval);
-}
 inline Time &operator += (Time &lhs, Time const &rhs)
 {
   HighPrecision *lhsv = lhs.PeekHighPrecision ();
@@ -530,6 +647,7 @@ inline Time &operator /= (Time &lhs, Time const &rhs)
   lhsv->Div (rhs.GetHighPrecision ());
   return lhs;
 }
+#endif /* USE_INT64_TIME */
 
 
 /**
@@ -540,7 +658,11 @@ inline Time &operator /= (Time &lhs, Time const &rhs)
  */
 inline Time Abs (Time const &time)
 {
+#ifdef USE_INT64_TIME
+  return time.IsStrictlyNegative () ? Time () - time : time;
+#else /* USE_INT64_TIME */
   return Time (Abs (time.GetHighPrecision ()));
+#endif /* USE_INT64_TIME */
 }
 /**
  * \anchor ns3-Time-Max
@@ -551,9 +673,13 @@ inline Time Abs (Time const &time)
  */
 inline Time Max (Time const &ta, Time const &tb)
 {
+#ifdef USE_INT64_TIME
+  return (ta < tb) ? tb : ta;
+#else /* USE_INT64_TIME */
   HighPrecision a = ta.GetHighPrecision ();
   HighPrecision b = tb.GetHighPrecision ();
   return Time (Max (a, b));
+#endif /* USE_INT64_TIME */
 }
 /**
  * \anchor ns3-Time-Min
@@ -564,9 +690,13 @@ inline Time Max (Time const &ta, Time const &tb)
  */
 inline Time Min (Time const &ta, Time const &tb)
 {
+#ifdef USE_INT64_TIME
+  return (tb < ta) ? tb : ta;
+#else /* USE_INT64_TIME */
   HighPrecision a = ta.GetHighPrecision ();
   HighPrecision b = tb.GetHighPrecision ();
   return Time (Min (a, b));
+#endif /* USE_INT64_TIME */
 }
 
 
@@ -662,7 +792,11 @@ inline Time FemtoSeconds (uint64_t fs)
 // internal function not publicly documented
 inline Time TimeStep (uint64_t ts)
 {
+#ifdef USE_INT64_TIME
+  return Time (ts, false);
+#else /* USE_INT64_TIME */
   return Time (HighPrecision (ts, false));
+#endif /* USE_INT64_TIME */
 }
 
 class Scalar
@@ -701,6 +835,70 @@ private:
   double m_v;
 };
 
+// the scaling of a time by a Scalar does not go through the conversion
+// of the Scalar to a Time, which would truncate it with integer times,
+// and the ratio of two times is a Scalar.
+inline Time operator * (Time const &lhs, Scalar const &rhs)
+{
+#ifdef USE_INT64_TIME
+  TimeStepCheckRange (lhs.GetTimeStep () * rhs.GetDouble ());
+#endif /* USE_INT64_TIME */
+  HighPrecision retval = lhs.GetHighPrecision ();
+  retval.Mul (HighPrecision (rhs.GetDouble ()));
+  return Time (retval);
+}
+inline Time operator * (Scalar const &lhs, Time const &rhs)
+{
+  return rhs * lhs;
+}
+inline Time operator / (Time const &lhs, Scalar const &rhs)
+{
+  NS_ASSERT (rhs.GetDouble () != 0);
+#ifdef USE_INT64_TIME
+  TimeStepCheckRange (lhs.GetTimeStep () / rhs.GetDouble ());
+#endif /* USE_INT64_TIME */
+  HighPrecision retval = lhs.GetHighPrecision ();
+  retval.Div (HighPrecision (rhs.GetDouble ()));
+  return Time (retval);
+}
+inline Scalar operator / (Time const &lhs, Time const &rhs)
+{
+  NS_ASSERT (rhs.GetHighPrecision ().GetDouble () != 0);
+  HighPrecision retval = lhs.GetHighPrecision ();
+  retval.Div (rhs.GetHighPrecision ());
+  return Scalar (retval.GetDouble ());
+}
+inline Scalar operator * (Scalar const &lhs, Scalar const &rhs)
+{
+  HighPrecision retval = HighPrecision (lhs.GetDouble ());
+  retval.Mul (HighPrecision (rhs.GetDouble ()));
+  return Scalar (retval.GetDouble ());
+}
+inline Scalar operator / (Scalar const &lhs, Scalar const &rhs)
+{
+  NS_ASSERT (rhs.GetDouble () != 0);
+  HighPrecision retval = HighPrecision (lhs.GetDouble ());
+  retval.Div (HighPrecision (rhs.GetDouble ()));
+  return Scalar (retval.GetDouble ());
+}
+inline Time &operator *= (Time &lhs, Scalar const &rhs)
+{
+  lhs = lhs * rhs;
+  return lhs;
+}
+inline Time &operator /= (Time &lhs, Scalar const &rhs)
+{
+  lhs = lhs / rhs;
+  return lhs;
+}
+#ifdef USE_INT64_TIME
+inline Time &operator /= (Time &lhs, Time const &rhs)
+{
+  lhs = Time (lhs / rhs);
+  return lhs;
+}
+#endif /* USE_INT64_TIME */
+
 typedef Time TimeInvert;
 typedef Time TimeSquare;
 
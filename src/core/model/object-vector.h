@@ -2,6 +2,7 @@
 #define OBJECT_VECTOR_H
 
 #include <vector>
+#include <iterator>
 #include "object.h"
 #include "ptr.h"
 #include "attribute.h"
@@ -123,6 +124,22 @@ public:
   virtual bool Get (const ObjectBase * object, AttributeValue &value) const;
   virtual bool HasGetter (void) const;
   virtual bool HasSetter (void) const;
+  /**
+   * \param object the object which holds the vector
+   * \param n the number of objects in the vector of object
+   * \returns false if object does not hold this vector
+   *
+   * Unlike Get, this method and the next one do not copy the
+   * whole vector.
+   */
+  bool GetN (const ObjectBase *object, uint32_t *n) const;
+  /**
+   * \param object the object which holds the vector: GetN
+   *        must have returned true for it.
+   * \param i the index of the requested object
+   * \returns the requested object
+   */
+  Ptr<Object> Get (const ObjectBase *object, uint32_t i) const;
 private:
   virtual bool DoGetN (const ObjectBase *object, uint32_t *n) const = 0;
   virtual Ptr<Object> DoGet (const ObjectBase *object, uint32_t i) const = 0;
@@ -145,20 +162,16 @@ MakeObjectVectorAccessor (U T::*memberVector)
     }
     virtual Ptr<Object> DoGet (const ObjectBase *object, uint32_t i) const {
       const T *obj = static_cast<const T *> (object);
-      typename U::const_iterator begin = (obj->*m_memberVector).begin ();
-      typename U::const_iterator end = (obj->*m_memberVector).end ();
-      uint32_t k = 0;
-      for (typename U::const_iterator j = begin; j != end; j++, k++)
-	{
-	  if (k == i)
-	    {
-	      return *j;
-	      break;
-	    }
-	}
-      NS_ASSERT (false);
-      // quiet compiler.
-      return 0;
+      if (i >= (obj->*m_memberVector).size ())
+        {
+          NS_ASSERT (false);
+          // quiet compiler.
+          return 0;
+        }
+      // constant time for the std::vector members
+      typename U::const_iterator j = (obj->*m_memberVector).begin ();
+      std::advance (j, i);
+      return *j;
     }
     U T::*m_memberVector;
   } *spec = new MemberStdContainer ();
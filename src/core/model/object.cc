@@ -84,10 +84,9 @@ Object::Object ()
   : m_tid (Object::GetTypeId ()),
     m_disposed (false),
     m_started (false),
-    m_aggregates ((struct Aggregates *)malloc (sizeof (struct Aggregates))),
+    m_aggregates (AllocateAggregates (1)),
     m_getObjectCount (0)
 {
-  m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
 }
 Object::~Object () 
@@ -105,6 +104,14 @@ Object::~Object ()
           m_aggregates->n--;
         }
     }
+  for (uint32_t i = 0; i < CACHE_SIZE; i++)
+    {
+      if (m_aggregates->cache[i].object == this)
+        {
+          m_aggregates->cache[i].tid = 0;
+          m_aggregates->cache[i].object = 0;
+        }
+    }
   // finally, if all objects have been removed from the list,
   // delete the aggregate list
   if (m_aggregates->n == 0)
@@ -117,12 +124,20 @@ Object::Object (const Object &o)
   : m_tid (o.m_tid),
     m_disposed (false),
     m_started (false),
-    m_aggregates ((struct Aggregates *)malloc (sizeof (struct Aggregates))),
+    m_aggregates (AllocateAggregates (1)),
     m_getObjectCount (0)
 {
-  m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
 }
+struct Object::Aggregates *
+Object::AllocateAggregates (uint32_t n)
+{
+  struct Aggregates *aggregates = 
+    (struct Aggregates *)malloc (sizeof (struct Aggregates)+(n-1)*sizeof(Object*));
+  memset (aggregates->cache, 0, sizeof (aggregates->cache));
+  aggregates->n = n;
+  return aggregates;
+}
 void
 Object::Construct (const AttributeList &attributes)
 {
@@ -134,17 +149,17 @@ Object::DoGetObject (TypeId tid) const
 {
   NS_ASSERT (CheckLoose ());
 
+  struct CacheEntry *entry = &m_aggregates->cache[tid.GetUid () % CACHE_SIZE];
+  if (entry->tid == tid.GetUid ())
+    {
+      return entry->object;
+    }
   uint32_t n = m_aggregates->n;
-  TypeId objectTid = Object::GetTypeId ();
   for (uint32_t i = 0; i < n; i++)
     {
       Object *current = m_aggregates->buffer[i];
       TypeId cur = current->GetInstanceTypeId ();
-      while (cur != tid && cur != objectTid)
-        {
-          cur = cur.GetParent ();
-        }
-      if (cur == tid)
+      if (cur == tid || cur.IsChildOf (tid))
         {
           // This is an attempt to 'cache' the result of this lookup.
           // the idea is that if we perform a lookup for a TypeId on this object,
@@ -156,7 +171,9 @@ Object::DoGetObject (TypeId tid) const
           current->m_getObjectCount++;
           // then, update the sort
           UpdateSortedArray (m_aggregates, i);
-          // finally, return the match
+          // finally, remember and return the match
+          entry->tid = tid.GetUid ();
+          entry->object = current;
           return const_cast<Object *> (current);
         }
     }
@@ -240,9 +257,7 @@ Object::AggregateObject (Ptr<Object> o)
   Object *other = PeekPointer (o);
   // first create the new aggregate buffer.
   uint32_t total = m_aggregates->n + other->m_aggregates->n;
-  struct Aggregates *aggregates = 
-    (struct Aggregates *)malloc (sizeof(struct Aggregates)+(total-1)*sizeof(Object*));
-  aggregates->n = total;
+  struct Aggregates *aggregates = AllocateAggregates (total);
 
   // copy our buffer to the new buffer
   memcpy (&aggregates->buffer[0], 
@@ -774,6 +789,105 @@ ObjectFactoryTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_NE (a->GetObject<DerivedA> (), 0, "Unexpectedly able to work around C++ type system");
 }
 
+// ===========================================================================
+// Test case to make sure that GetObject finds the right objects after the
+// aggregation changes, and that TypeId::IsChildOf follows the parents.
+// ===========================================================================
+class GetObjectCacheTestCase : public TestCase
+{
+public:
+  GetObjectCacheTestCase ();
+  virtual ~GetObjectCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+GetObjectCacheTestCase::GetObjectCacheTestCase ()
+  : TestCase ("Check GetObject after changes of the aggregation")
+{
+}
+
+GetObjectCacheTestCase::~GetObjectCacheTestCase ()
+{
+}
+
+void
+GetObjectCacheTestCase::DoRun (void)
+{
+  NS_TEST_ASSERT_MSG_EQ (DerivedA::GetTypeId ().IsChildOf (BaseA::GetTypeId ()), true, "DerivedA is a child of BaseA");
+  NS_TEST_ASSERT_MSG_EQ (DerivedA::GetTypeId ().IsChildOf (Object::GetTypeId ()), true, "DerivedA is a child of Object");
+  NS_TEST_ASSERT_MSG_EQ (BaseA::GetTypeId ().IsChildOf (DerivedA::GetTypeId ()), false, "BaseA is not a child of DerivedA");
+  NS_TEST_ASSERT_MSG_EQ (DerivedA::GetTypeId ().IsChildOf (DerivedA::GetTypeId ()), false, "DerivedA is not a child of itself");
+  NS_TEST_ASSERT_MSG_EQ (DerivedA::GetTypeId ().IsChildOf (BaseB::GetTypeId ()), false, "DerivedA is not a child of BaseB");
+
+  Ptr<DerivedA> derivedA = CreateObject<DerivedA> ();
+  Ptr<DerivedB> derivedB = CreateObject<DerivedB> ();
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseB> (), 0, "Unexpectedly found a BaseB before the aggregation");
+
+  derivedA->AggregateObject (derivedB);
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      // the second time, GetObject finds the objects in the cache
+      NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseB> (), derivedB, "Cannot GetObject (through derivedA) for BaseB Object");
+      NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<DerivedB> (), derivedB, "Cannot GetObject (through derivedA) for DerivedB Object");
+      NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<BaseA> (), derivedA, "Cannot GetObject (through derivedB) for BaseA Object");
+      NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<DerivedA> (), derivedA, "Cannot GetObject (through derivedB) for DerivedA Object");
+    }
+
+  //
+  // A new aggregation gets a new cache: the objects found before must still
+  // be found, and the new ones too.
+  //
+  Ptr<BaseA> baseA = CreateObject<BaseA> ();
+  Ptr<BaseB> baseB = CreateObject<BaseB> ();
+  baseA->AggregateObject (baseB);
+  NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<BaseB> (), baseB, "Cannot GetObject (through baseA) for BaseB Object");
+  NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<DerivedB> (), 0, "Unexpectedly found a DerivedB through baseA");
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseB> (), derivedB, "Lost BaseB (through derivedA) after another aggregation");
+}
+
+// ===========================================================================
+// Performance test case: repeated GetObject lookups on an aggregation, as
+// done on the nodes of a simulation. The test runner reports its duration.
+// ===========================================================================
+class GetObjectPerformanceTestCase : public TestCase
+{
+public:
+  GetObjectPerformanceTestCase ();
+  virtual ~GetObjectPerformanceTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+GetObjectPerformanceTestCase::GetObjectPerformanceTestCase ()
+  : TestCase ("Time 1000000 GetObject lookups on an aggregation")
+{
+}
+
+GetObjectPerformanceTestCase::~GetObjectPerformanceTestCase ()
+{
+}
+
+void
+GetObjectPerformanceTestCase::DoRun (void)
+{
+  Ptr<DerivedA> derivedA = CreateObject<DerivedA> ();
+  Ptr<DerivedB> derivedB = CreateObject<DerivedB> ();
+  derivedA->AggregateObject (derivedB);
+
+  uint32_t found = 0;
+  for (uint32_t i = 0; i < 250000; i++)
+    {
+      found += derivedA->GetObject<BaseB> () != 0;
+      found += derivedA->GetObject<DerivedB> () != 0;
+      found += derivedB->GetObject<BaseA> () != 0;
+      found += derivedB->GetObject<DerivedA> () != 0;
+    }
+  NS_TEST_ASSERT_MSG_EQ (found, 1000000, "GetObject failed to find some objects");
+}
+
 // ===========================================================================
 // The Test Suite that glues the Test Cases together.
 // ===========================================================================
@@ -789,8 +903,23 @@ ObjectTestSuite::ObjectTestSuite ()
   AddTestCase (new CreateObjectTestCase);
   AddTestCase (new AggregateObjectTestCase);
   AddTestCase (new ObjectFactoryTestCase);
+  AddTestCase (new GetObjectCacheTestCase);
 }
 
 static ObjectTestSuite objectTestSuite;
 
+class ObjectPerformanceTestSuite : public TestSuite
+{
+public:
+  ObjectPerformanceTestSuite ();
+};
+
+ObjectPerformanceTestSuite::ObjectPerformanceTestSuite ()
+  : TestSuite ("object-performance", PERFORMANCE)
+{
+  AddTestCase (new GetObjectPerformanceTestCase);
+}
+
+static ObjectPerformanceTestSuite objectPerformanceTestSuite;
+
 } // namespace ns3
@@ -240,11 +240,24 @@ private:
    * chunk of memory than the struct to allow space for a larger
    * variable sized buffer whose size is indicated by the element
    * 'n'
+   *
+   * The cache holds the objects found by the last calls to
+   * DoGetObject, indexed by the uid of the requested TypeId
+   * modulo CACHE_SIZE. An empty entry has a zero uid.
    */
+  enum {
+    CACHE_SIZE = 8
+  };
+  struct CacheEntry {
+    uint16_t tid;
+    Object *object;
+  };
   struct Aggregates {
+    struct CacheEntry cache[CACHE_SIZE];
     uint32_t n;
     Object *buffer[1];
   };
+  static struct Aggregates *AllocateAggregates (uint32_t n);
 
   Ptr<Object> DoGetObject (TypeId tid) const;
   bool Check (void) const;
@@ -386,16 +399,23 @@ template <typename T>
 Ptr<T> 
 Object::GetObject () const
 {
+  // DoGetObject finds the objects looked up before in its cache,
+  // which is cheaper than a failed dynamic_cast.
+  Ptr<Object> found = DoGetObject (T::GetTypeId ());
+  if (found != 0)
+    {
+      T *result = dynamic_cast<T *> (PeekPointer (found));
+      if (result != 0)
+        {
+          return Ptr<T> (result);
+        }
+    }
+  // T might not have a TypeId of its own
   T *result = dynamic_cast<T *> (m_aggregates->buffer[0]);
   if (result != 0)
     {
       return Ptr<T> (result);
     }
-  Ptr<Object> found = DoGetObject (T::GetTypeId ());
-  if (found != 0)
-    {
-      return Ptr<T> (dynamic_cast<T *> (PeekPointer (found)));
-    }
   return 0;
 }
 
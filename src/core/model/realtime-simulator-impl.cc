@@ -28,7 +28,6 @@
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
-#include "ns3/system-mutex.h"
 #include "ns3/boolean.h"
 #include "ns3/enum.h"
 
@@ -79,6 +78,7 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = 0xffffffff;
   m_unscheduledEvents = 0;
+  m_injected = 0;
 
   // Be very careful not to do anything that would cause a change or assignment
   // of the underlying reference counts of m_synchronizer or you will be sorry.
@@ -92,6 +92,7 @@ void
 RealtimeSimulatorImpl::DoDispose (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
+  DrainInjected ();
   while (m_events->IsEmpty () == false)
     {
       Scheduler::Event next = m_events->RemoveNext ();
@@ -134,19 +135,85 @@ RealtimeSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
 
   Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
 
-  { 
-    CriticalSection cs (m_mutex);
+  if (m_events != 0)
+    {
+      while (m_events->IsEmpty () == false)
+        {
+          Scheduler::Event next = m_events->RemoveNext ();
+          scheduler->Insert (next);
+        }
+    }
+  m_events = scheduler;
+}
 
-    if (m_events != 0)
-      {
-        while (m_events->IsEmpty () == false)
-          {
-            Scheduler::Event next = m_events->RemoveNext ();
-            scheduler->Insert (next);
-          }
-      }
-    m_events = scheduler;
-  }
+void
+RealtimeSimulatorImpl::Inject (uint64_t ts, uint32_t context, EventImpl *impl)
+{
+  NS_LOG_FUNCTION (ts << context << impl);
+  InjectedEvent *injected = new InjectedEvent ();
+  injected->ts = ts;
+  injected->context = context;
+  injected->impl = impl;
+  InjectedEvent *head;
+  do
+    {
+      head = m_injected;
+      injected->next = head;
+    }
+  while (!__sync_bool_compare_and_swap (&m_injected, head, injected));
+  //
+  // Wake up the simulation thread if it is waiting for the next event
+  // to come due: the injected event may be due before that one.
+  //
+  m_synchronizer->Signal ();
+}
+
+//
+// Move the events injected by the other threads to the event list.  Must only
+// be called from the simulation thread.
+//
+void
+RealtimeSimulatorImpl::DrainInjected (void)
+{
+  if (m_injected == 0)
+    {
+      return;
+    }
+  //
+  // Take the whole list at once.  The other threads can keep on pushing events
+  // onto the (now empty) list meanwhile; since this thread is the only one which
+  // removes events from it, the head we swap out cannot be reused under us.
+  //
+  InjectedEvent *head = __sync_lock_test_and_set (&m_injected, (InjectedEvent *)0);
+  // the list is in reverse order of injection.
+  InjectedEvent *ordered = 0;
+  while (head != 0)
+    {
+      InjectedEvent *next = head->next;
+      head->next = ordered;
+      ordered = head;
+      head = next;
+    }
+  while (ordered != 0)
+    {
+      //
+      // The event may have been injected while the simulation thread was
+      // executing an event which was due slightly later than the real time of
+      // the injection.  It is then late, but it cannot make the time go
+      // backward.
+      //
+      Scheduler::Event ev;
+      ev.impl = ordered->impl;
+      ev.key.m_ts = ordered->ts < m_currentTs ? m_currentTs : ordered->ts;
+      ev.key.m_context = ordered->context;
+      ev.key.m_uid = m_uid;
+      m_uid++;
+      m_unscheduledEvents++;
+      m_events->Insert (ev);
+      InjectedEvent *next = ordered->next;
+      delete ordered;
+      ordered = next;
+    }
 }
 
 void
@@ -192,8 +259,7 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
       //
       uint64_t tsNow;
 
-      { 
-        CriticalSection cs (m_mutex);
+      {
         //
         // Since we are in realtime mode, the time to delay has got to be the 
         // difference between the current realtime and the timestamp of the next 
@@ -207,6 +273,17 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
         NS_ASSERT_MSG (m_synchronizer->Realtime (), 
           "RealtimeSimulatorImpl::ProcessOneEvent (): Synchronizer reports not Realtime ()");
 
+        //
+        // We're going to sleep, but need to work with the synchronizer to make 
+        // sure we're awakened if something external happens (like a packet is 
+        // received).  This next line resets the synchronizer so that any event 
+        // injected from now on will cause it to interrupt.  The events which were
+        // injected before are moved to the event list right below, so that we 
+        // take them into account in the delay computation.
+        //
+        m_synchronizer->SetCondition (false);
+        DrainInjected ();
+
         //
         // tsNow is set to the normalized current real time.  When the simulation was
         // started, the current real time was effectively set to zero; so tsNow is
@@ -234,31 +311,21 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
           {
             tsDelay = tsNext - tsNow;
           }
-      
-        //
-        // We've figured out how long we need to delay in order to pace the 
-        // simulation time with the real time.  We're going to sleep, but need
-        // to work with the synchronizer to make sure we're awakened if something 
-        // external happens (like a packet is received).  This next line resets
-        // the synchronizer so that any future event will cause it to interrupt.
-        //
-        m_synchronizer->SetCondition (false);
       }
 
       //
       // We have a time to delay.  This time may actually not be valid anymore
-      // since we released the critical section immediately above, and a real-time
-      // ScheduleReal or ScheduleRealNow may have snuck in, well, between the 
-      // closing brace above and this comment so to speak.  If this is the case, 
-      // that schedule operation will have done a synchronizer Signal() that 
-      // will set the condition variable to true and cause the Synchronize call 
-      // below to return immediately.
+      // since another thread may have injected an event with ScheduleRealtime or
+      // ScheduleRealtimeNow after we drained the injected events above.  If this
+      // is the case, that schedule operation will have done a synchronizer 
+      // Signal() that will set the condition variable to true and cause the 
+      // Synchronize call below to return immediately.
       //
       // It's easiest to understand if you just consider a short tsDelay that only
       // requires a SpinWait down in the synchronizer.  What will happen is that 
       // whan Synchronize calls SpinWait, SpinWait will look directly at its 
       // condition variable.  Note that we set this condition variable to false 
-      // inside the critical section above. 
+      // before draining the injected events above. 
       //
       // SpinWait will go into a forever loop until either the time has expired or
       // until the condition variable becomes true.  A true condition indicates that
@@ -296,21 +363,16 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
   //
   // If we break out of the for-loop above, we have waited until the time specified
   // by the event that was at the head of the event list when we started the process.
-  // Since there is a bunch of code that was executed outside a critical section (the
-  // Synchronize call) we cannot be sure that the event at the head of the event list
-  // is the one we think it is.  What we can be sure of is that it is time to execute
-  // whatever event is at the head of this list if the list is in time order.
+  // Only this thread modifies the event list, so it is the event we are going to 
+  // execute.  An event injected meanwhile by another thread stays in m_injected 
+  // until the next call to ProcessOneEvent.
   //
   Scheduler::Event next;
 
-  { 
-    CriticalSection cs (m_mutex);
-
+  {
     // 
     // We do know we're waiting for an event, so there had better be an event on the 
-    // event queue.  Let's pull it off.  When we release the critical section, the
-    // event we're working on won't be on the list and so subsequent operations won't
-    // mess with us.
+    // event queue.  Let's pull it off.
     //
     NS_ASSERT_MSG (m_events->IsEmpty () == false, 
       "RealtimeSimulatorImpl::ProcessOneEvent(): event queue is empty");
@@ -369,8 +431,7 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
 
   //
   // We have got the event we're about to execute completely disentangled from the 
-  // event list so we can execute it outside a critical section without fear of someone
-  // changing things out from under us.
+  // event list.
 
   EventImpl *event = next.impl;
   m_synchronizer->EventStart ();
@@ -383,17 +444,11 @@ bool
 RealtimeSimulatorImpl::IsFinished (void) const
 {
   NS_LOG_FUNCTION_NOARGS ();
-  bool rc;
-  {
-    CriticalSection cs (m_mutex);
-    rc = m_events->IsEmpty () || m_stop;
-  }
-
-  return rc;
+  return (m_events->IsEmpty () && m_injected == 0) || m_stop;
 }
 
 //
-// Peeks into event list.  Should be called with critical section locked.
+// Peeks into event list.  Should be called from the simulation thread.
 //
 uint64_t
 RealtimeSimulatorImpl::NextTs (void) const
@@ -406,12 +461,14 @@ RealtimeSimulatorImpl::NextTs (void) const
 }
 
 //
-// Calls NextTs().  Should be called with critical section locked.
+// Calls NextTs().  Should be called from the simulation thread.
 //
 Time
 RealtimeSimulatorImpl::Next (void) const
 {
   NS_LOG_FUNCTION_NOARGS ();
+  // the injected events are part of the event list from the user's point of view.
+  const_cast<RealtimeSimulatorImpl *> (this)->DrainInjected ();
   return TimeStep (NextTs ());
 }
 
@@ -429,23 +486,14 @@ RealtimeSimulatorImpl::Run (void)
 
   for (;;) 
     {
-      bool done = false;
-
-      {
-        CriticalSection cs (m_mutex);
-        //
-        // In all cases we stop when the event list is empty.  If you are doing a 
-        // realtime simulation and you want it to extend out for some time, you must
-        // call StopAt.  In the realtime case, this will stick a placeholder event out
-        // at the end of time.
-        //
-        if (m_stop || m_events->IsEmpty ())
-          {
-            done = true;
-          }
-      }
-
-      if (done)
+      //
+      // In all cases we stop when the event list is empty.  If you are doing a 
+      // realtime simulation and you want it to extend out for some time, you must
+      // call StopAt.  In the realtime case, this will stick a placeholder event out
+      // at the end of time.
+      //
+      DrainInjected ();
+      if (m_stop || m_events->IsEmpty ())
         {
           break;
         }
@@ -457,12 +505,8 @@ RealtimeSimulatorImpl::Run (void)
   // If the simulator stopped naturally by lack of events, make a
   // consistency test to check that we didn't lose any events along the way.
   //
-  {
-    CriticalSection cs (m_mutex);
-
-    NS_ASSERT_MSG (m_events->IsEmpty () == false || m_unscheduledEvents == 0,
-      "RealtimeSimulatorImpl::Run(): Empty queue and unprocessed events");
-  }
+  NS_ASSERT_MSG (m_events->IsEmpty () == false || m_unscheduledEvents == 0,
+    "RealtimeSimulatorImpl::Run(): Empty queue and unprocessed events");
 
   m_running = false;
 }
@@ -501,26 +545,20 @@ RealtimeSimulatorImpl::RunOneEvent (void)
   NS_ASSERT_MSG (m_running == false, 
                  "RealtimeSimulatorImpl::RunOneEvent(): An internal simulator event loop is running");
 
-  EventImpl *event = 0;
-
   //
-  // Run this in a critical section in case there's another thread around that
-  // may be inserting things onto the event list.
+  // There may be another thread around that has injected events.
   //
-  {
-    CriticalSection cs (m_mutex);
+  DrainInjected ();
+  Scheduler::Event next = m_events->RemoveNext ();
 
-    Scheduler::Event next = m_events->RemoveNext ();
+  NS_ASSERT (next.key.m_ts >= m_currentTs);
+  m_unscheduledEvents--;
 
-    NS_ASSERT (next.key.m_ts >= m_currentTs);
-    m_unscheduledEvents--;
-
-    NS_LOG_LOGIC ("handle " << next.key.m_ts);
-    m_currentTs = next.key.m_ts;
-    m_currentContext = next.key.m_context;
-    m_currentUid = next.key.m_uid;
-    event = next.impl;
-  }
+  NS_LOG_LOGIC ("handle " << next.key.m_ts);
+  m_currentTs = next.key.m_ts;
+  m_currentContext = next.key.m_context;
+  m_currentUid = next.key.m_uid;
+  EventImpl *event = next.impl;
   event->Invoke ();
   event->Unref ();
 }
@@ -546,27 +584,22 @@ RealtimeSimulatorImpl::Schedule (Time const &time, EventImpl *impl)
 {
   NS_LOG_FUNCTION (time << impl);
 
+  //
+  // This method is only called from the simulation thread, which is not waiting
+  // for an event to come due, so there is no need to signal the synchronizer.
+  // The other threads must use ScheduleRealtime instead.
+  //
+  Time tAbsolute = Simulator::Now () + time;
+  NS_ASSERT_MSG (tAbsolute.IsPositive (), "RealtimeSimulatorImpl::Schedule(): Negative time");
+  NS_ASSERT_MSG (tAbsolute >= TimeStep (m_currentTs), "RealtimeSimulatorImpl::Schedule(): time < m_currentTs");
   Scheduler::Event ev;
-  {
-    CriticalSection cs (m_mutex);
-    //
-    // This is the reason we had to bring the absolute time calcualtion in from the
-    // simulator.h into the implementation.  Since the implementations may be 
-    // multi-threaded, we need this calculation to be atomic.  You can see it is
-    // here since we are running in a CriticalSection.
-    //
-    Time tAbsolute = Simulator::Now () + time;
-    NS_ASSERT_MSG (tAbsolute.IsPositive (), "RealtimeSimulatorImpl::Schedule(): Negative time");
-    NS_ASSERT_MSG (tAbsolute >= TimeStep (m_currentTs), "RealtimeSimulatorImpl::Schedule(): time < m_currentTs");
-    ev.impl = impl;
-    ev.key.m_ts = (uint64_t) tAbsolute.GetTimeStep ();
-    ev.key.m_context = GetContext ();
-    ev.key.m_uid = m_uid;
-    m_uid++;
-    m_unscheduledEvents++;
-    m_events->Insert (ev);
-    m_synchronizer->Signal ();
-  }
+  ev.impl = impl;
+  ev.key.m_ts = (uint64_t) tAbsolute.GetTimeStep ();
+  ev.key.m_context = GetContext ();
+  ev.key.m_uid = m_uid;
+  m_uid++;
+  m_unscheduledEvents++;
+  m_events->Insert (ev);
 
   return EventId (impl, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
 }
@@ -576,22 +609,16 @@ RealtimeSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &time,
 {
   NS_LOG_FUNCTION (time << impl);
 
-  {
-    CriticalSection cs (m_mutex);
-    uint64_t ts;
-
-    ts = m_currentTs + time.GetTimeStep ();
-    NS_ASSERT_MSG (ts >= m_currentTs, "RealtimeSimulatorImpl::ScheduleRealtime(): schedule for time < m_currentTs");
-    Scheduler::Event ev;
-    ev.impl = impl;
-    ev.key.m_ts = ts;
-    ev.key.m_context = context;
-    ev.key.m_uid = m_uid;
-    m_uid++;
-    m_unscheduledEvents++;
-    m_events->Insert (ev);
-    m_synchronizer->Signal ();
-  }
+  uint64_t ts = m_currentTs + time.GetTimeStep ();
+  NS_ASSERT_MSG (ts >= m_currentTs, "RealtimeSimulatorImpl::ScheduleRealtime(): schedule for time < m_currentTs");
+  Scheduler::Event ev;
+  ev.impl = impl;
+  ev.key.m_ts = ts;
+  ev.key.m_context = context;
+  ev.key.m_uid = m_uid;
+  m_uid++;
+  m_unscheduledEvents++;
+  m_events->Insert (ev);
 }
 
 EventId
@@ -599,18 +626,13 @@ RealtimeSimulatorImpl::ScheduleNow (EventImpl *impl)
 {
   NS_LOG_FUNCTION_NOARGS ();
   Scheduler::Event ev;
-  {
-    CriticalSection cs (m_mutex);
-
-    ev.impl = impl;
-    ev.key.m_ts = m_currentTs;
-    ev.key.m_context = GetContext ();
-    ev.key.m_uid = m_uid;
-    m_uid++;
-    m_unscheduledEvents++;
-    m_events->Insert (ev);
-    m_synchronizer->Signal ();
-  }
+  ev.impl = impl;
+  ev.key.m_ts = m_currentTs;
+  ev.key.m_context = GetContext ();
+  ev.key.m_uid = m_uid;
+  m_uid++;
+  m_unscheduledEvents++;
+  m_events->Insert (ev);
 
   return EventId (impl, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
 }
@@ -622,27 +644,14 @@ RealtimeSimulatorImpl::Now (void) const
 }
 
 //
-// Schedule an event for a _relative_ time in the future.
+// Schedule an event for a _relative_ time in the future.  May be called from
+// any thread: the event is moved to the event list by the simulation thread.
 //
 void
 RealtimeSimulatorImpl::ScheduleRealtimeWithContext (uint32_t context, Time const &time, EventImpl *impl)
 {
   NS_LOG_FUNCTION (context << time << impl);
-  
-  {
-    CriticalSection cs (m_mutex);
-
-    uint64_t ts = m_synchronizer->GetCurrentRealtime () + time.GetTimeStep ();
-    NS_ASSERT_MSG (ts >= m_currentTs, "RealtimeSimulatorImpl::ScheduleRealtime(): schedule for time < m_currentTs");
-    Scheduler::Event ev;
-    ev.impl = impl;
-    ev.key.m_ts = ts;
-    ev.key.m_uid = m_uid;
-    m_uid++;
-    m_unscheduledEvents++;
-    m_events->Insert (ev);
-    m_synchronizer->Signal ();
-  }
+  Inject (m_synchronizer->GetCurrentRealtime () + time.GetTimeStep (), context, impl);
 }
 
 void
@@ -656,26 +665,12 @@ void
 RealtimeSimulatorImpl::ScheduleRealtimeNowWithContext (uint32_t context, EventImpl *impl)
 {
   NS_LOG_FUNCTION (context << impl);
-  {
-    CriticalSection cs (m_mutex);
-
-    //
-    // If the simulator is running, we're pacing and have a meaningful 
-    // realtime clock.  If we're not, then m_currentTs is were we stopped.
-    // 
-    uint64_t ts = m_running ? m_synchronizer->GetCurrentRealtime () : m_currentTs;
-    NS_ASSERT_MSG (ts >= m_currentTs, 
-                   "RealtimeSimulatorImpl::ScheduleRealtimeNowWithContext(): schedule for time < m_currentTs");
-    Scheduler::Event ev;
-    ev.impl = impl;
-    ev.key.m_ts = ts;
-    ev.key.m_uid = m_uid;
-    ev.key.m_context = context;
-    m_uid++;
-    m_unscheduledEvents++;
-    m_events->Insert (ev);
-    m_synchronizer->Signal ();
-  }
+  //
+  // If the simulator is running, we're pacing and have a meaningful 
+  // realtime clock.  If we're not, then m_currentTs is were we stopped:
+  // DrainInjected never moves an event before m_currentTs.
+  // 
+  Inject (m_running ? m_synchronizer->GetCurrentRealtime () : 0, context, impl);
 }
 
 void
@@ -696,19 +691,14 @@ RealtimeSimulatorImpl::ScheduleDestroy (EventImpl *impl)
 {
   NS_LOG_FUNCTION_NOARGS ();
 
-  EventId id;
-  {
-    CriticalSection cs (m_mutex);
-
-    //
-    // Time doesn't really matter here (especially in realtime mode).  It is 
-    // overridden by the uid of 2 which identifies this as an event to be 
-    // executed at Simulator::Destroy time.
-    //
-    id = EventId (Ptr<EventImpl> (impl, false), m_currentTs, 0xffffffff, 2);
-    m_destroyEvents.push_back (id);
-    m_uid++;
-  }
+  //
+  // Time doesn't really matter here (especially in realtime mode).  It is 
+  // overridden by the uid of 2 which identifies this as an event to be 
+  // executed at Simulator::Destroy time.
+  //
+  EventId id = EventId (Ptr<EventImpl> (impl, false), m_currentTs, 0xffffffff, 2);
+  m_destroyEvents.push_back (id);
+  m_uid++;
 
   return id;
 }
@@ -751,20 +741,16 @@ RealtimeSimulatorImpl::Remove (const EventId &id)
       return;
     }
 
-  {
-    CriticalSection cs (m_mutex);
-
-    Scheduler::Event event;
-    event.impl = id.PeekEventImpl ();
-    event.key.m_ts = id.GetTs ();
-    event.key.m_context = id.GetContext ();
-    event.key.m_uid = id.GetUid ();
-    
-    m_events->Remove (event);
-    m_unscheduledEvents--;
-    event.impl->Cancel ();
-    event.impl->Unref ();
-  }
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+
+  m_events->Remove (event);
+  m_unscheduledEvents--;
+  event.impl->Cancel ();
+  event.impl->Unref ();
 }
 
 void
@@ -28,7 +28,6 @@
 #include "ns3/ptr.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
-#include "ns3/system-mutex.h"
 
 #include <list>
 
@@ -92,12 +91,27 @@ private:
   uint64_t NextTs (void) const;
   virtual void DoDispose (void);
 
+  /**
+   * An event scheduled by another thread with one of the
+   * ScheduleRealtime methods, which waits in m_injected until the
+   * simulation thread moves it to the event list.
+   */
+  struct InjectedEvent
+  {
+    uint64_t ts;
+    uint32_t context;
+    EventImpl *impl;
+    struct InjectedEvent *next;
+  };
+  void Inject (uint64_t ts, uint32_t context, EventImpl *impl);
+  void DrainInjected (void);
+
   typedef std::list<EventId> DestroyEvents;
   DestroyEvents m_destroyEvents;
   bool m_stop;
   bool m_running;
 
-  // The following variables are protected using the m_mutex
+  // The following variables are only accessed by the simulation thread
   Ptr<Scheduler> m_events;
   int m_unscheduledEvents;
   uint32_t m_uid;
@@ -105,7 +119,13 @@ private:
   uint64_t m_currentTs;
   uint32_t m_currentContext;
 
-  mutable SystemMutex m_mutex;
+  /**
+   * The events injected by the other threads, most recent first. The
+   * other threads push events onto this list with a compare-and-swap
+   * and the simulation thread takes the whole list at once, so that
+   * no lock is needed on either side.
+   */
+  InjectedEvent * volatile m_injected;
 
   Ptr<Synchronizer> m_synchronizer;
 
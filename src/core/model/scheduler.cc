@@ -19,6 +19,7 @@
  */
 
 #include "scheduler.h"
+#include "event-impl.h"
 #include "ns3/assert.h"
 
 namespace ns3 {
@@ -38,4 +39,35 @@ Scheduler::GetTypeId (void)
   return tid;
 }
 
+void
+Scheduler::InsertBatch (const std::vector<Event> &events)
+{
+  for (std::vector<Event>::const_iterator i = events.begin (); i != events.end (); i++)
+    {
+      Insert (*i);
+    }
+}
+
+void
+Scheduler::RemoveCancelled (std::vector<Event> &removed)
+{
+  std::vector<Event> kept;
+  while (!IsEmpty ())
+    {
+      Event ev = RemoveNext ();
+      if (ev.impl->IsCancelled ())
+        {
+          removed.push_back (ev);
+        }
+      else
+        {
+          kept.push_back (ev);
+        }
+    }
+  for (std::vector<Event>::const_iterator i = kept.begin (); i != kept.end (); i++)
+    {
+      Insert (*i);
+    }
+}
+
 } // namespace ns3
@@ -22,6 +22,7 @@
 #define SCHEDULER_H
 
 #include <stdint.h>
+#include <vector>
 #include "ns3/object.h"
 
 namespace ns3 {
@@ -73,6 +74,18 @@ public:
    * \param ev event to store in the event list
    */
   virtual void Insert (const Event &ev) = 0;
+  /**
+   * \param events the events to store in the event list
+   *
+   * Insert a group of events at once, typically all the receptions
+   * of a packet sent on a broadcast channel. The events are not
+   * necessarily sorted.
+   *
+   * The default implementation inserts the events one by one:
+   * subclasses which can amortize the cost of an insertion over
+   * many events should override it.
+   */
+  virtual void InsertBatch (const std::vector<Event> &events);
   /**
    * \returns true if the event list is empty and false otherwise.
    */
@@ -95,6 +108,18 @@ public:
    * This methods cannot be invoked if the list is empty.
    */
   virtual void Remove (const Event &ev) = 0;
+  /**
+   * \param removed the list to which the removed events are appended.
+   *
+   * Remove from the event list all the events which have been cancelled.
+   * As with the other Remove methods, the caller is responsible for
+   * calling EventImpl::Unref on the removed events.
+   *
+   * The default implementation removes all the events and inserts
+   * back those which are not cancelled: subclasses which can filter
+   * their storage in place should override it.
+   */
+  virtual void RemoveCancelled (std::vector<Event> &removed);
 };
 
 /* Note the invariants which this function must provide:
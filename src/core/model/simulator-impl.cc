@@ -11,4 +11,22 @@ SimulatorImpl::GetTypeId (void)
   return tid;
 }
 
+void
+SimulatorImpl::ScheduleBatch (const std::vector<BatchEvent> &events, std::vector<EventId> &ids)
+{
+  for (std::vector<BatchEvent>::const_iterator i = events.begin (); i != events.end (); i++)
+    {
+      ids.push_back (Schedule (i->delay, i->event));
+    }
+}
+
+void
+SimulatorImpl::ScheduleWithContextBatch (const std::vector<BatchEvent> &events)
+{
+  for (std::vector<BatchEvent>::const_iterator i = events.begin (); i != events.end (); i++)
+    {
+      ScheduleWithContext (i->context, i->delay, i->event);
+    }
+}
+
 } // namespace ns3
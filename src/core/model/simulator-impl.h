@@ -24,10 +24,13 @@
 #include "event-impl.h"
 #include "event-id.h"
 #include "nstime.h"
+#include "batch-event.h"
 #include "ns3/object.h"
 #include "ns3/object-factory.h"
 #include "ns3/ptr.h"
 
+#include <vector>
+
 namespace ns3 {
 
 class Scheduler;
@@ -93,6 +96,19 @@ public:
    * to delegate events to their own subclass of the EventImpl base class.
    */
   virtual void ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event) = 0;
+  /**
+   * \param events the events to schedule in the current context
+   * \param ids the list to which the identifiers of the new events are appended
+   *
+   * The default implementation calls Schedule for each event.
+   */
+  virtual void ScheduleBatch (const std::vector<BatchEvent> &events, std::vector<EventId> &ids);
+  /**
+   * \param events the events to schedule, with their context
+   *
+   * The default implementation calls ScheduleWithContext for each event.
+   */
+  virtual void ScheduleWithContextBatch (const std::vector<BatchEvent> &events);
   /**
    * \param event the event to schedule
    * \returns a unique identifier for the newly-scheduled event.
@@ -228,6 +228,28 @@ Simulator::ScheduleWithContext (uint32_t context, const Time &time, EventImpl *i
 {
   return GetImpl ()->ScheduleWithContext (context, time, impl);
 }
+BatchEvent::BatchEvent (Time const &delay, EventImpl *event)
+  : context (0xffffffff),
+    delay (delay),
+    event (event)
+{}
+BatchEvent::BatchEvent (uint32_t context, Time const &delay, EventImpl *event)
+  : context (context),
+    delay (delay),
+    event (event)
+{}
+void
+Simulator::ScheduleBatch (const std::vector<BatchEvent> &events, std::vector<EventId> &ids)
+{
+  NS_LOG_FUNCTION (events.size ());
+  GetImpl ()->ScheduleBatch (events, ids);
+}
+void
+Simulator::ScheduleWithContextBatch (const std::vector<BatchEvent> &events)
+{
+  NS_LOG_FUNCTION (events.size ());
+  GetImpl ()->ScheduleWithContextBatch (events);
+}
 EventId
 Simulator::ScheduleDestroy (const Ptr<EventImpl> &ev)
 {
@@ -386,6 +408,16 @@ Simulator::GetImplementation (void)
 #include "map-scheduler.h"
 #include "calendar-scheduler.h"
 #include "ns2-calendar-scheduler.h"
+#include "ladder-scheduler.h"
+#include "dary-heap-scheduler.h"
+#include "default-simulator-impl.h"
+#include "uinteger.h"
+#include "event-memory-pool.h"
+#include "event-profiler.h"
+#include <sstream>
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#endif
 
 namespace ns3 {
 
@@ -820,6 +852,399 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SchedulerOrderTestCase : public TestCase
+{
+public:
+  SchedulerOrderTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  uint32_t Random (void);
+  EventImpl *CreateEvent (void);
+  static void Nothing (void);
+  uint32_t m_seed;
+  ObjectFactory m_schedulerFactory;
+  std::vector<Ptr<EventImpl> > m_events;
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check the order of a large number of events with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{}
+
+uint32_t
+SchedulerOrderTestCase::Random (void)
+{
+  m_seed = m_seed * 1103515245 + 12345;
+  return m_seed >> 8;
+}
+
+void
+SchedulerOrderTestCase::Nothing (void)
+{
+}
+
+EventImpl *
+SchedulerOrderTestCase::CreateEvent (void)
+{
+  // some schedulers record the position of the events in them.
+  m_events.push_back (Ptr<EventImpl> (MakeEvent (&SchedulerOrderTestCase::Nothing), false));
+  return PeekPointer (m_events.back ());
+}
+
+void
+SchedulerOrderTestCase::DoRun (void)
+{
+  m_seed = 1;
+  Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+  Ptr<Scheduler> reference = CreateObject<MapScheduler> ();
+  std::vector<Scheduler::Event> pending;
+  Scheduler::EventKey last;
+  last.m_ts = 0;
+  last.m_uid = 0;
+  last.m_context = 0;
+  uint32_t uid = 4;
+  uint32_t errors = 0;
+  for (uint32_t i = 0; i < 200000; i++)
+    {
+      uint32_t action = Random () % 16;
+      if (action == 8)
+        {
+          // a batch of events, now and then larger than the event list.
+          std::vector<Scheduler::Event> batch;
+          uint32_t n = (Random () % 64 == 0) ? Random () % 4096 : Random () % 32;
+          for (uint32_t j = 0; j < n; j++)
+            {
+              Scheduler::Event ev;
+              ev.impl = CreateEvent ();
+              ev.key.m_ts = last.m_ts + Random () % 1000;
+              ev.key.m_uid = uid++;
+              ev.key.m_context = 0;
+              reference->Insert (ev);
+              pending.push_back (ev);
+              batch.push_back (ev);
+            }
+          scheduler->InsertBatch (batch);
+          // keep the size of the event list stable.
+          for (uint32_t j = 0; j < n; j++)
+            {
+              Scheduler::Event a = scheduler->RemoveNext ();
+              Scheduler::Event b = reference->RemoveNext ();
+              if (a.key.m_uid != b.key.m_uid || a.key.m_ts != b.key.m_ts)
+                {
+                  errors++;
+                }
+              last = b.key;
+            }
+        }
+      else if (action < 9 || reference->IsEmpty ())
+        {
+          Scheduler::Event ev;
+          ev.impl = CreateEvent ();
+          // a mix of events at the same time, of short delays and of
+          // a few very long delays to skew the distribution.
+          uint32_t kind = Random () % 8;
+          uint64_t delay = kind == 0 ? 0 : kind < 6 ? Random () % 1000 : kind < 7 ? Random () % 1000000 : Random ();
+          ev.key.m_ts = last.m_ts + delay;
+          ev.key.m_uid = uid++;
+          ev.key.m_context = 0;
+          scheduler->Insert (ev);
+          reference->Insert (ev);
+          pending.push_back (ev);
+        }
+      else if (action < 15)
+        {
+          Scheduler::Event a = scheduler->RemoveNext ();
+          Scheduler::Event b = reference->RemoveNext ();
+          if (a.key.m_uid != b.key.m_uid || a.key.m_ts != b.key.m_ts)
+            {
+              errors++;
+            }
+          last = b.key;
+        }
+      else
+        {
+          // remove a random event which may already have run.
+          uint32_t index = Random () % pending.size ();
+          Scheduler::Event ev = pending[index];
+          pending[index] = pending.back ();
+          pending.pop_back ();
+          if (ev.key > last)
+            {
+              scheduler->Remove (ev);
+              reference->Remove (ev);
+            }
+        }
+      if (scheduler->IsEmpty () != reference->IsEmpty ())
+        {
+          errors++;
+        }
+    }
+  while (!reference->IsEmpty ())
+    {
+      Scheduler::Event a = scheduler->RemoveNext ();
+      Scheduler::Event b = reference->RemoveNext ();
+      if (a.key.m_uid != b.key.m_uid || a.key.m_ts != b.key.m_ts)
+        {
+          errors++;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (scheduler->IsEmpty (), true, "The scheduler should be empty");
+  NS_TEST_EXPECT_MSG_EQ (errors, 0, "Events were not removed in the right order");
+  m_events.clear ();
+}
+
+class BatchEventsTestCase : public TestCase
+{
+public:
+  BatchEventsTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  void Check (uint32_t index, uint32_t context);
+  uint32_t m_count;
+  uint64_t m_lastTs;
+  uint32_t m_errors;
+  ObjectFactory m_schedulerFactory;
+};
+
+BatchEventsTestCase::BatchEventsTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check the scheduling of batches of events with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{}
+
+void
+BatchEventsTestCase::Check (uint32_t index, uint32_t context)
+{
+  // events are scheduled with a delay of (index % 7) ms, and with
+  // their index as context.
+  if (Simulator::GetContext () != context ||
+      Simulator::Now ().GetTimeStep () < m_lastTs)
+    {
+      m_errors++;
+    }
+  m_lastTs = Simulator::Now ().GetTimeStep ();
+  m_count++;
+}
+
+void
+BatchEventsTestCase::DoRun (void)
+{
+  m_count = 0;
+  m_lastTs = 0;
+  m_errors = 0;
+  Simulator::Destroy ();
+  Simulator::SetScheduler (m_schedulerFactory);
+
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      Simulator::ScheduleWithContext (i, MilliSeconds (i % 3), &BatchEventsTestCase::Check, this, i, i);
+    }
+  std::vector<Simulator::BatchEvent> batch;
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      batch.push_back (Simulator::BatchEvent (i, MilliSeconds (i % 7),
+                                              MakeEvent (&BatchEventsTestCase::Check, this, i, i)));
+    }
+  Simulator::ScheduleWithContextBatch (batch);
+
+  batch.clear ();
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      batch.push_back (Simulator::BatchEvent (MilliSeconds (i % 7),
+                                              MakeEvent (&BatchEventsTestCase::Check, this, i,
+                                                         Simulator::GetContext ())));
+    }
+  std::vector<EventId> ids;
+  Simulator::ScheduleBatch (batch, ids);
+  NS_TEST_EXPECT_MSG_EQ (ids.size (), 100, "There should be one id per event");
+  for (uint32_t i = 0; i < 50; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (Simulator::GetDelayLeft (ids[i * 2]), MilliSeconds ((i * 2) % 7), "Wrong delay");
+      Simulator::Cancel (ids[i * 2]);
+    }
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_count, 10 + 100 + 50, "Wrong number of events run");
+  NS_TEST_EXPECT_MSG_EQ (m_errors, 0, "Events run in the wrong context or order");
+  Simulator::Destroy ();
+}
+
+class CancelledEventsTestCase : public TestCase
+{
+public:
+  CancelledEventsTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  void Count (void);
+  uint32_t m_count;
+  ObjectFactory m_schedulerFactory;
+};
+
+CancelledEventsTestCase::CancelledEventsTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that cancelled events are compacted with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{}
+
+void
+CancelledEventsTestCase::Count (void)
+{
+  m_count++;
+}
+
+void
+CancelledEventsTestCase::DoRun (void)
+{
+  m_count = 0;
+  Simulator::Destroy ();
+  Ptr<DefaultSimulatorImpl> impl = CreateObject<DefaultSimulatorImpl> ();
+  Simulator::SetImplementation (impl);
+  Simulator::SetScheduler (m_schedulerFactory);
+
+  std::vector<EventId> ids;
+  for (uint32_t i = 0; i < 10000; i++)
+    {
+      ids.push_back (Simulator::Schedule (MicroSeconds (i % 1000), &CancelledEventsTestCase::Count, this));
+    }
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      ids[i * 5].Cancel ();
+      // cancelling twice must not be accounted twice.
+      ids[i * 5].Cancel ();
+    }
+  NS_TEST_EXPECT_MSG_EQ (impl->GetEventCount (), 10000, "Cancelled events are still queued");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetCancelledEventCount (), 2000, "Wrong number of cancelled events");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetCompactionCount (), 0, "The event list should not have been compacted");
+  for (uint32_t i = 0; i < 4000; i++)
+    {
+      ids[i * 2 + 1].Cancel ();
+    }
+  NS_TEST_EXPECT_MSG_EQ (impl->GetCompactionCount (), 1, "The event list should have been compacted");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetEventCount () - impl->GetCancelledEventCount (),
+                         10000 - 2000 - 4000 + 800, "Wrong number of live events");
+  NS_TEST_EXPECT_MSG_EQ (ids[5].IsExpired (), true, "A cancelled event is expired");
+  NS_TEST_EXPECT_MSG_EQ (ids[2].IsExpired (), false, "A pending event is not expired");
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_count, 10000 - 2000 - 4000 + 800, "Wrong number of events run");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetEventCount (), 0, "All events should have been run");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetCancelledEventCount (), 0, "All cancelled events should be gone");
+  Simulator::Destroy ();
+}
+
+class EventMemoryPoolTestCase : public TestCase
+{
+public:
+  EventMemoryPoolTestCase ();
+  virtual void DoRun (void);
+  void Count (void);
+  void ReleaseEvents (void);
+  uint32_t m_count;
+  std::vector<Ptr<EventImpl> > m_events;
+  bool m_threadPool;
+  uint64_t m_threadSystemAllocations;
+};
+
+EventMemoryPoolTestCase::EventMemoryPoolTestCase ()
+  : TestCase ("Check that events are allocated from the simulator event pool")
+{}
+void
+EventMemoryPoolTestCase::Count (void)
+{
+  m_count++;
+}
+void
+EventMemoryPoolTestCase::ReleaseEvents (void)
+{
+  // the events allocated by the main thread are returned to its pool,
+  // but this thread has no pool of its own.
+  m_events.clear ();
+  m_threadPool = EventMemoryPool::GetCurrent () != 0;
+  uint64_t systemAllocations = EventMemoryPool::GetSystemAllocations ();
+  Ptr<EventImpl> event = Ptr<EventImpl> (MakeEvent (&EventMemoryPoolTestCase::Count, this), false);
+  m_threadSystemAllocations = EventMemoryPool::GetSystemAllocations () - systemAllocations;
+}
+void
+EventMemoryPoolTestCase::DoRun (void)
+{
+  m_count = 0;
+  // make sure the simulator, and thus the pool, exists.
+  Simulator::Now ();
+  uint64_t systemAllocations = EventMemoryPool::GetSystemAllocations ();
+  for (uint32_t i = 0; i < 10000; i++)
+    {
+      Simulator::Schedule (MicroSeconds (i % 100), &EventMemoryPoolTestCase::Count, this);
+    }
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_count, 10000, "All events should have run");
+  NS_TEST_EXPECT_MSG_LT (EventMemoryPool::GetSystemAllocations () - systemAllocations, 100,
+                         "Events should not be allocated one by one");
+
+#ifdef HAVE_PTHREAD_H
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      m_events.push_back (Ptr<EventImpl> (MakeEvent (&EventMemoryPoolTestCase::Count, this), false));
+    }
+  Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&EventMemoryPoolTestCase::ReleaseEvents, this));
+  thread->Start ();
+  thread->Join ();
+  NS_TEST_EXPECT_MSG_EQ (m_threadPool, false, "The pool should be current in the main thread only");
+  NS_TEST_EXPECT_MSG_EQ (m_threadSystemAllocations, 1, "The other threads should use the system allocator");
+#endif /* HAVE_PTHREAD_H */
+
+  // an event which outlives its simulator must be returned to the
+  // pool it was allocated from.
+  EventId id = Simulator::Schedule (Seconds (1.0), &EventMemoryPoolTestCase::Count, this);
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ (EventMemoryPool::GetCurrent () == 0, true, "The pool should have been released");
+  id = EventId ();
+  NS_TEST_EXPECT_MSG_EQ (m_count, 10000, "The pending event should not have run");
+}
+
+#ifdef ENABLE_EVENT_PROFILER
+class EventProfilerTestCase : public TestCase
+{
+public:
+  EventProfilerTestCase ();
+  virtual void DoRun (void);
+  void Foo (void);
+  void Bar (int);
+};
+
+EventProfilerTestCase::EventProfilerTestCase ()
+  : TestCase ("Check that the event profiler accounts events by type and context")
+{}
+void
+EventProfilerTestCase::Foo (void)
+{}
+void
+EventProfilerTestCase::Bar (int)
+{}
+void
+EventProfilerTestCase::DoRun (void)
+{
+  EventProfiler profiler;
+  Ptr<EventImpl> foo = MakeEvent (&EventProfilerTestCase::Foo, this);
+  Ptr<EventImpl> bar = MakeEvent (&EventProfilerTestCase::Bar, this, 1);
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      profiler.Start ();
+      foo->Invoke ();
+      profiler.Stop (PeekPointer (foo), 7);
+    }
+  profiler.Start ();
+  bar->Invoke ();
+  profiler.Stop (PeekPointer (bar), 0xffffffff);
+  NS_TEST_EXPECT_MSG_EQ (profiler.GetEventCount (), 4, "Wrong number of profiled events");
+
+  std::ostringstream os;
+  profiler.Report (os);
+  std::string report = os.str ();
+  NS_TEST_EXPECT_MSG_EQ ((report.find ("4 events") != std::string::npos), true,
+                         "The report should contain the total number of events");
+  NS_TEST_EXPECT_MSG_EQ ((report.find ("EventProfilerTestCase") != std::string::npos), true,
+                         "The report should name the event handlers");
+  NS_TEST_EXPECT_MSG_EQ ((report.find ("none") != std::string::npos), true,
+                         "The report should list the events without context");
+}
+#endif /* ENABLE_EVENT_PROFILER */
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -838,6 +1263,35 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory));
     factory.SetTypeId (Ns2CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory));
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory));
+    AddTestCase (new SchedulerOrderTestCase (factory));
+    factory.SetTypeId (DaryHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory));
+    AddTestCase (new SchedulerOrderTestCase (factory));
+    factory.Set ("Arity", UintegerValue (8));
+    AddTestCase (new SchedulerOrderTestCase (factory));
+    AddTestCase (new CancelledEventsTestCase (factory));
+    factory = ObjectFactory ();
+    factory.SetTypeId (ListScheduler::GetTypeId ());
+    AddTestCase (new CancelledEventsTestCase (factory));
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new CancelledEventsTestCase (factory));
+    factory.SetTypeId (HeapScheduler::GetTypeId ());
+    AddTestCase (new CancelledEventsTestCase (factory));
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new CancelledEventsTestCase (factory));
+    factory = ObjectFactory ();
+    factory.SetTypeId (ListScheduler::GetTypeId ());
+    AddTestCase (new BatchEventsTestCase (factory));
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new BatchEventsTestCase (factory));
+    factory.SetTypeId (DaryHeapScheduler::GetTypeId ());
+    AddTestCase (new BatchEventsTestCase (factory));
+    AddTestCase (new EventMemoryPoolTestCase ());
+#ifdef ENABLE_EVENT_PROFILER
+    AddTestCase (new EventProfilerTestCase ());
+#endif /* ENABLE_EVENT_PROFILER */
   }
 } g_simulatorTestSuite;
 
@@ -21,6 +21,7 @@
 #ifndef SIMULATOR_H
 #define SIMULATOR_H
 
+#include "batch-event.h"
 #include "event-id.h"
 #include "event-impl.h"
 #include "make-event.h"
@@ -31,6 +32,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace ns3 {
 
@@ -58,6 +60,14 @@ class Scheduler;
 class Simulator 
 {
 public:
+  /**
+   * \brief an event to schedule with Simulator::ScheduleBatch or
+   *        Simulator::ScheduleWithContextBatch
+   *
+   * \sa ns3::BatchEvent
+   */
+  typedef ns3::BatchEvent BatchEvent;
+
   /**
    * \param impl a new simulator implementation
    *
@@ -753,6 +763,31 @@ public:
    */
   static void ScheduleWithContext (uint32_t context, const Time &time, EventImpl *event);
 
+  /**
+   * \param events the events to schedule
+   * \param ids the list to which the identifiers of the new events are
+   *        appended, in the same order as the events.
+   *
+   * Schedule a group of events in the current context at once. The
+   * context of the events is ignored. This is equivalent to calling
+   * Simulator::Schedule for each event in turn but it allows the
+   * simulator to insert all the events in the event list in a
+   * single operation.
+   */
+  static void ScheduleBatch (const std::vector<BatchEvent> &events, std::vector<EventId> &ids);
+
+  /**
+   * \param events the events to schedule
+   *
+   * Schedule a group of events, each one in its own context, at once.
+   * This is equivalent to calling Simulator::ScheduleWithContext for
+   * each event in turn but it allows the simulator to insert all the
+   * events in the event list in a single operation: this is typically
+   * used by broadcast channels to schedule the reception of a packet
+   * by all the devices attached to them.
+   */
+  static void ScheduleWithContextBatch (const std::vector<BatchEvent> &events);
+
   /**
    * \param event the event to schedule
    * \returns a unique identifier for the newly-scheduled event.
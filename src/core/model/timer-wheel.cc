@@ -0,0 +1,346 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "timer-wheel.h"
+#include "timer.h"
+#include "simulator.h"
+#include "global-value.h"
+#include "nstime.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include <string.h>
+
+NS_LOG_COMPONENT_DEFINE ("TimerWheel");
+
+namespace ns3 {
+
+static GlobalValue g_timerWheelGranularity = GlobalValue ("TimerWheelGranularity",
+                                                          "The time spanned by a slot of the first level of the timer wheel",
+                                                          TimeValue (MilliSeconds (1)),
+                                                          MakeTimeChecker ());
+
+TimerWheel::Entry::Entry ()
+  : ts (0),
+    context (0),
+    timer (0),
+    next (0),
+    pprev (0),
+    slot (0),
+    wheel (0)
+{}
+
+// an entry in a wheel cannot be copied along with its timer: the copy
+// is never linked.
+TimerWheel::Entry::Entry (const Entry &o)
+  : ts (o.ts),
+    context (o.context),
+    timer (0),
+    next (0),
+    pprev (0),
+    slot (0),
+    wheel (0)
+{}
+
+TimerWheel::Entry &
+TimerWheel::Entry::operator = (const Entry &o)
+{
+  NS_ASSERT (pprev == 0);
+  ts = o.ts;
+  context = o.context;
+  return *this;
+}
+
+TimerWheel::TimerWheel ()
+  : m_size (0),
+    m_current (0),
+    m_wakeUpTick (0)
+{
+  NS_LOG_FUNCTION (this);
+  memset (m_slots, 0, sizeof (m_slots));
+  memset (m_bitmap, 0, sizeof (m_bitmap));
+  TimeValue granularity;
+  g_timerWheelGranularity.GetValue (granularity);
+  m_granularity = granularity.Get ().GetTimeStep ();
+  if (m_granularity == 0)
+    {
+      m_granularity = 1;
+    }
+}
+
+TimerWheel::~TimerWheel ()
+{
+  NS_LOG_FUNCTION (this);
+  // the timers which outlive the wheel must not try to remove themselves
+  // from it.
+  for (uint32_t i = 0; i < LEVELS * SLOTS; i++)
+    {
+      Entry *entry = m_slots[i];
+      while (entry != 0)
+        {
+          Entry *next = entry->next;
+          entry->next = 0;
+          entry->pprev = 0;
+          entry->wheel = 0;
+          entry = next;
+        }
+      m_slots[i] = 0;
+    }
+  for (std::map<uint32_t, Entry *>::iterator i = m_pending.begin (); i != m_pending.end (); i++)
+    {
+      Entry *entry = i->second;
+      while (entry != 0)
+        {
+          Entry *next = entry->next;
+          entry->next = 0;
+          entry->pprev = 0;
+          entry->wheel = 0;
+          entry = next;
+        }
+    }
+  m_pending.clear ();
+}
+
+void
+TimerWheel::Link (Entry *entry, uint32_t slot)
+{
+  entry->next = m_slots[slot];
+  if (entry->next != 0)
+    {
+      entry->next->pprev = &entry->next;
+    }
+  entry->pprev = &m_slots[slot];
+  m_slots[slot] = entry;
+  entry->slot = slot;
+  entry->wheel = this;
+  m_bitmap[slot / 64] |= (1ULL << (slot % 64));
+  m_size++;
+}
+
+void
+TimerWheel::Unlink (Entry *entry)
+{
+  *entry->pprev = entry->next;
+  if (entry->next != 0)
+    {
+      entry->next->pprev = entry->pprev;
+    }
+  entry->next = 0;
+  entry->pprev = 0;
+  entry->wheel = 0;
+  if (entry->slot == PENDING)
+    {
+      return;
+    }
+  if (m_slots[entry->slot] == 0)
+    {
+      m_bitmap[entry->slot / 64] &= ~(1ULL << (entry->slot % 64));
+    }
+  m_size--;
+}
+
+bool
+TimerWheel::IsLinked (const Entry *entry)
+{
+  return entry->pprev != 0;
+}
+
+void
+TimerWheel::Remove (Entry *entry)
+{
+  NS_ASSERT (IsLinked (entry));
+  entry->wheel->Unlink (entry);
+}
+
+uint64_t
+TimerWheel::GetSlotStart (uint32_t level, uint32_t index) const
+{
+  uint32_t shift = level * SLOT_BITS;
+  uint64_t above = (m_current >> shift >> SLOT_BITS) << SLOT_BITS;
+  return (above | index) << shift;
+}
+
+bool
+TimerWheel::FindNext (uint64_t *tick) const
+{
+  bool found = false;
+  for (uint32_t level = 0; level < LEVELS; level++)
+    {
+      uint32_t index = (m_current >> (level * SLOT_BITS)) & (SLOTS - 1);
+      const uint64_t *bitmap = &m_bitmap[level * WORDS];
+      // the slots before the current one are empty: all the entries are
+      // later than the current tick.
+      for (uint32_t word = index / 64; word < WORDS; word++)
+        {
+          uint64_t bits = bitmap[word];
+          if (word == index / 64)
+            {
+              bits &= ~0ULL << (index % 64);
+            }
+          if (bits != 0)
+            {
+              uint64_t start = GetSlotStart (level, word * 64 + __builtin_ctzll (bits));
+              if (!found || start < *tick)
+                {
+                  *tick = start;
+                  found = true;
+                }
+              break;
+            }
+        }
+    }
+  return found;
+}
+
+void
+TimerWheel::Insert (Entry *entry)
+{
+  NS_LOG_FUNCTION (this << entry->ts << entry->context);
+  NS_ASSERT (!IsLinked (entry));
+  uint64_t now = Simulator::Now ().GetTimeStep ();
+  NS_ASSERT (entry->ts >= now);
+  uint64_t tick = entry->ts / m_granularity;
+  uint64_t nowTick = now / m_granularity;
+  if (m_size == 0)
+    {
+      m_current = nowTick;
+    }
+  if (tick <= nowTick)
+    {
+      // the slot of this entry is already due.
+      entry->timer->Post ();
+      return;
+    }
+  // the level is that of the most significant slot index which differs
+  // from that of the current tick.
+  uint64_t diff = tick ^ m_current;
+  uint32_t level = 0;
+  while ((diff >> ((level + 1) * SLOT_BITS)) != 0)
+    {
+      level++;
+      if (level == LEVELS)
+        {
+          // too far in the future to be held in the wheel.
+          entry->timer->Post ();
+          return;
+        }
+    }
+  uint32_t index = (tick >> (level * SLOT_BITS)) & (SLOTS - 1);
+  Link (entry, level * SLOTS + index);
+  uint64_t start = GetSlotStart (level, index);
+  if (!m_wakeUp.IsRunning () || start < m_wakeUpTick)
+    {
+      ScheduleWakeUp ();
+    }
+}
+
+void
+TimerWheel::ScheduleWakeUp (void)
+{
+  uint64_t tick;
+  if (!FindNext (&tick))
+    {
+      return;
+    }
+  if (m_wakeUp.IsRunning ())
+    {
+      if (m_wakeUpTick == tick)
+        {
+          return;
+        }
+      m_wakeUp.Cancel ();
+    }
+  uint64_t now = Simulator::Now ().GetTimeStep ();
+  uint64_t ts = tick * m_granularity;
+  m_wakeUpTick = tick;
+  m_wakeUp = Simulator::Schedule (TimeStep (ts > now ? ts - now : 0), &TimerWheel::WakeUp, this);
+}
+
+void
+TimerWheel::Expire (uint32_t slot)
+{
+  while (m_slots[slot] != 0)
+    {
+      Entry *entry = m_slots[slot];
+      Unlink (entry);
+      if (entry->context == Simulator::GetContext ())
+        {
+          entry->timer->Post ();
+          continue;
+        }
+      // the event of the timer must be scheduled from its own context
+      // to get an EventId.
+      Entry *&head = m_pending[entry->context];
+      if (head == 0)
+        {
+          Simulator::ScheduleWithContext (entry->context, TimeStep (0), &TimerWheel::PostPending, this, entry->context);
+        }
+      entry->next = head;
+      if (entry->next != 0)
+        {
+          entry->next->pprev = &entry->next;
+        }
+      entry->pprev = &head;
+      head = entry;
+      entry->slot = PENDING;
+      entry->wheel = this;
+    }
+}
+
+void
+TimerWheel::PostPending (uint32_t context)
+{
+  NS_LOG_FUNCTION (this << context);
+  Entry *&head = m_pending[context];
+  while (head != 0)
+    {
+      Entry *entry = head;
+      Unlink (entry);
+      entry->timer->Post ();
+    }
+}
+
+void
+TimerWheel::WakeUp (void)
+{
+  NS_LOG_FUNCTION (this);
+  uint64_t nowTick = Simulator::Now ().GetTimeStep () / m_granularity;
+  uint64_t tick;
+  while (FindNext (&tick) && tick <= nowTick)
+    {
+      m_current = tick;
+      // move the entries of the slots which start now to the lower levels.
+      for (uint32_t level = LEVELS - 1; level > 0; level--)
+        {
+          uint32_t slot = level * SLOTS + ((m_current >> (level * SLOT_BITS)) & (SLOTS - 1));
+          while (m_slots[slot] != 0)
+            {
+              Entry *entry = m_slots[slot];
+              Unlink (entry);
+              uint64_t diff = (entry->ts / m_granularity) ^ m_current;
+              uint32_t lower = 0;
+              while ((diff >> ((lower + 1) * SLOT_BITS)) != 0)
+                {
+                  lower++;
+                }
+              NS_ASSERT (lower < level);
+              Link (entry, lower * SLOTS + (((entry->ts / m_granularity) >> (lower * SLOT_BITS)) & (SLOTS - 1)));
+            }
+        }
+      Expire (m_current & (SLOTS - 1));
+    }
+  ScheduleWakeUp ();
+}
+
+} // namespace ns3
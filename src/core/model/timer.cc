@@ -20,15 +20,34 @@
 #include "timer.h"
 #include "simulator.h"
 #include "simulation-singleton.h"
+#include "global-value.h"
+#include "boolean.h"
 
 namespace ns3 {
 
+static GlobalValue g_timerWheel = GlobalValue ("TimerWheel",
+                                               "Hold the timers in a timing wheel rather than in the simulator event list",
+                                               BooleanValue (false),
+                                               MakeBooleanChecker ());
+
+static bool
+UseWheel (void)
+{
+  BooleanValue wheel;
+  g_timerWheel.GetValue (wheel);
+  return wheel.Get ();
+}
+
 Timer::Timer ()
   : m_flags (CHECK_ON_DESTROY),
     m_delay (FemtoSeconds (0)),
     m_event (),
     m_impl (0)
 {
+  if (UseWheel ())
+    {
+      m_flags |= TIMER_WHEEL;
+    }
 }
 
 Timer::Timer (enum DestroyPolicy destroyPolicy)
@@ -37,13 +56,17 @@ Timer::Timer (enum DestroyPolicy destroyPolicy)
     m_event (),
     m_impl (0)
 {
+  if (UseWheel ())
+    {
+      m_flags |= TIMER_WHEEL;
+    }
 }
 
 Timer::~Timer ()
 {
   if (m_flags & CHECK_ON_DESTROY)
     {
-      if (m_event.IsRunning ())
+      if (m_event.IsRunning () || TimerWheel::IsLinked (&m_entry) || m_posted.IsRunning ())
         {
           NS_FATAL_ERROR ("Event is still running while destroying.");
         }
@@ -51,10 +74,12 @@ Timer::~Timer ()
   else if (m_flags & CANCEL_ON_DESTROY)
     {
       m_event.Cancel ();
+      CancelWheel ();
     }
   else if (m_flags & REMOVE_ON_DESTROY)
     {
       Simulator::Remove (m_event);
+      CancelWheel ();
     }
   delete m_impl;
 }
@@ -75,6 +100,10 @@ Timer::GetDelayLeft (void) const
   switch (GetState ())
     {
     case Timer::RUNNING:
+      if (m_flags & TIMER_WHEEL)
+        {
+          return TimeStep (m_entry.ts) - Simulator::Now ();
+        }
       return Simulator::GetDelayLeft (m_event);
       break;
     case Timer::EXPIRED:
@@ -93,21 +122,37 @@ Timer::GetDelayLeft (void) const
 void
 Timer::Cancel (void)
 {
+  if (m_flags & TIMER_WHEEL)
+    {
+      CancelWheel ();
+      return;
+    }
   Simulator::Cancel (m_event);
 }
 void
 Timer::Remove (void)
 {
+  if (m_flags & TIMER_WHEEL)
+    {
+      // the event of a timer which was taken out of the wheel is not
+      // referenced by an EventId: it can only be cancelled.
+      CancelWheel ();
+      return;
+    }
   Simulator::Remove (m_event);
 }
 bool
 Timer::IsExpired (void) const
 {
-  return !IsSuspended () && m_event.IsExpired ();
+  return !IsSuspended () && !IsRunning ();
 }
 bool
 Timer::IsRunning (void) const
 {
+  if (m_flags & TIMER_WHEEL)
+    {
+      return !IsSuspended () && (TimerWheel::IsLinked (&m_entry) || m_posted.IsRunning ());
+    }
   return !IsSuspended () && m_event.IsRunning ();
 }
 bool
@@ -143,6 +188,19 @@ void
 Timer::Schedule (Time delay)
 {
   NS_ASSERT (m_impl != 0);
+  if (m_flags & TIMER_WHEEL)
+    {
+      if (TimerWheel::IsLinked (&m_entry) || m_posted.IsRunning ())
+        {
+          NS_FATAL_ERROR ("Event is still running while re-scheduling.");
+        }
+      NS_ASSERT (!delay.IsStrictlyNegative ());
+      m_entry.ts = (Simulator::Now () + delay).GetTimeStep ();
+      m_entry.context = Simulator::GetContext ();
+      m_entry.timer = this;
+      SimulationSingleton<TimerWheel>::Get ()->Insert (&m_entry);
+      return;
+    }
   if (m_event.IsRunning ())
     {
       NS_FATAL_ERROR ("Event is still running while re-scheduling.");
@@ -154,6 +212,13 @@ void
 Timer::Suspend (void)
 {
   NS_ASSERT (IsRunning ());
+  if (m_flags & TIMER_WHEEL)
+    {
+      m_delayLeft = GetDelayLeft ();
+      CancelWheel ();
+      m_flags |= TIMER_SUSPENDED;
+      return;
+    }
   m_delayLeft = Simulator::GetDelayLeft (m_event);
   Simulator::Remove (m_event);
   m_flags |= TIMER_SUSPENDED;
@@ -163,8 +228,37 @@ void
 Timer::Resume (void)
 {
   NS_ASSERT (m_flags & TIMER_SUSPENDED);
-  m_event = m_impl->Schedule (m_delayLeft);
   m_flags &= ~TIMER_SUSPENDED;
+  if (m_flags & TIMER_WHEEL)
+    {
+      Schedule (m_delayLeft);
+      return;
+    }
+  m_event = m_impl->Schedule (m_delayLeft);
+}
+
+void
+Timer::Post (void)
+{
+  // called by the wheel, in the context of this timer, when it is nearly due.
+  NS_ASSERT (m_entry.context == Simulator::GetContext ());
+  m_posted = Simulator::Schedule (TimeStep (m_entry.ts) - Simulator::Now (), &Timer::Expire, this);
+}
+
+void
+Timer::Expire (void)
+{
+  m_impl->Invoke ();
+}
+
+void
+Timer::CancelWheel (void)
+{
+  if (TimerWheel::IsLinked (&m_entry))
+    {
+      TimerWheel::Remove (&m_entry);
+    }
+  Simulator::Cancel (m_posted);
 }
 
 
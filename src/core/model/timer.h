@@ -23,6 +23,7 @@
 #include "ns3/fatal-error.h"
 #include "nstime.h"
 #include "event-id.h"
+#include "timer-wheel.h"
 #include "ns3/int-to-type.h"
 
 namespace ns3 {
@@ -41,6 +42,14 @@ class TimerImpl;
  * A timer can also be used to enforce a set of predefined event lifetime
  * management policies. These policies are specified at construction time
  * and cannot be changed after.
+ *
+ * When the "TimerWheel" global value is true when a timer is created,
+ * the timer does not schedule a simulator event when it is started but
+ * is held in a TimerWheel until it is nearly due, so that cancelling or
+ * restarting it costs no more than a couple of pointer updates. It
+ * still expires at the exact time it would have expired otherwise,
+ * but the order in which it expires relative to other events
+ * scheduled for the same time may differ.
  */
 class Timer
 {
@@ -230,16 +239,24 @@ public:
   void Resume (void);
 
 private:
+  friend class TimerWheel;
   enum
   {
-    TIMER_SUSPENDED = (1 << 7)
+    TIMER_SUSPENDED = (1 << 7),
+    TIMER_WHEEL = (1 << 8)
   };
+  void Post (void);
+  void Expire (void);
+  void CancelWheel (void);
 
   int m_flags;
   Time m_delay;
   EventId m_event;
   TimerImpl *m_impl;
   Time m_delayLeft;
+  // only used with the timer wheel.
+  TimerWheel::Entry m_entry;
+  EventId m_posted;
 };
 
 } // namespace ns3
@@ -65,6 +65,11 @@ public:
    * \param cb the callback to disconnect from the target trace source.
    */
   virtual bool Disconnect (ObjectBase *obj, std::string context, const CallbackBase &cb) const = 0;
+  /**
+   * \param obj the object instance which contains the target trace source.
+   * \returns true if no callback is connected to the target trace source.
+   */
+  virtual bool IsEmpty (ObjectBase const *obj) const = 0;
 };
 
 /**
@@ -125,6 +130,14 @@ DoMakeTraceSourceAccessor (SOURCE T::*a)
       (p->*m_source).Disconnect (cb, context);
       return true;      
     }
+    virtual bool IsEmpty (ObjectBase const *obj) const {
+      T const *p = dynamic_cast<T const*> (obj);
+      if (p == 0)
+	{
+	  return true;
+	}
+      return (p->*m_source).IsEmpty ();
+    }
     SOURCE T::*m_source;
   } *accessor = new Accessor ();
   accessor->m_source = a;
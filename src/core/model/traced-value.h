@@ -87,6 +87,9 @@ public:
   void Disconnect (const CallbackBase &cb, std::string path) {
     m_cb.Disconnect (cb, path);
   }
+  bool IsEmpty (void) const {
+    return m_cb.IsEmpty ();
+  }
   void Set (const T &v) {
     if (m_v != v)
       {
@@ -41,6 +41,7 @@ public:
   uint16_t GetUid (std::string name) const;
   std::string GetName (uint16_t uid) const;
   uint16_t GetParent (uint16_t uid) const;
+  bool IsChildOf (uint16_t uid, uint16_t ancestor);
   std::string GetGroupName (uint16_t uid) const;
   ns3::Callback<ns3::ObjectBase *> GetConstructor (uint16_t uid) const;
   bool HasConstructor (uint16_t uid) const;
@@ -96,15 +97,21 @@ private:
     bool mustHideFromDocumentation;
     std::vector<struct AttributeInformation> attributes;
     std::vector<struct TraceSourceInformation> traceSources;
+    // one bit per uid, set for each ancestor of this TypeId. It is
+    // computed on demand, and again after any SetParent.
+    std::vector<uint32_t> ancestors;
+    uint32_t ancestorsGeneration;
   };
   typedef std::vector<struct IidInformation>::const_iterator Iterator;
 
   struct IidManager::IidInformation *LookupInformation (uint16_t uid) const;
 
   std::vector<struct IidInformation> m_information;
+  uint32_t m_generation;
 };
 
 IidManager::IidManager ()
+  : m_generation (1)
 {}
 
 uint16_t 
@@ -126,6 +133,7 @@ IidManager::AllocateUid (std::string name)
   information.groupName = "";
   information.hasConstructor = false;
   information.mustHideFromDocumentation = false;
+  information.ancestorsGeneration = 0;
   m_information.push_back (information);
   uint32_t uid = m_information.size ();
   NS_ASSERT (uid <= 0xffff);
@@ -145,6 +153,8 @@ IidManager::SetParent (uint16_t uid, uint16_t parent)
   NS_ASSERT (parent <= m_information.size ());
   struct IidInformation *information = LookupInformation (uid);
   information->parent = parent;
+  // the ancestors of all the children of uid change too
+  m_generation++;
 }
 void 
 IidManager::SetGroupName (uint16_t uid, std::string groupName)
@@ -198,6 +208,32 @@ IidManager::GetParent (uint16_t uid) const
   struct IidInformation *information = LookupInformation (uid);
   return information->parent;
 }
+bool
+IidManager::IsChildOf (uint16_t uid, uint16_t ancestor)
+{
+  struct IidInformation *information = LookupInformation (uid);
+  if (information->ancestorsGeneration != m_generation)
+    {
+      information->ancestors.clear ();
+      uint16_t current = uid;
+      uint16_t parent = information->parent;
+      while (parent != current && parent != 0)
+        {
+          uint32_t word = parent / 32;
+          if (word >= information->ancestors.size ())
+            {
+              information->ancestors.resize (word + 1, 0);
+            }
+          information->ancestors[word] |= 1U << (parent % 32);
+          current = parent;
+          parent = LookupInformation (current)->parent;
+        }
+      information->ancestorsGeneration = m_generation;
+    }
+  uint32_t word = ancestor / 32;
+  return word < information->ancestors.size () && 
+    ((information->ancestors[word] >> (ancestor % 32)) & 1) != 0;
+}
 std::string 
 IidManager::GetGroupName (uint16_t uid) const
 {
@@ -533,12 +569,8 @@ TypeId::HasParent (void) const
 bool 
 TypeId::IsChildOf (TypeId other) const
 {
-  TypeId tmp = *this;
-  while (tmp != other && tmp != tmp.GetParent ())
-    {
-      tmp = tmp.GetParent ();
-    }
-  return tmp == other && *this != other;
+  return *this != other &&
+    Singleton<IidManager>::Get ()->IsChildOf (m_tid, other.m_tid);
 }
 std::string 
 TypeId::GetGroupName (void) const
@@ -556,6 +556,185 @@ MakeCallbackTemplatesTestCase::DoRun (void)
   that.CheckParentalRights ();
 }
 
+// ===========================================================================
+// Test the copies of Callbacks stored inline or on the heap
+// ===========================================================================
+class CallbackCopyTarget : public SimpleRefCount<CallbackCopyTarget>
+{
+public:
+  CallbackCopyTarget () : m_calls (0) {}
+  int Target (int a) {m_calls++; return a;}
+  uint32_t m_calls;
+};
+
+// too large to be stored within a Callback
+struct CallbackLargeArgument
+{
+  double values[16];
+  bool operator != (const CallbackLargeArgument &o) const {return values[0] != o.values[0];}
+};
+
+static int
+CallbackCopyLarge (CallbackLargeArgument a, int b)
+{
+  return (int)a.values[0] + b;
+}
+
+static int
+CallbackTestFunction (int a, int b)
+{
+  return a + b;
+}
+
+class CallbackCopyTestCase : public TestCase
+{
+public:
+  CallbackCopyTestCase ();
+  virtual ~CallbackCopyTestCase () {}
+
+private:
+  virtual void DoRun (void);
+};
+
+CallbackCopyTestCase::CallbackCopyTestCase ()
+  : TestCase ("Check copies, assignments and comparisons of Callbacks")
+{
+}
+
+void
+CallbackCopyTestCase::DoRun (void)
+{
+  Ptr<CallbackCopyTarget> target = Create<CallbackCopyTarget> ();
+  {
+    Callback<int, int> a = MakeCallback (&CallbackCopyTarget::Target, target);
+    NS_TEST_ASSERT_MSG_EQ (target->GetReferenceCount (), 2, "Callback does not hold its object");
+    Callback<int, int> b = a;
+    Callback<int, int> c;
+    c = b;
+    NS_TEST_ASSERT_MSG_EQ (target->GetReferenceCount (), 4, "Callback copies do not hold their object");
+    NS_TEST_ASSERT_MSG_EQ (a.IsEqual (b), true, "Callback copy is not equal to its original");
+    NS_TEST_ASSERT_MSG_EQ (c.IsEqual (a), true, "Assigned Callback is not equal to its original");
+    NS_TEST_ASSERT_MSG_EQ (c (3), 3, "Assigned Callback returns a wrong value");
+    NS_TEST_ASSERT_MSG_EQ (target->m_calls, 1, "Assigned Callback not called");
+
+    CallbackBase base = c;
+    Callback<int, int> d;
+    NS_TEST_ASSERT_MSG_EQ (d.CheckType (base), true, "Callback type check failed");
+    d.Assign (base);
+    NS_TEST_ASSERT_MSG_EQ (d.IsEqual (a), true, "Callback assigned from CallbackBase is not equal");
+    NS_TEST_ASSERT_MSG_EQ (base.GetImpl () != 0, true, "Callback has no implementation");
+    Callback<int, int> other = MakeCallback (&CallbackCopyTarget::Target, Create<CallbackCopyTarget> ());
+    NS_TEST_ASSERT_MSG_EQ (other.IsEqual (a), false, "Callbacks to two objects are equal");
+    c.Nullify ();
+    NS_TEST_ASSERT_MSG_EQ (target->GetReferenceCount (), 5, "Nullified Callback still holds its object");
+  }
+  NS_TEST_ASSERT_MSG_EQ (target->GetReferenceCount (), 1, "Destroyed Callbacks still hold their object");
+
+  CallbackLargeArgument large;
+  large.values[0] = 2;
+  Callback<int, int> e = MakeBoundCallback (&CallbackCopyLarge, large);
+  Callback<int, int> f = e;
+  NS_TEST_ASSERT_MSG_EQ (f (1), 3, "Large bound Callback returns a wrong value");
+  NS_TEST_ASSERT_MSG_EQ (f.IsEqual (e), true, "Large Callback copy is not equal to its original");
+
+  Callback<int, int, int> g = MakeCallback (&CallbackTestFunction);
+  Callback<int, int> h = g.Bind (4);
+  Callback<int, int> i = h;
+  NS_TEST_ASSERT_MSG_EQ (i (5), 9, "Bound Callback copy returns a wrong value");
+  NS_TEST_ASSERT_MSG_EQ (i.IsEqual (h), true, "Bound Callback copy is not equal to its original");
+}
+
+// ===========================================================================
+// Performance test cases: the test runner reports the time it takes to
+// create, copy and invoke many Callbacks.
+// ===========================================================================
+class CallbackCreatePerformanceTestCase : public TestCase
+{
+public:
+  CallbackCreatePerformanceTestCase ();
+  virtual ~CallbackCreatePerformanceTestCase () {}
+
+private:
+  virtual void DoRun (void);
+};
+
+CallbackCreatePerformanceTestCase::CallbackCreatePerformanceTestCase ()
+  : TestCase ("Time the creation of 1000000 member and bound Callbacks")
+{
+}
+
+void
+CallbackCreatePerformanceTestCase::DoRun (void)
+{
+  Ptr<CallbackCopyTarget> target = Create<CallbackCopyTarget> ();
+  uint32_t nonNull = 0;
+  for (uint32_t i = 0; i < 500000; i++)
+    {
+      Callback<int, int> a = MakeCallback (&CallbackCopyTarget::Target, target);
+      Callback<int, int> b = MakeBoundCallback (&CallbackTestFunction, (int)i);
+      nonNull += !a.IsNull ();
+      nonNull += !b.IsNull ();
+    }
+  NS_TEST_ASSERT_MSG_EQ (nonNull, 1000000, "Null Callback created");
+}
+
+class CallbackCopyPerformanceTestCase : public TestCase
+{
+public:
+  CallbackCopyPerformanceTestCase ();
+  virtual ~CallbackCopyPerformanceTestCase () {}
+
+private:
+  virtual void DoRun (void);
+};
+
+CallbackCopyPerformanceTestCase::CallbackCopyPerformanceTestCase ()
+  : TestCase ("Time 1000000 copies and comparisons of Callbacks")
+{
+}
+
+void
+CallbackCopyPerformanceTestCase::DoRun (void)
+{
+  Ptr<CallbackCopyTarget> target = Create<CallbackCopyTarget> ();
+  Callback<int, int> a = MakeCallback (&CallbackCopyTarget::Target, target);
+  uint32_t equal = 0;
+  for (uint32_t i = 0; i < 1000000; i++)
+    {
+      Callback<int, int> b = a;
+      equal += b.IsEqual (a);
+    }
+  NS_TEST_ASSERT_MSG_EQ (equal, 1000000, "Callback copy is not equal to its original");
+}
+
+class CallbackInvokePerformanceTestCase : public TestCase
+{
+public:
+  CallbackInvokePerformanceTestCase ();
+  virtual ~CallbackInvokePerformanceTestCase () {}
+
+private:
+  virtual void DoRun (void);
+};
+
+CallbackInvokePerformanceTestCase::CallbackInvokePerformanceTestCase ()
+  : TestCase ("Time 10000000 invocations of a Callback")
+{
+}
+
+void
+CallbackInvokePerformanceTestCase::DoRun (void)
+{
+  Ptr<CallbackCopyTarget> target = Create<CallbackCopyTarget> ();
+  Callback<int, int> a = MakeCallback (&CallbackCopyTarget::Target, target);
+  int sum = 0;
+  for (uint32_t i = 0; i < 10000000; i++)
+    {
+      sum += a (1);
+    }
+  NS_TEST_ASSERT_MSG_EQ (sum, 10000000, "Callback returns a wrong value");
+}
+
 // ===========================================================================
 // The Test Suite that glues all of the Test Cases together.
 // ===========================================================================
@@ -573,8 +752,25 @@ CallbackTestSuite::CallbackTestSuite ()
   AddTestCase (new MakeBoundCallbackTestCase);
   AddTestCase (new NullifyCallbackTestCase);
   AddTestCase (new MakeCallbackTemplatesTestCase);
+  AddTestCase (new CallbackCopyTestCase);
 }
 
 static CallbackTestSuite CallbackTestSuite;
 
+class CallbackPerformanceTestSuite : public TestSuite
+{
+public:
+  CallbackPerformanceTestSuite ();
+};
+
+CallbackPerformanceTestSuite::CallbackPerformanceTestSuite ()
+  : TestSuite ("callback-performance", PERFORMANCE)
+{
+  AddTestCase (new CallbackCreatePerformanceTestCase);
+  AddTestCase (new CallbackCopyPerformanceTestCase);
+  AddTestCase (new CallbackInvokePerformanceTestCase);
+}
+
+static CallbackPerformanceTestSuite callbackPerformanceTestSuite;
+
 } // namespace
@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/core-config.h"
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include <sstream>
+#include <string>
+#ifdef HAVE_PTHREAD_H
+#include <unistd.h>
+#include "ns3/system-thread.h"
+#endif
+
+#ifdef NS3_LOG_ENABLE
+
+NS_LOG_COMPONENT_DEFINE ("LogTest");
+
+namespace masked {
+
+NS_LOG_COMPONENT_DEFINE_MASK ("LogTestMasked", ns3::LOG_LEVEL_WARN);
+
+static void
+Log (void)
+{
+  NS_LOG_WARN ("masked warn");
+  NS_LOG_INFO ("masked info");
+}
+
+} // namespace masked
+
+namespace ns3 {
+
+/**
+ * Capture what the log messages write to std::clog.
+ */
+class LogCapture
+{
+public:
+  LogCapture ();
+  ~LogCapture ();
+  std::string Get (void) const;
+private:
+  std::ostringstream m_os;
+  std::streambuf *m_clog;
+};
+
+LogCapture::LogCapture ()
+{
+  m_clog = std::clog.rdbuf (m_os.rdbuf ());
+}
+
+LogCapture::~LogCapture ()
+{
+  std::clog.rdbuf (m_clog);
+}
+
+std::string
+LogCapture::Get (void) const
+{
+  return m_os.str ();
+}
+
+class LogAsyncTestCase : public TestCase
+{
+public:
+  LogAsyncTestCase ();
+  virtual void DoRun (void);
+};
+
+LogAsyncTestCase::LogAsyncTestCase ()
+  : TestCase ("Check that asynchronous log messages are all written in order")
+{}
+
+void
+LogAsyncTestCase::DoRun (void)
+{
+  std::ostringstream expected;
+  std::string output;
+  {
+    LogCapture capture;
+    LogComponentEnable ("LogTest", LOG_INFO);
+    LogEnableAsync ();
+    // more messages than the queue of the background thread holds.
+    for (uint32_t i = 0; i < 10000; i++)
+      {
+        NS_LOG_INFO ("message " << i);
+        expected << "message " << i << std::endl;
+        if (i == 5000)
+          {
+            LogFlush ();
+            NS_TEST_EXPECT_MSG_EQ (capture.Get (), expected.str (), "Flushed messages not written");
+          }
+      }
+    LogDisableAsync ();
+    LogComponentDisable ("LogTest", LOG_INFO);
+    output = capture.Get ();
+  }
+  NS_TEST_ASSERT_MSG_EQ (output, expected.str (), "Asynchronous messages lost or reordered");
+}
+
+#ifdef HAVE_PTHREAD_H
+class LogAsyncDisableTestCase : public TestCase
+{
+public:
+  LogAsyncDisableTestCase ();
+  virtual void DoRun (void);
+  void Log (void);
+};
+
+LogAsyncDisableTestCase::LogAsyncDisableTestCase ()
+  : TestCase ("Check that disabling asynchronous logging loses no message of the other threads")
+{}
+
+void
+LogAsyncDisableTestCase::Log (void)
+{
+  for (uint32_t i = 0; i < 100000; i++)
+    {
+      NS_LOG_INFO ("message " << i);
+    }
+}
+
+void
+LogAsyncDisableTestCase::DoRun (void)
+{
+  std::ostringstream expected;
+  for (uint32_t i = 0; i < 100000; i++)
+    {
+      expected << "message " << i << std::endl;
+    }
+  std::string output;
+  {
+    LogCapture capture;
+    LogComponentEnable ("LogTest", LOG_INFO);
+    LogEnableAsync ();
+    Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&LogAsyncDisableTestCase::Log, this));
+    thread->Start ();
+    // disable while the other thread logs: its next messages are
+    // written synchronously, after the queued ones.
+    usleep (1000);
+    LogDisableAsync ();
+    thread->Join ();
+    LogComponentDisable ("LogTest", LOG_INFO);
+    output = capture.Get ();
+  }
+  NS_TEST_ASSERT_MSG_EQ (output, expected.str (), "Messages lost or reordered while disabling");
+}
+#endif /* HAVE_PTHREAD_H */
+
+class LogMaskTestCase : public TestCase
+{
+public:
+  LogMaskTestCase ();
+  virtual void DoRun (void);
+};
+
+LogMaskTestCase::LogMaskTestCase ()
+  : TestCase ("Check that NS_LOG_COMPONENT_DEFINE_MASK removes the other levels")
+{}
+
+void
+LogMaskTestCase::DoRun (void)
+{
+  std::string output;
+  {
+    LogCapture capture;
+    LogComponentEnable ("LogTestMasked", LOG_LEVEL_INFO);
+    masked::Log ();
+    LogComponentDisable ("LogTestMasked", LOG_LEVEL_INFO);
+    output = capture.Get ();
+  }
+  NS_TEST_ASSERT_MSG_EQ (output, "masked warn\n", "Masked log level not removed");
+}
+
+class LogTestSuite : public TestSuite
+{
+public:
+  LogTestSuite ();
+};
+
+LogTestSuite::LogTestSuite ()
+  : TestSuite ("log", UNIT)
+{
+  AddTestCase (new LogAsyncTestCase);
+#ifdef HAVE_PTHREAD_H
+  AddTestCase (new LogAsyncDisableTestCase);
+#endif
+  AddTestCase (new LogMaskTestCase);
+}
+
+static LogTestSuite logTestSuite;
+
+} // namespace ns3
+
+#endif /* NS3_LOG_ENABLE */
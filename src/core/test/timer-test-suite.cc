@@ -20,7 +20,11 @@
 #include "ns3/timer.h"
 #include "ns3/test.h"
 #include "ns3/simulator.h"
+#include "ns3/default-simulator-impl.h"
 #include "ns3/nstime.h"
+#include "ns3/global-value.h"
+#include "ns3/boolean.h"
+#include <vector>
 
 namespace {
 void bari (int)
@@ -217,6 +221,173 @@ TimerTemplateTestCase::DoTeardown (void)
   Simulator::Destroy ();
 }
 
+class TimerWheelTestCase : public TestCase
+{
+public:
+  TimerWheelTestCase ();
+  virtual void DoRun (void);
+  void Start (void);
+  void Restart (uint32_t i);
+  void Arm (uint32_t i, Time delay);
+  void Fire (uint32_t i);
+  Time GetDelay (uint32_t i, uint32_t round) const;
+
+  std::vector<Timer *> m_timers;
+  std::vector<Time> m_expected;
+  std::vector<uint32_t> m_fired;
+  uint32_t m_badTime;
+  uint32_t m_badContext;
+  uint32_t m_badDelayLeft;
+};
+
+static const uint32_t N_TIMERS = 300;
+
+TimerWheelTestCase::TimerWheelTestCase ()
+  : TestCase ("Check that the timers held in the timer wheel expire at the right time")
+{
+}
+
+Time
+TimerWheelTestCase::GetDelay (uint32_t i, uint32_t round) const
+{
+  uint64_t v = (i + 1) * 2654435761U + round * 40503;
+  switch (i % 6)
+    {
+    case 0:
+      // within the current slot.
+      return NanoSeconds (v % 1000000);
+    case 1:
+      // within the first level.
+      return MicroSeconds (v % 256000);
+    case 2:
+      // within the second level.
+      return MicroSeconds (v % 65536000);
+    case 3:
+      return Seconds (v % 100000);
+    case 4:
+      // beyond the last level.
+      return Seconds (5000000 + v % 1000);
+    default:
+      // on a slot boundary.
+      return MilliSeconds (v % 1024);
+    }
+}
+
+void
+TimerWheelTestCase::Fire (uint32_t i)
+{
+  m_fired[i]++;
+  if (Simulator::Now () != m_expected[i])
+    {
+      m_badTime++;
+    }
+  if (Simulator::GetContext () != i)
+    {
+      m_badContext++;
+    }
+}
+
+void
+TimerWheelTestCase::Start (void)
+{
+  for (uint32_t i = 0; i < N_TIMERS; i++)
+    {
+      m_timers[i]->SetArguments (i);
+      m_expected[i] = Simulator::Now () + GetDelay (i, 0);
+      Simulator::ScheduleWithContext (i, Seconds (0), &TimerWheelTestCase::Arm, this, i, GetDelay (i, 0));
+      Simulator::ScheduleWithContext (i, MicroSeconds (1500), &TimerWheelTestCase::Restart, this, i);
+    }
+}
+
+void
+TimerWheelTestCase::Arm (uint32_t i, Time delay)
+{
+  m_timers[i]->Schedule (delay);
+}
+
+void
+TimerWheelTestCase::Restart (uint32_t i)
+{
+  if (m_fired[i] != 0)
+    {
+      return;
+    }
+  if (m_timers[i]->GetDelayLeft () != m_expected[i] - Simulator::Now ())
+    {
+      m_badDelayLeft++;
+    }
+  // restart some timers many times, cancel some others.
+  for (uint32_t round = 1; round < 1 + i % 5; round++)
+    {
+      m_timers[i]->Cancel ();
+      m_expected[i] = Simulator::Now () + GetDelay (i, round);
+      m_timers[i]->Schedule (GetDelay (i, round));
+    }
+  if (i % 7 == 0)
+    {
+      m_timers[i]->Cancel ();
+      m_expected[i] = Seconds (-1);
+    }
+}
+
+void
+TimerWheelTestCase::DoRun (void)
+{
+  Simulator::Destroy ();
+  Ptr<DefaultSimulatorImpl> impl = CreateObject<DefaultSimulatorImpl> ();
+  Simulator::SetImplementation (impl);
+  GlobalValue::Bind ("TimerWheel", BooleanValue (true));
+  m_timers.resize (N_TIMERS);
+  m_expected.resize (N_TIMERS);
+  m_fired.assign (N_TIMERS, 0);
+  m_badTime = 0;
+  m_badContext = 0;
+  m_badDelayLeft = 0;
+  for (uint32_t i = 0; i < N_TIMERS; i++)
+    {
+      m_timers[i] = new Timer (Timer::CANCEL_ON_DESTROY);
+      m_timers[i]->SetFunction (&TimerWheelTestCase::Fire, this);
+    }
+
+  Timer timer = Timer (Timer::CANCEL_ON_DESTROY);
+  timer.SetFunction (&bari);
+  timer.SetArguments (1);
+  timer.Schedule (Seconds (10.0));
+  NS_TEST_EXPECT_MSG_EQ (timer.GetState (), Timer::RUNNING, "");
+  NS_TEST_EXPECT_MSG_EQ (timer.GetDelayLeft (), Seconds (10.0), "");
+  timer.Suspend ();
+  NS_TEST_EXPECT_MSG_EQ (timer.GetState (), Timer::SUSPENDED, "");
+  timer.Resume ();
+  NS_TEST_EXPECT_MSG_EQ (timer.GetState (), Timer::RUNNING, "");
+  timer.Cancel ();
+  NS_TEST_EXPECT_MSG_EQ (timer.GetState (), Timer::EXPIRED, "");
+  // a timer due within the current slot is scheduled in the simulator
+  // right away: cancelling it must be accounted for by the simulator.
+  uint32_t events = impl->GetEventCount ();
+  uint32_t cancelled = impl->GetCancelledEventCount ();
+  timer.Schedule (NanoSeconds (10));
+  NS_TEST_EXPECT_MSG_EQ (impl->GetEventCount (), events + 1, "");
+  timer.Cancel ();
+  NS_TEST_EXPECT_MSG_EQ (timer.GetState (), Timer::EXPIRED, "");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetCancelledEventCount (), cancelled + 1, "The cancelled timer is not accounted for");
+
+  Simulator::Schedule (Seconds (1), &TimerWheelTestCase::Start, this);
+  Simulator::Run ();
+  for (uint32_t i = 0; i < N_TIMERS; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_timers[i]->IsExpired (), true, "Timer " << i << " is still running");
+      NS_TEST_EXPECT_MSG_EQ (m_fired[i], (i % 7 == 0 && m_expected[i].IsStrictlyNegative ()) ? 0 : 1,
+                             "Timer " << i << " expired a wrong number of times");
+      delete m_timers[i];
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_badTime, 0, "Timers expired at the wrong time");
+  NS_TEST_EXPECT_MSG_EQ (m_badContext, 0, "Timers expired in the wrong context");
+  NS_TEST_EXPECT_MSG_EQ (m_badDelayLeft, 0, "Wrong delay left");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetCancelledEventCount (), 0, "All cancelled events should be gone");
+  Simulator::Destroy ();
+  GlobalValue::Bind ("TimerWheel", BooleanValue (false));
+}
+
 static class TimerTestSuite : public TestSuite
 {
 public:
@@ -225,6 +396,7 @@ public:
   {
     AddTestCase (new TimerStateTestCase ());
     AddTestCase (new TimerTemplateTestCase ());
+    AddTestCase (new TimerWheelTestCase ());
   }
 } g_timerTestSuite;
 
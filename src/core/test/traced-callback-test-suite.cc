@@ -108,6 +108,155 @@ BasicTracedCallbackTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_two, true, "Callback CbTwo not called");
 }
 
+class NsTraceTestCase : public TestCase
+{
+public:
+  NsTraceTestCase ();
+  virtual ~NsTraceTestCase () {}
+
+private:
+  virtual void DoRun (void);
+
+  uint8_t Argument (void);
+  void Cb (uint8_t a);
+  void CbConnect (uint8_t a);
+
+  TracedCallback<uint8_t> m_trace;
+  uint32_t m_arguments;
+  uint32_t m_calls;
+};
+
+NsTraceTestCase::NsTraceTestCase ()
+  : TestCase ("Check that NS_TRACE evaluates its arguments only for connected traces")
+{
+}
+
+uint8_t
+NsTraceTestCase::Argument (void)
+{
+  m_arguments++;
+  return 1;
+}
+
+void
+NsTraceTestCase::Cb (uint8_t a)
+{
+  m_calls++;
+}
+
+void
+NsTraceTestCase::CbConnect (uint8_t a)
+{
+  m_calls++;
+  m_trace.ConnectWithoutContext (MakeCallback (&NsTraceTestCase::Cb, this));
+}
+
+void
+NsTraceTestCase::DoRun (void)
+{
+  m_arguments = 0;
+  m_calls = 0;
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), true, "New trace is not empty");
+  NS_TRACE (m_trace, Argument ());
+  NS_TEST_ASSERT_MSG_EQ (m_arguments, 0, "Argument built for an empty trace");
+
+  m_trace.ConnectWithoutContext (MakeCallback (&NsTraceTestCase::Cb, this));
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), false, "Connected trace is empty");
+  NS_TRACE (m_trace, Argument ());
+  NS_TEST_ASSERT_MSG_EQ (m_arguments, 1, "Argument not built once");
+  NS_TEST_ASSERT_MSG_EQ (m_calls, 1, "Callback not called");
+
+  //
+  // A callback connected while the trace fires is called by the same
+  // invocation, after the ones which were connected before.
+  //
+  m_calls = 0;
+  m_trace.ConnectWithoutContext (MakeCallback (&NsTraceTestCase::CbConnect, this));
+  m_trace (1);
+  NS_TEST_ASSERT_MSG_EQ (m_calls, 3, "Callback connected during the trace not called");
+
+  m_trace.DisconnectWithoutContext (MakeCallback (&NsTraceTestCase::Cb, this));
+  m_trace.DisconnectWithoutContext (MakeCallback (&NsTraceTestCase::CbConnect, this));
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), true, "Disconnected trace is not empty");
+}
+
+class ReentrantTracedCallbackTestCase : public TestCase
+{
+public:
+  ReentrantTracedCallbackTestCase ();
+  virtual ~ReentrantTracedCallbackTestCase () {}
+
+  struct Argument
+  {
+    Argument (ReentrantTracedCallbackTestCase *test, uint32_t value);
+    ~Argument ();
+    ReentrantTracedCallbackTestCase *test;
+    uint32_t value;
+  };
+
+private:
+  virtual void DoRun (void);
+
+  static void Connect (const Argument &argument, uint8_t a);
+  void Cb (uint8_t a);
+
+  TracedCallback<uint8_t> m_trace;
+  uint32_t m_value;
+  uint32_t m_calls;
+};
+
+ReentrantTracedCallbackTestCase::Argument::Argument (ReentrantTracedCallbackTestCase *test, uint32_t value)
+  : test (test),
+    value (value)
+{
+}
+
+ReentrantTracedCallbackTestCase::Argument::~Argument ()
+{
+  value = 0;
+}
+
+static bool
+operator != (const ReentrantTracedCallbackTestCase::Argument &a,
+             const ReentrantTracedCallbackTestCase::Argument &b)
+{
+  return a.test != b.test || a.value != b.value;
+}
+
+ReentrantTracedCallbackTestCase::ReentrantTracedCallbackTestCase ()
+  : TestCase ("Check that a callback can connect other callbacks while the trace fires")
+{
+}
+
+void
+ReentrantTracedCallbackTestCase::Connect (const Argument &argument, uint8_t a)
+{
+  // enough callbacks to reallocate the list of callbacks of the trace,
+  // and thus the bound argument of this callback if it was not copied.
+  for (uint32_t i = 0; i < 64; i++)
+    {
+      argument.test->m_trace.ConnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::Cb, argument.test));
+    }
+  argument.test->m_value = argument.value;
+}
+
+void
+ReentrantTracedCallbackTestCase::Cb (uint8_t a)
+{
+  m_calls++;
+}
+
+void
+ReentrantTracedCallbackTestCase::DoRun (void)
+{
+  m_value = 0;
+  m_calls = 0;
+  m_trace.ConnectWithoutContext (MakeBoundCallback (&ReentrantTracedCallbackTestCase::Connect, Argument (this, 42)));
+  m_trace (1);
+  NS_TEST_ASSERT_MSG_EQ (m_value, 42, "The bound argument of the callback was destroyed while it ran");
+  NS_TEST_ASSERT_MSG_EQ (m_calls, 64, "The callbacks connected during the trace were not called");
+}
+
 class TracedCallbackTestSuite : public TestSuite
 {
 public:
@@ -118,6 +267,8 @@ TracedCallbackTestSuite::TracedCallbackTestSuite ()
   : TestSuite ("traced-callback", UNIT)
 {
   AddTestCase (new BasicTracedCallbackTestCase);
+  AddTestCase (new NsTraceTestCase);
+  AddTestCase (new ReentrantTracedCallbackTestCase);
 }
 
 static TracedCallbackTestSuite tracedCallbackTestSuite;
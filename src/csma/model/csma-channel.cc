@@ -222,13 +222,16 @@ CsmaChannel::TransmitEnd()
       if (it->IsActive ())
         {
           // schedule reception events
-          Simulator::ScheduleWithContext (it->devicePtr->GetNode ()->GetId (),
-                                          m_delay,
-                                          &CsmaNetDevice::Receive, it->devicePtr,
-                                          m_currentPkt->Copy (), m_deviceList[m_currentSrc].devicePtr);
+          m_receptions.push_back (BatchEvent (it->devicePtr->GetNode ()->GetId (),
+                                              m_delay,
+                                              MakeEvent (&CsmaNetDevice::Receive, it->devicePtr,
+                                                         m_currentPkt->Copy (),
+                                                         m_deviceList[m_currentSrc].devicePtr)));
         }
       devId++;
     }
+  Simulator::ScheduleWithContextBatch (m_receptions);
+  m_receptions.clear ();
 
   // also schedule for the tx side to go back to IDLE
   Simulator::Schedule (m_delay, &CsmaChannel::PropagationCompleteEvent,
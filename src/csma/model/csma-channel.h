@@ -25,6 +25,7 @@
 #include "ns3/ptr.h"
 #include "ns3/nstime.h"
 #include "ns3/data-rate.h"
+#include "ns3/batch-event.h"
 
 namespace ns3 {
 
@@ -293,6 +294,15 @@ private:
    */
   std::vector<CsmaDeviceRec> m_deviceList;
 
+  /**
+   * Filled by TransmitEnd with one reception event per attached
+   * device, handed to the simulator as a single batch and emptied
+   * again, so that its storage serves all the transmissions. The
+   * receptions are scheduled and not invoked, so TransmitEnd is never
+   * reentered while it fills this vector.
+   */
+  std::vector<BatchEvent> m_receptions;
+
   /**
    * The Packet that is currently being transmitted on the channel (or last
    * packet to have been transmitted on the channel if the channel is
@@ -30,6 +30,7 @@
 #include "ns3/uinteger.h"
 #include "ns3/pointer.h"
 #include "ns3/trace-source-accessor.h"
+#include "ns3/packet-burst.h"
 #include "csma-net-device.h"
 #include "csma-channel.h"
 
@@ -924,6 +925,43 @@ CsmaNetDevice::SendFrom (Ptr<Packet> packet, const Address& src, const Address&
 
   m_macTxTrace (packet);
 
+  return EnqueueOrTransmit (packet);
+}
+
+  bool
+CsmaNetDevice::SendBurst (Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber)
+{
+  NS_LOG_FUNCTION (burst << dest << protocolNumber);
+
+  NS_ASSERT (IsLinkUp ());
+
+  //
+  // Only transmit if send side of net device is enabled
+  //
+  if (IsSendEnabled () == false)
+    {
+      for (std::list<Ptr<Packet> >::const_iterator i = burst->Begin (); i != burst->End (); ++i)
+        {
+          m_macTxDropTrace (*i);
+        }
+      return false;
+    }
+
+  Mac48Address destination = Mac48Address::ConvertFrom (dest);
+  bool ok = true;
+  for (std::list<Ptr<Packet> >::const_iterator i = burst->Begin (); i != burst->End (); ++i)
+    {
+      Ptr<Packet> packet = *i;
+      AddHeader (packet, m_address, destination, protocolNumber);
+      m_macTxTrace (packet);
+      ok = EnqueueOrTransmit (packet) && ok;
+    }
+  return ok;
+}
+
+  bool
+CsmaNetDevice::EnqueueOrTransmit (Ptr<Packet> packet)
+{
   //
   // Place the packet to be sent on the send queue.  Note that the 
   // queue may fire a drop trace, but we will too.
@@ -272,6 +272,16 @@ public:
   virtual bool SendFrom (Ptr<Packet> packet, const Address& source, const Address& dest, 
                          uint16_t protocolNumber);
 
+  /**
+   * Start sending several packets down the channel.
+   * \param burst packets to send, in order
+   * \param dest layer 2 destination address
+   * \param protocolNumber protocol number
+   * \return true if all the packets were accepted, false otherwise
+   */
+  virtual bool SendBurst (Ptr<PacketBurst> burst, const Address& dest, 
+                          uint16_t protocolNumber);
+
   /**
    * Get the node to which this device is attached.
    *
@@ -376,6 +386,15 @@ private:
    */
   void TransmitStart ();
 
+  /**
+   * Place a packet given to the device by the upper layers on the send
+   * queue and start a transmission if the device is idle.
+   *
+   * \param packet packet to send
+   * \return true if successfull, false otherwise (drop, ...)
+   */
+  bool EnqueueOrTransmit (Ptr<Packet> packet);
+
   /**
    * Stop Sending a Packet Down the Wire and Begin the Interframe Gap.
    *
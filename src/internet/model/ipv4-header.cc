@@ -39,7 +39,9 @@ Ipv4Header::Ipv4Header ()
     m_flags (0),
     m_fragmentOffset (0),
     m_checksum(0),
-    m_goodChecksum (true)
+    m_goodChecksum (true),
+    m_checksumValid (false),
+    m_checksumTtl (0)
 {}
 
 void 
@@ -52,6 +54,7 @@ void
 Ipv4Header::SetPayloadSize (uint16_t size)
 {
   m_payloadSize = size;
+  m_checksumValid = false;
 }
 uint16_t 
 Ipv4Header::GetPayloadSize (void) const
@@ -68,6 +71,7 @@ void
 Ipv4Header::SetIdentification (uint16_t identification)
 {
   m_identification = identification;
+  m_checksumValid = false;
 }
 
 
@@ -76,6 +80,7 @@ void
 Ipv4Header::SetTos (uint8_t tos)
 {
   m_tos = tos;
+  m_checksumValid = false;
 }
 uint8_t 
 Ipv4Header::GetTos (void) const
@@ -86,11 +91,13 @@ void
 Ipv4Header::SetMoreFragments (void)
 {
   m_flags |= MORE_FRAGMENTS;
+  m_checksumValid = false;
 }
 void
 Ipv4Header::SetLastFragment (void)
 {
   m_flags &= ~MORE_FRAGMENTS;
+  m_checksumValid = false;
 }
 bool 
 Ipv4Header::IsLastFragment (void) const
@@ -102,11 +109,13 @@ void
 Ipv4Header::SetDontFragment (void)
 {
   m_flags |= DONT_FRAGMENT;
+  m_checksumValid = false;
 }
 void 
 Ipv4Header::SetMayFragment (void)
 {
   m_flags &= ~DONT_FRAGMENT;
+  m_checksumValid = false;
 }
 bool 
 Ipv4Header::IsDontFragment (void) const
@@ -119,6 +128,7 @@ Ipv4Header::SetFragmentOffset (uint16_t offset)
 {
   NS_ASSERT (!(offset & (~0x3fff)));
   m_fragmentOffset = offset;
+  m_checksumValid = false;
 }
 uint16_t 
 Ipv4Header::GetFragmentOffset (void) const
@@ -147,12 +157,14 @@ void
 Ipv4Header::SetProtocol (uint8_t protocol)
 {
   m_protocol = protocol;
+  m_checksumValid = false;
 }
 
 void 
 Ipv4Header::SetSource (Ipv4Address source)
 {
   m_source = source;
+  m_checksumValid = false;
 }
 Ipv4Address
 Ipv4Header::GetSource (void) const
@@ -164,6 +176,7 @@ void
 Ipv4Header::SetDestination (Ipv4Address dst)
 {
   m_destination = dst;
+  m_checksumValid = false;
 }
 Ipv4Address
 Ipv4Header::GetDestination (void) const
@@ -239,12 +252,13 @@ void
 Ipv4Header::Serialize (Buffer::Iterator start) const
 {
   Buffer::Iterator i = start;
+  Buffer::WriteSpan span (i, 5*4);
   
   uint8_t verIhl = (4 << 4) | (5);
-  i.WriteU8 (verIhl);
-  i.WriteU8 (m_tos);
-  i.WriteHtonU16 (m_payloadSize + 5*4);
-  i.WriteHtonU16 (m_identification);
+  span.WriteU8 (verIhl);
+  span.WriteU8 (m_tos);
+  span.WriteHtonU16 (m_payloadSize + 5*4);
+  span.WriteHtonU16 (m_identification);
   uint32_t fragmentOffset = m_fragmentOffset / 8;
   uint8_t flagsFrag = (fragmentOffset >> 8) & 0x1f;
   if (m_flags & DONT_FRAGMENT) 
@@ -255,16 +269,29 @@ Ipv4Header::Serialize (Buffer::Iterator start) const
     {
       flagsFrag |= (1<<5);
     }
-  i.WriteU8 (flagsFrag);
+  span.WriteU8 (flagsFrag);
   uint8_t frag = fragmentOffset & 0xff;
-  i.WriteU8 (frag);
-  i.WriteU8 (m_ttl);
-  i.WriteU8 (m_protocol);
-  i.WriteHtonU16 (0);
-  i.WriteHtonU32 (m_source.Get ());
-  i.WriteHtonU32 (m_destination.Get ());
+  span.WriteU8 (frag);
+  span.WriteU8 (m_ttl);
+  span.WriteU8 (m_protocol);
+  span.WriteHtonU16 (0);
+  span.WriteHtonU32 (m_source.Get ());
+  span.WriteHtonU32 (m_destination.Get ());
 
-  if (m_calcChecksum) 
+  if (m_calcChecksum && m_checksumValid)
+    {
+      // only the ttl changed since the checksum was calculated, as
+      // when a packet is forwarded: it is the low byte of the fifth
+      // word of the header, as read by ReadU16.
+      uint16_t checksum = Buffer::Iterator::UpdateIpChecksum (m_checksum,
+                                                              m_checksumTtl | (m_protocol << 8),
+                                                              m_ttl | (m_protocol << 8));
+      NS_LOG_LOGIC ("checksum=" <<checksum);
+      i = start;
+      i.Next (10);
+      i.WriteU16 (checksum);
+    }
+  else if (m_calcChecksum) 
     {
       i = start;
       uint16_t checksum = i.CalculateIpChecksum(20);
@@ -278,15 +305,16 @@ uint32_t
 Ipv4Header::Deserialize (Buffer::Iterator start)
 {
   Buffer::Iterator i = start;
-  uint8_t verIhl = i.ReadU8 ();
+  Buffer::ReadSpan span (i, 5*4);
+  uint8_t verIhl = span.ReadU8 ();
   uint8_t ihl = verIhl & 0x0f; 
   uint16_t headerSize = ihl * 4;
   NS_ASSERT ((verIhl >> 4) == 4);
-  m_tos = i.ReadU8 ();
-  uint16_t size = i.ReadNtohU16 ();
+  m_tos = span.ReadU8 ();
+  uint16_t size = span.ReadNtohU16 ();
   m_payloadSize = size - headerSize;
-  m_identification = i.ReadNtohU16 ();
-  uint8_t flags = i.ReadU8 ();
+  m_identification = span.ReadNtohU16 ();
+  uint8_t flags = span.ReadU8 ();
   m_flags = 0;
   if (flags & (1<<6)) 
     {
@@ -296,17 +324,15 @@ Ipv4Header::Deserialize (Buffer::Iterator start)
     {
       m_flags |= MORE_FRAGMENTS;
     }
-  i.Prev ();
-  m_fragmentOffset = i.ReadU8 () & 0x1f;
-  m_fragmentOffset <<= 8;
-  m_fragmentOffset |= i.ReadU8 ();
-  m_fragmentOffset <<= 3;
-  m_ttl = i.ReadU8 ();
-  m_protocol = i.ReadU8 ();
-  m_checksum = i.ReadU16();
-  /* i.Next (2); // checksum */
-  m_source.Set (i.ReadNtohU32 ());
-  m_destination.Set (i.ReadNtohU32 ());
+  uint16_t rawFragmentOffset = flags & 0x1f;
+  rawFragmentOffset <<= 8;
+  rawFragmentOffset |= span.ReadU8 ();
+  m_fragmentOffset = rawFragmentOffset << 3;
+  m_ttl = span.ReadU8 ();
+  m_protocol = span.ReadU8 ();
+  m_checksum = span.ReadU16();
+  m_source.Set (span.ReadNtohU32 ());
+  m_destination.Set (span.ReadNtohU32 ());
 
   if (m_calcChecksum) 
     {
@@ -315,6 +341,15 @@ Ipv4Header::Deserialize (Buffer::Iterator start)
       NS_LOG_LOGIC ("checksum=" <<checksum);
 
       m_goodChecksum = (checksum == 0);
+      // the checksum can be updated by Serialize only if this header
+      // is serialized again exactly as it was read, but for its ttl.
+      m_checksumValid = m_goodChecksum && headerSize == 20 &&
+        !(flags & (1<<7)) && (m_fragmentOffset >> 3) == rawFragmentOffset;
+      m_checksumTtl = m_ttl;
+    }
+  else
+    {
+      m_checksumValid = false;
     }
   return GetSerializedSize ();
 }
@@ -164,6 +164,11 @@ private:
   Ipv4Address m_destination;
   uint16_t m_checksum;
   bool m_goodChecksum;
+  // true if m_checksum is the checksum of this header, except for
+  // its ttl which was then m_checksumTtl: Serialize can update it
+  // rather than calculate it again.
+  bool m_checksumValid;
+  uint8_t m_checksumTtl;
 };
 
 } // namespace ns3
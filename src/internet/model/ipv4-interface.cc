@@ -27,6 +27,7 @@
 #include "ns3/net-device.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
+#include "ns3/packet-burst.h"
 #include "ns3/node.h"
 #include "ns3/pointer.h"
 
@@ -208,74 +209,112 @@ Ipv4Interface::Send (Ptr<Packet> p, Ipv4Address dest)
       return;
     } 
   // is this packet aimed at a local interface ?
-  for (Ipv4InterfaceAddressListCI i = m_ifaddrs.begin (); i != m_ifaddrs.end (); ++i)
+  if (IsLocal (dest))
     {
-      if (dest == (*i).GetLocal ())
-        {
-          Ptr<Ipv4L3Protocol> ipv4 = m_node->GetObject<Ipv4L3Protocol> ();
-        
-          ipv4->Receive (m_device, p, Ipv4L3Protocol::PROT_NUMBER, 
-                         m_device->GetBroadcast (),
-                         m_device->GetBroadcast (),
-                         NetDevice::PACKET_HOST // note: linux uses PACKET_LOOPBACK here
-                         );
-          return;
-        }
+      Ptr<Ipv4L3Protocol> ipv4 = m_node->GetObject<Ipv4L3Protocol> ();
+    
+      ipv4->Receive (m_device, p, Ipv4L3Protocol::PROT_NUMBER, 
+                     m_device->GetBroadcast (),
+                     m_device->GetBroadcast (),
+                     NetDevice::PACKET_HOST // note: linux uses PACKET_LOOPBACK here
+                     );
+      return;
     }
-  if (m_device->NeedsArp ())
+  Address hardwareDestination;
+  if (Resolve (p, dest, &hardwareDestination))
     {
-      NS_LOG_LOGIC ("Needs ARP" << " " << dest);
-      Ptr<ArpL3Protocol> arp = m_node->GetObject<ArpL3Protocol> ();
-      Address hardwareDestination;
-      bool found = false;
-      if (dest.IsBroadcast ())
-        {
-          NS_LOG_LOGIC ("All-network Broadcast");
-          hardwareDestination = m_device->GetBroadcast ();
-          found = true;
-        }
-      else if (dest.IsMulticast ())
-        {
-          NS_LOG_LOGIC ("IsMulticast");
-          NS_ASSERT_MSG(m_device->IsMulticast (),
-            "ArpIpv4Interface::SendTo (): Sending multicast packet over "
-            "non-multicast device");
+      NS_LOG_LOGIC ("Address Resolved.  Send.");
+      m_device->Send (p, hardwareDestination, 
+                      Ipv4L3Protocol::PROT_NUMBER);
+    }
+}
 
-          hardwareDestination = m_device->GetMulticast(dest);
-          found = true;
+void
+Ipv4Interface::SendBurst (Ptr<PacketBurst> burst, Ipv4Address dest)
+{
+  NS_LOG_FUNCTION (dest << burst->GetNPackets ());
+  if (!IsUp() || burst->GetNPackets () == 0) 
+    {
+      return;
+    }
+  std::list<Ptr<Packet> >::const_iterator i = burst->Begin ();
+  if (burst->GetNPackets () == 1 ||
+      DynamicCast<LoopbackNetDevice> (m_device) ||
+      IsLocal (dest))
+    {
+      for (; i != burst->End (); ++i)
+        {
+          Send (*i, dest);
         }
-      else
+      return;
+    }
+  Address hardwareDestination;
+  if (!Resolve (*i, dest, &hardwareDestination))
+    {
+      // arp keeps the first packet until it resolves the address of
+      // the destination, and so it does for the next ones.
+      for (++i; i != burst->End (); ++i)
         {
-          for (Ipv4InterfaceAddressListCI i = m_ifaddrs.begin (); i != m_ifaddrs.end (); ++i)
-            {
-              if (dest.IsSubnetDirectedBroadcast ((*i).GetMask ()))
-                {
-                  NS_LOG_LOGIC ("Subnetwork Broadcast");
-                  hardwareDestination = m_device->GetBroadcast ();
-                  found = true;
-                  break;
-                }
-            }
-          if (!found)
-            {
-              NS_LOG_LOGIC ("ARP Lookup");
-              found = arp->Lookup (p, dest, m_device, m_cache, &hardwareDestination);
-            }
+          Send (*i, dest);
         }
+      return;
+    }
+  NS_LOG_LOGIC ("Address Resolved.  Send burst.");
+  m_device->SendBurst (burst, hardwareDestination, 
+                       Ipv4L3Protocol::PROT_NUMBER);
+}
 
-      if (found)
+bool
+Ipv4Interface::IsLocal (Ipv4Address dest) const
+{
+  for (Ipv4InterfaceAddressListCI i = m_ifaddrs.begin (); i != m_ifaddrs.end (); ++i)
+    {
+      if (dest == (*i).GetLocal ())
         {
-          NS_LOG_LOGIC ("Address Resolved.  Send.");
-          m_device ->Send (p, hardwareDestination, 
-                              Ipv4L3Protocol::PROT_NUMBER);
+          return true;
         }
     }
-  else
+  return false;
+}
+
+bool
+Ipv4Interface::Resolve (Ptr<Packet> p, Ipv4Address dest, Address *hardwareDestination)
+{
+  if (!m_device->NeedsArp ())
     {
       NS_LOG_LOGIC ("Doesn't need ARP");
-      m_device->Send (p, m_device->GetBroadcast (), 
-                      Ipv4L3Protocol::PROT_NUMBER);
+      *hardwareDestination = m_device->GetBroadcast ();
+      return true;
+    }
+  NS_LOG_LOGIC ("Needs ARP" << " " << dest);
+  if (dest.IsBroadcast ())
+    {
+      NS_LOG_LOGIC ("All-network Broadcast");
+      *hardwareDestination = m_device->GetBroadcast ();
+      return true;
+    }
+  else if (dest.IsMulticast ())
+    {
+      NS_LOG_LOGIC ("IsMulticast");
+      NS_ASSERT_MSG(m_device->IsMulticast (),
+        "ArpIpv4Interface::SendTo (): Sending multicast packet over "
+        "non-multicast device");
+
+      *hardwareDestination = m_device->GetMulticast(dest);
+      return true;
     }
+  for (Ipv4InterfaceAddressListCI i = m_ifaddrs.begin (); i != m_ifaddrs.end (); ++i)
+    {
+      if (dest.IsSubnetDirectedBroadcast ((*i).GetMask ()))
+        {
+          NS_LOG_LOGIC ("Subnetwork Broadcast");
+          *hardwareDestination = m_device->GetBroadcast ();
+          return true;
+        }
+    }
+  NS_LOG_LOGIC ("ARP Lookup");
+  Ptr<ArpL3Protocol> arp = m_node->GetObject<ArpL3Protocol> ();
+  return arp->Lookup (p, dest, m_device, m_cache, hardwareDestination);
 }
 
 uint32_t
@@ -34,6 +34,8 @@ class NetDevice;
 class Packet;
 class Node;
 class ArpCache;
+class PacketBurst;
+class Address;
 
 /**
  * \brief The IPv4 representation of a network interface
@@ -129,6 +131,16 @@ public:
    */ 
   void Send(Ptr<Packet> p, Ipv4Address dest);
 
+  /**
+   * \param burst packets to send, in order
+   * \param dest next hop address of the packets.
+   *
+   * Send the packets of the burst to the same next hop. The hardware
+   * address of the next hop is resolved once, and the packets are then
+   * given to NetDevice::SendBurst.
+   */
+  void SendBurst (Ptr<PacketBurst> burst, Ipv4Address dest);
+
   /**
    * \param address The Ipv4InterfaceAddress to add to the interface
    * \returns true if succeeded
@@ -156,6 +168,17 @@ protected:
   virtual void DoDispose (void);
 private:
   void DoSetup (void);
+  /**
+   * \returns true if dest is one of the addresses of this interface
+   */
+  bool IsLocal (Ipv4Address dest) const;
+  /**
+   * \param p packet the address is resolved for
+   * \param dest next hop address
+   * \param hardwareDestination the resolved hardware address
+   * \returns false if arp keeps p until it resolves dest
+   */
+  bool Resolve (Ptr<Packet> p, Ipv4Address dest, Address *hardwareDestination);
   typedef std::list<Ipv4InterfaceAddress> Ipv4InterfaceAddressList;
   typedef std::list<Ipv4InterfaceAddress>::const_iterator Ipv4InterfaceAddressListCI;
   typedef std::list<Ipv4InterfaceAddress>::iterator Ipv4InterfaceAddressListI;
@@ -19,6 +19,7 @@
 //
 
 #include "ns3/packet.h"
+#include "ns3/packet-burst.h"
 #include "ns3/log.h"
 #include "ns3/callback.h"
 #include "ns3/ipv4-address.h"
@@ -82,7 +83,8 @@ Ipv4L3Protocol::GetTypeId (void)
 }
 
 Ipv4L3Protocol::Ipv4L3Protocol()
-  : m_identification (0)
+  : m_identification (0),
+    m_burstDepth (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -197,6 +199,8 @@ Ipv4L3Protocol::DoDispose (void)
     }
   m_interfaces.clear ();
   m_sockets.clear ();
+  m_burst = 0;
+  m_burstInterface = 0;
   m_node = 0;
   m_routingProtocol = 0;
   Object::DoDispose ();
@@ -431,7 +435,7 @@ Ipv4L3Protocol::Receive( Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t pr
         {
           if (ipv4Interface->IsUp ())
             {
-              m_rxTrace (packet, m_node->GetObject<Ipv4> (), interface);
+              NS_TRACE (m_rxTrace, packet, m_node->GetObject<Ipv4> (), interface);
               break;
             }
           else
@@ -439,7 +443,7 @@ Ipv4L3Protocol::Receive( Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t pr
               NS_LOG_LOGIC ("Dropping received packet -- interface is down");
               Ipv4Header ipHeader;
               packet->RemoveHeader (ipHeader);
-              m_dropTrace (ipHeader, packet, DROP_INTERFACE_DOWN, m_node->GetObject<Ipv4> (), interface);
+              NS_TRACE (m_dropTrace, ipHeader, packet, DROP_INTERFACE_DOWN, m_node->GetObject<Ipv4> (), interface);
               return;
             }
         }
@@ -461,7 +465,7 @@ Ipv4L3Protocol::Receive( Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t pr
   if (!ipHeader.IsChecksumOk ()) 
     {
       NS_LOG_LOGIC ("Dropping received packet -- checksum not ok");
-      m_dropTrace (ipHeader, packet, DROP_BAD_CHECKSUM, m_node->GetObject<Ipv4> (), interface);
+      NS_TRACE (m_dropTrace, ipHeader, packet, DROP_BAD_CHECKSUM, m_node->GetObject<Ipv4> (), interface);
       return;
     }
 
@@ -481,7 +485,7 @@ Ipv4L3Protocol::Receive( Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t pr
   ))
     {
       NS_LOG_WARN ("No route found for forwarding packet.  Drop.");
-      m_dropTrace (ipHeader, packet, DROP_NO_ROUTE, m_node->GetObject<Ipv4> (), interface);
+      NS_TRACE (m_dropTrace, ipHeader, packet, DROP_NO_ROUTE, m_node->GetObject<Ipv4> (), interface);
     }
 
 
@@ -558,8 +562,8 @@ Ipv4L3Protocol::Send (Ptr<Packet> packet,
 
           m_sendOutgoingTrace (ipHeader, packetCopy, ifaceIndex);
           packetCopy->AddHeader (ipHeader);
-          m_txTrace (packetCopy, m_node->GetObject<Ipv4> (), ifaceIndex);
-          outInterface->Send (packetCopy, destination);
+          NS_TRACE (m_txTrace, packetCopy, m_node->GetObject<Ipv4> (), ifaceIndex);
+          SendToInterface (outInterface, packetCopy, destination);
         }
       return;
     }
@@ -582,8 +586,8 @@ Ipv4L3Protocol::Send (Ptr<Packet> packet,
               Ptr<Packet> packetCopy = packet->Copy ();
               m_sendOutgoingTrace (ipHeader, packetCopy, ifaceIndex);
               packetCopy->AddHeader (ipHeader);
-              m_txTrace (packetCopy, m_node->GetObject<Ipv4> (), ifaceIndex);
-              outInterface->Send (packetCopy, destination);
+              NS_TRACE (m_txTrace, packetCopy, m_node->GetObject<Ipv4> (), ifaceIndex);
+              SendToInterface (outInterface, packetCopy, destination);
               return;
             }
         }
@@ -632,7 +636,7 @@ Ipv4L3Protocol::Send (Ptr<Packet> packet,
   else
     {
       NS_LOG_WARN ("No route to host.  Drop.");
-      m_dropTrace (ipHeader, packet, DROP_NO_ROUTE, m_node->GetObject<Ipv4> (), 0);
+      NS_TRACE (m_dropTrace, ipHeader, packet, DROP_NO_ROUTE, m_node->GetObject<Ipv4> (), 0);
     }
 }
 
@@ -675,6 +679,66 @@ Ipv4L3Protocol::BuildHeader (
   return ipHeader;
 }
 
+void
+Ipv4L3Protocol::BeginBurst (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_burstDepth++;
+}
+
+void
+Ipv4L3Protocol::EndBurst (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_burstDepth > 0);
+  m_burstDepth--;
+  if (m_burstDepth == 0)
+    {
+      FlushBurst ();
+    }
+}
+
+void
+Ipv4L3Protocol::SendToInterface (Ptr<Ipv4Interface> outInterface, Ptr<Packet> packet, Ipv4Address nextHop)
+{
+  NS_LOG_FUNCTION (this << outInterface << packet << nextHop);
+  if (m_burstDepth == 0)
+    {
+      outInterface->Send (packet, nextHop);
+      return;
+    }
+  if (m_burst != 0 && 
+      (m_burstInterface != outInterface || m_burstNextHop != nextHop))
+    {
+      FlushBurst ();
+    }
+  if (m_burst == 0)
+    {
+      m_burst = Create<PacketBurst> ();
+      m_burstInterface = outInterface;
+      m_burstNextHop = nextHop;
+    }
+  m_burst->AddPacket (packet);
+}
+
+void
+Ipv4L3Protocol::FlushBurst (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_burst == 0)
+    {
+      return;
+    }
+  // The interface may deliver the packets locally, and the receiver
+  // may start a new burst: detach this one first.
+  Ptr<PacketBurst> burst = m_burst;
+  Ptr<Ipv4Interface> outInterface = m_burstInterface;
+  Ipv4Address nextHop = m_burstNextHop;
+  m_burst = 0;
+  m_burstInterface = 0;
+  outInterface->SendBurst (burst, nextHop);
+}
+
 void
 Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
                              Ptr<Packet> packet,
@@ -685,7 +749,7 @@ Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
   if (route == 0)
     {
       NS_LOG_WARN ("No route to host.  Drop.");
-      m_dropTrace (ipHeader, packet, DROP_NO_ROUTE, m_node->GetObject<Ipv4> (), 0);
+      NS_TRACE (m_dropTrace, ipHeader, packet, DROP_NO_ROUTE, m_node->GetObject<Ipv4> (), 0);
       return;
     }
   packet->AddHeader (ipHeader);
@@ -704,15 +768,15 @@ Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
       if (outInterface->IsUp ())
         {
           NS_LOG_LOGIC ("Send to gateway " << route->GetGateway ());
-          m_txTrace (packet, m_node->GetObject<Ipv4> (), interface);
-          outInterface->Send (packet, route->GetGateway ());
+          NS_TRACE (m_txTrace, packet, m_node->GetObject<Ipv4> (), interface);
+          SendToInterface (outInterface, packet, route->GetGateway ());
         }
       else
         {
           NS_LOG_LOGIC ("Dropping -- outgoing interface is down: " << route->GetGateway ());
           Ipv4Header ipHeader;
           packet->RemoveHeader (ipHeader);
-          m_dropTrace (ipHeader, packet, DROP_INTERFACE_DOWN, m_node->GetObject<Ipv4> (), interface);
+          NS_TRACE (m_dropTrace, ipHeader, packet, DROP_INTERFACE_DOWN, m_node->GetObject<Ipv4> (), interface);
         }
     } 
   else 
@@ -720,15 +784,15 @@ Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
       if (outInterface->IsUp ())
         {
           NS_LOG_LOGIC ("Send to destination " << ipHeader.GetDestination ());
-          m_txTrace (packet, m_node->GetObject<Ipv4> (), interface);
-          outInterface->Send (packet, ipHeader.GetDestination ());
+          NS_TRACE (m_txTrace, packet, m_node->GetObject<Ipv4> (), interface);
+          SendToInterface (outInterface, packet, ipHeader.GetDestination ());
         }
       else
         {
           NS_LOG_LOGIC ("Dropping -- outgoing interface is down: " << ipHeader.GetDestination ());
           Ipv4Header ipHeader;
           packet->RemoveHeader (ipHeader);
-          m_dropTrace (ipHeader, packet, DROP_INTERFACE_DOWN, m_node->GetObject<Ipv4> (), interface);
+          NS_TRACE (m_dropTrace, ipHeader, packet, DROP_INTERFACE_DOWN, m_node->GetObject<Ipv4> (), interface);
         }
     }
 }
@@ -751,7 +815,7 @@ Ipv4L3Protocol::IpMulticastForward (Ptr<Ipv4MulticastRoute> mrtentry, Ptr<const
           if (h.GetTtl () == 0)
             {
               NS_LOG_WARN ("TTL exceeded.  Drop.");
-              m_dropTrace (header, packet, DROP_TTL_EXPIRED, m_node->GetObject<Ipv4> (), i);
+              NS_TRACE (m_dropTrace, header, packet, DROP_TTL_EXPIRED, m_node->GetObject<Ipv4> (), i);
               return;
             }
           NS_LOG_LOGIC ("Forward multicast via interface " << i);
@@ -788,7 +852,7 @@ Ipv4L3Protocol::IpForward (Ptr<Ipv4Route> rtentry, Ptr<const Packet> p, const Ip
           icmp->SendTimeExceededTtl (ipHeader, packet);
         }
       NS_LOG_WARN ("TTL exceeded.  Drop.");
-      m_dropTrace (header, packet, DROP_TTL_EXPIRED, m_node->GetObject<Ipv4> (), interface);
+      NS_TRACE (m_dropTrace, header, packet, DROP_TTL_EXPIRED, m_node->GetObject<Ipv4> (), interface);
       return;
     }
   m_unicastForwardTrace (ipHeader, packet, interface);
@@ -1052,7 +1116,7 @@ Ipv4L3Protocol::RouteInputError (Ptr<const Packet> p, const Ipv4Header & ipHeade
 {
   NS_LOG_FUNCTION (this << p << ipHeader << sockErrno);
   NS_LOG_LOGIC ("Route input failure-- dropping packet to " << ipHeader << " with errno " << sockErrno); 
-  m_dropTrace (ipHeader, p, DROP_ROUTE_ERROR, m_node->GetObject<Ipv4> (), 0);
+  NS_TRACE (m_dropTrace, ipHeader, p, DROP_ROUTE_ERROR, m_node->GetObject<Ipv4> (), 0);
 }
 
 }//namespace ns3
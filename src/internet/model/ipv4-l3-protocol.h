@@ -46,6 +46,7 @@ class Socket;
 class Ipv4RawSocketImpl;
 class Ipv4L4Protocol;
 class Icmpv4L4Protocol;
+class PacketBurst;
 
 
 /**
@@ -171,6 +172,24 @@ public:
    */
   void SendWithHeader (Ptr<Packet> packet, Ipv4Header ipHeader, Ptr<Ipv4Route> route);
 
+  /**
+   * Start to gather the packets sent to the same next hop into a
+   * PacketBurst given at once to the NetDevice (see
+   * NetDevice::SendBurst). Higher-level layers call this method before
+   * they send several packets back-to-back, and EndBurst after the
+   * last one. Calls may be nested: the packets are only given to the
+   * NetDevices when the outermost burst ends.
+   *
+   * The Tx trace of a packet in a burst fires before the NetDevice
+   * sees it.
+   */
+  void BeginBurst (void);
+  /**
+   * Give the packets gathered since the matching BeginBurst to the
+   * NetDevices.
+   */
+  void EndBurst (void);
+
   uint32_t AddInterface (Ptr<NetDevice> device);
   Ptr<Ipv4Interface> GetInterface (uint32_t i) const;
   uint32_t GetNInterfaces (void) const;
@@ -241,6 +260,9 @@ private:
                       Ptr<const Packet> p, 
                       const Ipv4Header &header);
 
+  void SendToInterface (Ptr<Ipv4Interface> outInterface, Ptr<Packet> packet, Ipv4Address nextHop);
+  void FlushBurst (void);
+
   void LocalDeliver (Ptr<const Packet> p, Ipv4Header const&ip, uint32_t iif);
   void RouteInputError (Ptr<const Packet> p, const Ipv4Header & ipHeader, Socket::SocketErrno sockErrno);
 
@@ -261,6 +283,11 @@ private:
   uint16_t m_identification;
   Ptr<Node> m_node;
 
+  uint32_t m_burstDepth;
+  Ptr<PacketBurst> m_burst;
+  Ptr<Ipv4Interface> m_burstInterface;
+  Ipv4Address m_burstNextHop;
+
   TracedCallback<const Ipv4Header &, Ptr<const Packet>, uint32_t> m_sendOutgoingTrace;
   TracedCallback<const Ipv4Header &, Ptr<const Packet>, uint32_t> m_unicastForwardTrace;
   TracedCallback<const Ipv4Header &, Ptr<const Packet>, uint32_t> m_localDeliverTrace;
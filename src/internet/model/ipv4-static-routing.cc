@@ -20,7 +20,7 @@
 
 #define NS_LOG_APPEND_CONTEXT                                   \
     if (m_ipv4 && m_ipv4->GetObject<Node> ()) { \
-      std::clog << Simulator::Now ().GetSeconds () \
+      ns3::LogStream () << Simulator::Now ().GetSeconds () \
       << " [node " << m_ipv4->GetObject<Node> ()->GetId () << "] "; }
 
 #include <iomanip>
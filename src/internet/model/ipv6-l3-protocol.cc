@@ -657,7 +657,7 @@ void Ipv6L3Protocol::Send (Ptr<Packet> packet, Ipv6Address source, Ipv6Address d
   else
     {
       NS_LOG_WARN ("No route to host, drop!");
-      m_dropTrace (hdr, packet, DROP_NO_ROUTE, GetInterfaceForDevice(oif));
+      NS_TRACE (m_dropTrace, hdr, packet, DROP_NO_ROUTE, GetInterfaceForDevice(oif));
     }
 }
 
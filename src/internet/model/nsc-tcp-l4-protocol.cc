@@ -89,7 +89,7 @@ NscInterfaceImpl::gettime(unsigned int *sec, unsigned int *usec)
 
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT                                   \
-  if (m_node) { std::clog << Simulator::Now ().GetSeconds () << " [node " << m_node->GetId () << "] "; } 
+  if (m_node) { ns3::LogStream () << Simulator::Now ().GetSeconds () << " [node " << m_node->GetId () << "] "; } 
 
 TypeId 
 NscTcpL4Protocol::GetTypeId (void)
@@ -206,14 +206,15 @@ uint32_t TcpHeader::GetSerializedSize (void)  const
 void TcpHeader::Serialize (Buffer::Iterator start)  const
 {
   Buffer::Iterator i = start;
-  i.WriteHtonU16 (m_sourcePort);
-  i.WriteHtonU16 (m_destinationPort);
-  i.WriteHtonU32 (m_sequenceNumber.GetValue ());
-  i.WriteHtonU32 (m_ackNumber.GetValue ());
-  i.WriteHtonU16 (m_length << 12 | m_flags); //reserved bits are all zero
-  i.WriteHtonU16 (m_windowSize);
-  i.WriteHtonU16 (0);
-  i.WriteHtonU16 (m_urgentPointer);
+  Buffer::WriteSpan span (i, 20);
+  span.WriteHtonU16 (m_sourcePort);
+  span.WriteHtonU16 (m_destinationPort);
+  span.WriteHtonU32 (m_sequenceNumber.GetValue ());
+  span.WriteHtonU32 (m_ackNumber.GetValue ());
+  span.WriteHtonU16 (m_length << 12 | m_flags); //reserved bits are all zero
+  span.WriteHtonU16 (m_windowSize);
+  span.WriteHtonU16 (0);
+  span.WriteHtonU16 (m_urgentPointer);
 
   if(m_calcChecksum)
   {
@@ -229,16 +230,17 @@ void TcpHeader::Serialize (Buffer::Iterator start)  const
 uint32_t TcpHeader::Deserialize (Buffer::Iterator start)
 {
   Buffer::Iterator i = start;
-  m_sourcePort = i.ReadNtohU16 ();
-  m_destinationPort = i.ReadNtohU16 ();
-  m_sequenceNumber = i.ReadNtohU32 ();
-  m_ackNumber = i.ReadNtohU32 ();
-  uint16_t field = i.ReadNtohU16 ();
+  Buffer::ReadSpan span (i, 20);
+  m_sourcePort = span.ReadNtohU16 ();
+  m_destinationPort = span.ReadNtohU16 ();
+  m_sequenceNumber = span.ReadNtohU32 ();
+  m_ackNumber = span.ReadNtohU32 ();
+  uint16_t field = span.ReadNtohU16 ();
   m_flags = field & 0x3F;
   m_length = field>>12;
-  m_windowSize = i.ReadNtohU16 ();
-  i.Next (2);
-  m_urgentPointer = i.ReadNtohU16 ();
+  m_windowSize = span.ReadNtohU16 ();
+  span.Next (2);
+  m_urgentPointer = span.ReadNtohU16 ();
 
   if(m_calcChecksum)
     {
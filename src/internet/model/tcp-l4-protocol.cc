@@ -52,7 +52,7 @@ NS_OBJECT_ENSURE_REGISTERED (TcpL4Protocol);
 
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT                                   \
-  if (m_node) { std::clog << Simulator::Now ().GetSeconds () << " [node " << m_node->GetId () << "] "; } 
+  if (m_node) { ns3::LogStream () << Simulator::Now ().GetSeconds () << " [node " << m_node->GetId () << "] "; } 
 
 /* see http://www.iana.org/assignments/protocol-numbers */
 const uint8_t TcpL4Protocol::PROT_NUMBER = 6;
@@ -121,6 +121,12 @@ TcpL4Protocol::NotifyNewAggregate ()
               tcpFactory->SetTcp (this);
               node->AggregateObject (tcpFactory);
               this->SetDownTarget (MakeCallback(&Ipv4::Send, ipv4));
+              Ptr<Ipv4L3Protocol> ipv4l3 = DynamicCast<Ipv4L3Protocol> (ipv4);
+              if (ipv4l3 != 0)
+                {
+                  this->SetBurstTarget (MakeCallback (&Ipv4L3Protocol::BeginBurst, ipv4l3),
+                                        MakeCallback (&Ipv4L3Protocol::EndBurst, ipv4l3));
+                }
             }
         }
     }
@@ -151,6 +157,8 @@ TcpL4Protocol::DoDispose (void)
 
   m_node = 0;
   m_downTarget.Nullify ();
+  m_beginBurst.Nullify ();
+  m_endBurst.Nullify ();
   Ipv4L4Protocol::DoDispose ();
 }
 
@@ -393,6 +401,8 @@ void
 TcpL4Protocol::SetDownTarget (Ipv4L4Protocol::DownTargetCallback callback)
 {
   m_downTarget = callback;
+  m_beginBurst.Nullify ();
+  m_endBurst.Nullify ();
 }
 
 Ipv4L4Protocol::DownTargetCallback
@@ -401,5 +411,30 @@ TcpL4Protocol::GetDownTarget (void) const
   return m_downTarget;
 }
 
+void
+TcpL4Protocol::SetBurstTarget (Callback<void> begin, Callback<void> end)
+{
+  m_beginBurst = begin;
+  m_endBurst = end;
+}
+
+void
+TcpL4Protocol::BeginBurst (void)
+{
+  if (!m_beginBurst.IsNull ())
+    {
+      m_beginBurst ();
+    }
+}
+
+void
+TcpL4Protocol::EndBurst (void)
+{
+  if (!m_endBurst.IsNull ())
+    {
+      m_endBurst ();
+    }
+}
+
 }; // namespace ns3
 
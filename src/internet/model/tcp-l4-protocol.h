@@ -106,6 +106,27 @@ public:
   virtual void SetDownTarget (Ipv4L4Protocol::DownTargetCallback cb);
   // From Ipv4L4Protocol
   virtual Ipv4L4Protocol::DownTargetCallback GetDownTarget (void) const;
+  /**
+   * \param begin called before the sockets send several segments
+   *        back-to-back, may be a null callback.
+   * \param end called after they sent them, may be a null callback.
+   *
+   * The down target set from the Ipv4L3Protocol of the node comes
+   * with its BeginBurst and EndBurst methods. SetDownTarget clears
+   * them: call this method afterwards to gather the segments given to
+   * the new down target.
+   */
+  void SetBurstTarget (Callback<void> begin, Callback<void> end);
+  /**
+   * Called by the sockets before they send several segments
+   * back-to-back.
+   */
+  void BeginBurst (void);
+  /**
+   * Called by the sockets after they sent the segments announced by
+   * BeginBurst.
+   */
+  void EndBurst (void);
 
 protected:
   virtual void DoDispose (void);
@@ -128,6 +149,8 @@ private:
 
   std::vector<Ptr<TcpSocketBase> > m_sockets;
   Ipv4L4Protocol::DownTargetCallback m_downTarget;
+  Callback<void> m_beginBurst;
+  Callback<void> m_endBurst;
 };
 
 }; // namespace ns3
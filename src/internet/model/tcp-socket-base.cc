@@ -19,7 +19,7 @@
  */
 
 #define NS_LOG_APPEND_CONTEXT \
-  if (m_node) { std::clog << Simulator::Now ().GetSeconds () << " [node " << m_node->GetId () << "] "; }
+  if (m_node) { ns3::LogStream () << Simulator::Now ().GetSeconds () << " [node " << m_node->GetId () << "] "; }
 
 #include "ns3/abort.h"
 #include "ns3/node.h"
@@ -1274,6 +1274,9 @@ TcpSocketBase::SendPendingData (bool withAck)
       return false; // Is this the right way to handle this condition?
     }
   uint32_t nPacketsSent = 0;
+  bool shutdown = false;
+  // Give the back-to-back segments to the device as one burst
+  m_tcp->BeginBurst ();
   while (m_txBuffer.SizeFromSequence (m_nextTxSequence))
     {
       uint32_t w = AvailableWindow (); // Get available window size
@@ -1289,7 +1292,8 @@ TcpSocketBase::SendPendingData (bool withAck)
       if (m_shutdownSend)
         {
           m_errno = ERROR_SHUTDOWN;
-          return false;
+          shutdown = true;
+          break;
         }
       // Stop sending if we need to wait for a larger Tx window
       if (w < m_segmentSize && m_txBuffer.SizeFromSequence (m_nextTxSequence) > w)
@@ -1348,6 +1352,11 @@ TcpSocketBase::SendPendingData (bool withAck)
       // Update highTxMark
       m_highTxMark = std::max (m_nextTxSequence, m_highTxMark);
     }
+  m_tcp->EndBurst ();
+  if (shutdown)
+    {
+      return false;
+    }
   NS_LOG_LOGIC ("SendPendingData sent " << nPacketsSent << " packets");
   return (nPacketsSent > 0);
 }
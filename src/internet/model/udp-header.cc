@@ -137,11 +137,12 @@ void
 UdpHeader::Serialize (Buffer::Iterator start) const
 {
   Buffer::Iterator i = start;
+  Buffer::WriteSpan span (i, 8);
 
-  i.WriteHtonU16 (m_sourcePort);
-  i.WriteHtonU16 (m_destinationPort);
-  i.WriteHtonU16 (start.GetSize ());
-  i.WriteU16 (0);
+  span.WriteHtonU16 (m_sourcePort);
+  span.WriteHtonU16 (m_destinationPort);
+  span.WriteHtonU16 (start.GetSize ());
+  span.WriteU16 (0);
 
   if (m_calcChecksum)
     {
@@ -158,10 +159,10 @@ uint32_t
 UdpHeader::Deserialize (Buffer::Iterator start)
 {
   Buffer::Iterator i = start;
-  m_sourcePort = i.ReadNtohU16 ();
-  m_destinationPort = i.ReadNtohU16 ();
-  m_payloadSize = i.ReadNtohU16 () - GetSerializedSize ();
-  i.Next (2);
+  Buffer::ReadSpan span (i, 8);
+  m_sourcePort = span.ReadNtohU16 ();
+  m_destinationPort = span.ReadNtohU16 ();
+  m_payloadSize = span.ReadNtohU16 () - GetSerializedSize ();
 
   if(m_calcChecksum)
   {
@@ -29,6 +29,8 @@
 #include "ns3/arp-l3-protocol.h"
 #include "ns3/ipv4-interface.h"
 #include "ns3/loopback-net-device.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/packet.h"
 
 namespace ns3 {
 
@@ -97,6 +99,67 @@ Ipv4L3ProtocolTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class Ipv4HeaderChecksumTestCase : public TestCase
+{
+public:
+  Ipv4HeaderChecksumTestCase ();
+  virtual void DoRun (void);
+};
+
+Ipv4HeaderChecksumTestCase::Ipv4HeaderChecksumTestCase ()
+  : TestCase ("Verify the checksum of forwarded IPv4 headers")
+{
+}
+
+void
+Ipv4HeaderChecksumTestCase::DoRun (void)
+{
+  Ipv4Header header;
+  header.EnableChecksum ();
+  header.SetSource (Ipv4Address ("10.1.1.1"));
+  header.SetDestination (Ipv4Address ("10.1.2.2"));
+  header.SetProtocol (17);
+  header.SetPayloadSize (1000);
+  header.SetIdentification (4242);
+  header.SetTtl (64);
+  header.SetFragmentOffset (1480);
+  header.SetMoreFragments ();
+  Ptr<Packet> p = Create<Packet> (1000);
+  p->AddHeader (header);
+
+  // each hop decrements the ttl and updates the checksum of the header.
+  for (uint32_t hop = 0; hop < 64; hop++)
+    {
+      Ipv4Header forwarded;
+      forwarded.EnableChecksum ();
+      p->RemoveHeader (forwarded);
+      NS_TEST_EXPECT_MSG_EQ (forwarded.IsChecksumOk (), true, "Bad checksum at hop " << hop);
+      NS_TEST_EXPECT_MSG_EQ ((uint32_t)forwarded.GetTtl (), 64 - hop, "Bad ttl at hop " << hop);
+      forwarded.SetTtl (forwarded.GetTtl () - 1);
+      if (hop == 32)
+        {
+          // any other change requires a new checksum.
+          forwarded.SetTos (0x10);
+        }
+      p->AddHeader (forwarded);
+    }
+  Ipv4Header last;
+  last.EnableChecksum ();
+  p->RemoveHeader (last);
+  NS_TEST_EXPECT_MSG_EQ (last.IsChecksumOk (), true, "Bad checksum");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)last.GetTos (), 0x10, "Bad tos");
+
+  // a header which was not verified is not updated.
+  Ipv4Header unchecked;
+  p->AddHeader (header);
+  p->RemoveHeader (unchecked);
+  unchecked.EnableChecksum ();
+  unchecked.SetTtl (1);
+  p->AddHeader (unchecked);
+  p->RemoveHeader (last);
+  NS_TEST_EXPECT_MSG_EQ (last.IsChecksumOk (), true, "Bad checksum");
+}
+
 static class IPv4L3ProtocolTestSuite : public TestSuite
 {
 public:
@@ -104,6 +167,7 @@ public:
     TestSuite ("ipv4-protocol", UNIT)
   {
     AddTestCase (new Ipv4L3ProtocolTestCase ());
+    AddTestCase (new Ipv4HeaderChecksumTestCase ());
   }
 } g_ipv4protocolTestSuite;
 
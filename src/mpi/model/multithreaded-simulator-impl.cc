@@ -0,0 +1,937 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/simulator.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/net-device.h"
+#include "ns3/channel.h"
+#include "ns3/nstime.h"
+#include "ns3/uinteger.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/ptr.h"
+#include "ns3/assert.h"
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <utility>
+#include <pthread.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+static const uint64_t MAX_TS = 0xffffffffffffffffULL;
+
+// Each thread records the partition whose events it is running. The
+// main thread records nothing, which stands for the global partition.
+static pthread_key_t g_currentPartition;
+static pthread_once_t g_currentPartitionOnce = PTHREAD_ONCE_INIT;
+
+static void
+CreateCurrentPartitionKey (void)
+{
+  pthread_key_create (&g_currentPartition, 0);
+}
+
+static uint32_t
+FindComponent (std::vector<uint32_t> &component, uint32_t i)
+{
+  while (component[i] != i)
+    {
+      component[i] = component[component[i]];
+      i = component[i];
+    }
+  return i;
+}
+
+struct MultithreadedSimulatorImpl::Barrier
+{
+  Barrier (uint32_t n);
+  ~Barrier ();
+  void Wait (void);
+
+  pthread_mutex_t m_mutex;
+  pthread_cond_t m_cond;
+  uint32_t m_n;
+  uint32_t m_waiting;
+  uint32_t m_generation;
+};
+
+MultithreadedSimulatorImpl::Barrier::Barrier (uint32_t n)
+  : m_n (n),
+    m_waiting (0),
+    m_generation (0)
+{
+  pthread_mutex_init (&m_mutex, 0);
+  pthread_cond_init (&m_cond, 0);
+}
+
+MultithreadedSimulatorImpl::Barrier::~Barrier ()
+{
+  pthread_mutex_destroy (&m_mutex);
+  pthread_cond_destroy (&m_cond);
+}
+
+void
+MultithreadedSimulatorImpl::Barrier::Wait (void)
+{
+  pthread_mutex_lock (&m_mutex);
+  uint32_t generation = m_generation;
+  m_waiting++;
+  if (m_waiting == m_n)
+    {
+      m_waiting = 0;
+      m_generation++;
+      pthread_cond_broadcast (&m_cond);
+    }
+  else
+    {
+      while (generation == m_generation)
+        {
+          pthread_cond_wait (&m_cond, &m_mutex);
+        }
+    }
+  pthread_mutex_unlock (&m_mutex);
+}
+
+void
+MultithreadedSimulatorImpl::Partition::Loop (void)
+{
+  pthread_setspecific (g_currentPartition, this);
+  while (true)
+    {
+      sim->m_barrier->Wait ();
+      if (sim->m_done)
+        {
+          break;
+        }
+      sim->RunWindow (this);
+      sim->m_barrier->Wait ();
+    }
+}
+
+MultithreadedSimulatorImpl *MultithreadedSimulatorImpl::g_running = 0;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+    .AddAttribute ("MaxThreads",
+                   "The maximum number of threads used to run the simulation. "
+                   "Zero means as many threads as there are processors.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&MultithreadedSimulatorImpl::m_maxThreads),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
+  return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+  pthread_once (&g_currentPartitionOnce, &CreateCurrentPartitionKey);
+  m_stopTs = MAX_TS;
+  m_running = false;
+  m_done = false;
+  m_partitioned = false;
+  m_lookAhead = MAX_TS;
+  m_bound = 0;
+  m_parity = 0;
+  m_barrier = 0;
+  // before ::Run is entered, all events are stored in the global
+  // partition.
+  m_partitions.push_back (CreatePartition (0));
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::CreatePartition (uint32_t id)
+{
+  Partition *partition = new Partition ();
+  partition->sim = this;
+  partition->id = id;
+  partition->events = 0;
+  // uids are allocated from 4.
+  // uid 0 is "invalid" events
+  // uid 1 is "now" events
+  // uid 2 is "destroy" events
+  partition->uid = 4;
+  // before ::Run is entered, the currentUid will be zero
+  partition->currentUid = 0;
+  partition->currentTs = 0;
+  partition->currentContext = 0xffffffff;
+  partition->nextTs = MAX_TS;
+  partition->minSentTs = MAX_TS;
+  partition->stopped = false;
+  return partition;
+}
+
+void
+MultithreadedSimulatorImpl::DeletePartitions (void)
+{
+  for (Partitions::iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+    {
+      Partition *partition = *i;
+      for (uint32_t parity = 0; parity < 2; parity++)
+        {
+          for (uint32_t j = 0; j < partition->outbox[parity].size (); j++)
+            {
+              std::vector<Scheduler::Event> &events = partition->outbox[parity][j];
+              for (uint32_t k = 0; k < events.size (); k++)
+                {
+                  events[k].impl->Unref ();
+                }
+            }
+        }
+      while (partition->events != 0 && !partition->events->IsEmpty ())
+        {
+          Scheduler::Event next = partition->events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      partition->events = 0;
+      partition->thread = 0;
+      delete partition;
+    }
+  m_partitions.clear ();
+  m_partitionOf.clear ();
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  DeletePartitions ();
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  while (!m_destroyEvents.empty ())
+    {
+      Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
+      m_destroyEvents.pop_front ();
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  m_schedulerFactory = schedulerFactory;
+  for (Partitions::iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+    {
+      Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
+      Partition *partition = *i;
+      if (partition->events != 0)
+        {
+          while (!partition->events->IsEmpty ())
+            {
+              Scheduler::Event next = partition->events->RemoveNext ();
+              scheduler->Insert (next);
+            }
+        }
+      partition->events = scheduler;
+    }
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetGlobalPartition (void) const
+{
+  return m_partitions.back ();
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetPartition (uint32_t context) const
+{
+  if (context < m_partitionOf.size ())
+    {
+      return m_partitions[m_partitionOf[context]];
+    }
+  return GetGlobalPartition ();
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetCurrentPartition (void) const
+{
+  Partition *partition = static_cast<Partition *> (pthread_getspecific (g_currentPartition));
+  if (partition == 0 || partition->sim != this)
+    {
+      return GetGlobalPartition ();
+    }
+  return partition;
+}
+
+void
+MultithreadedSimulatorImpl::CreatePartitions (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_partitioned = true;
+
+  // Nodes connected by anything else than a point-to-point channel
+  // with a non-zero delay must be run by the same thread, and so must
+  // the nodes of a channel whose TxRxPointToPoint trace sinks are
+  // given the receiving device by the sending thread.
+  uint32_t nNodes = NodeList::GetNNodes ();
+  std::vector<uint32_t> component (nNodes);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      component[i] = i;
+    }
+  for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); ++i)
+    {
+      Ptr<Node> node = *i;
+      for (uint32_t j = 0; j < node->GetNDevices (); ++j)
+        {
+          Ptr<NetDevice> device = node->GetDevice (j);
+          Ptr<Channel> channel = device->GetChannel ();
+          if (channel == 0)
+            {
+              continue;
+            }
+          TimeValue delay;
+          Ptr<const TraceSourceAccessor> txrx =
+            channel->GetInstanceTypeId ().LookupTraceSourceByName ("TxRxPointToPoint");
+          if (device->IsPointToPoint ()
+              && channel->GetNDevices () == 2
+              && channel->GetAttributeFailSafe ("Delay", delay)
+              && delay.Get ().IsStrictlyPositive ()
+              && (txrx == 0 || txrx->IsEmpty (PeekPointer (channel))))
+            {
+              continue;
+            }
+          for (uint32_t k = 0; k < channel->GetNDevices (); ++k)
+            {
+              uint32_t a = FindComponent (component, node->GetId ());
+              uint32_t b = FindComponent (component, channel->GetDevice (k)->GetNode ()->GetId ());
+              component[a] = b;
+            }
+        }
+    }
+
+  // Assign the largest sets of nodes first, each to the partition
+  // which has the smallest number of nodes.
+  std::vector<uint32_t> size (nNodes, 0);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      size[FindComponent (component, i)]++;
+    }
+  std::vector<std::pair<uint32_t, uint32_t> > components;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      if (size[i] != 0)
+        {
+          components.push_back (std::make_pair (size[i], i));
+        }
+    }
+  std::sort (components.rbegin (), components.rend ());
+
+  uint32_t nThreads = m_maxThreads;
+  if (nThreads == 0)
+    {
+      long nProcessors = sysconf (_SC_NPROCESSORS_ONLN);
+      nThreads = nProcessors > 0 ? nProcessors : 1;
+    }
+  uint32_t nPartitions = std::max<uint32_t> (1, std::min<uint32_t> (nThreads, components.size ()));
+  std::vector<uint32_t> load (nPartitions, 0);
+  std::vector<uint32_t> partitionOfComponent (nNodes, 0);
+  for (uint32_t i = 0; i < components.size (); i++)
+    {
+      uint32_t smallest = std::min_element (load.begin (), load.end ()) - load.begin ();
+      load[smallest] += components[i].first;
+      partitionOfComponent[components[i].second] = smallest;
+    }
+  m_partitionOf.resize (nNodes);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      m_partitionOf[i] = partitionOfComponent[FindComponent (component, i)];
+    }
+
+  CalculateLookAhead ();
+  if (m_lookAhead == 0)
+    {
+      nPartitions = 1;
+      std::fill (m_partitionOf.begin (), m_partitionOf.end (), 0);
+    }
+  NS_LOG_LOGIC ("nodes=" << nNodes << ", partitions=" << nPartitions << ", lookahead=" << m_lookAhead);
+
+  // Create the node partitions, keep the global partition last
+  // and move to the node partitions the events which belong to them.
+  Partition *global = GetGlobalPartition ();
+  m_partitions.clear ();
+  for (uint32_t i = 0; i < nPartitions; i++)
+    {
+      Partition *partition = CreatePartition (i);
+      partition->events = m_schedulerFactory.Create<Scheduler> ();
+      partition->uid = global->uid;
+      partition->currentTs = global->currentTs;
+      m_partitions.push_back (partition);
+    }
+  global->id = nPartitions;
+  m_partitions.push_back (global);
+  for (Partitions::iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+    {
+      (*i)->outbox[0].resize (nPartitions + 1);
+      (*i)->outbox[1].resize (nPartitions + 1);
+    }
+  std::vector<Scheduler::Event> events;
+  while (!global->events->IsEmpty ())
+    {
+      events.push_back (global->events->RemoveNext ());
+    }
+  for (std::vector<Scheduler::Event>::const_iterator i = events.begin (); i != events.end (); i++)
+    {
+      GetPartition (i->key.m_context)->events->Insert (*i);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::CalculateLookAhead (void)
+{
+  m_lookAhead = MAX_TS;
+  for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); ++i)
+    {
+      Ptr<Node> node = *i;
+      for (uint32_t j = 0; j < node->GetNDevices (); ++j)
+        {
+          Ptr<NetDevice> localNetDevice = node->GetDevice (j);
+          // only works for p2p links currently
+          if (!localNetDevice->IsPointToPoint ())
+            {
+              continue;
+            }
+          Ptr<Channel> channel = localNetDevice->GetChannel ();
+          if (channel == 0 || channel->GetNDevices () != 2)
+            {
+              continue;
+            }
+
+          // grab the adjacent node
+          Ptr<Node> remoteNode;
+          if (channel->GetDevice (0) == localNetDevice)
+            {
+              remoteNode = (channel->GetDevice (1))->GetNode ();
+            }
+          else
+            {
+              remoteNode = (channel->GetDevice (0))->GetNode ();
+            }
+
+          // if it's in the same partition, don't consider it
+          if (m_partitionOf[remoteNode->GetId ()] == m_partitionOf[node->GetId ()])
+            {
+              continue;
+            }
+
+          // compare delay on the channel with current value of
+          // m_lookAhead.  if delay on channel is smaller, make
+          // it the new lookAhead.
+          TimeValue delay;
+          channel->GetAttribute ("Delay", delay);
+          if ((uint64_t)delay.Get ().GetTimeStep () < m_lookAhead)
+            {
+              m_lookAhead = delay.Get ().GetTimeStep ();
+            }
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Insert (Partition *from, Partition *to, Scheduler::Event &ev)
+{
+  if (from == to || from == GetGlobalPartition () || !m_running)
+    {
+      // the destination partition is either run by the current thread
+      // or idle.
+      ev.key.m_uid = to->uid;
+      to->uid++;
+      to->events->Insert (ev);
+      if (ev.key.m_ts < to->nextTs)
+        {
+          to->nextTs = ev.key.m_ts;
+        }
+    }
+  else
+    {
+      NS_ABORT_MSG_IF (ev.key.m_ts < m_bound,
+                       "Event for context " << ev.key.m_context << " is scheduled earlier than the lookahead allows");
+      from->outbox[m_parity][to->id].push_back (ev);
+      if (ev.key.m_ts < from->minSentTs)
+        {
+          from->minSentTs = ev.key.m_ts;
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Drain (uint32_t parity, bool all)
+{
+  for (Partitions::iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+    {
+      Partition *from = *i;
+      for (uint32_t j = 0; j < from->outbox[parity].size (); j++)
+        {
+          Partition *to = m_partitions[j];
+          if (!all && to != GetGlobalPartition ())
+            {
+              continue;
+            }
+          std::vector<Scheduler::Event> &events = from->outbox[parity][j];
+          for (std::vector<Scheduler::Event>::iterator k = events.begin (); k != events.end (); k++)
+            {
+              k->key.m_uid = to->uid;
+              to->uid++;
+              to->events->Insert (*k);
+              if (k->key.m_ts < to->nextTs)
+                {
+                  to->nextTs = k->key.m_ts;
+                }
+            }
+          events.clear ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent (Partition *partition)
+{
+  Scheduler::Event next = partition->events->RemoveNext ();
+
+  NS_ASSERT (next.key.m_ts >= partition->currentTs);
+
+  NS_LOG_LOGIC ("handle " << next.key.m_ts);
+  partition->currentTs = next.key.m_ts;
+  partition->currentContext = next.key.m_context;
+  partition->currentUid = next.key.m_uid;
+  next.impl->Invoke ();
+  next.impl->Unref ();
+}
+
+void
+MultithreadedSimulatorImpl::RunWindow (Partition *partition)
+{
+  // merge the events sent to this partition during the previous window,
+  // in the order of the partitions which sent them.
+  uint32_t previous = m_parity ^ 1;
+  for (Partitions::iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+    {
+      std::vector<Scheduler::Event> &events = (*i)->outbox[previous][partition->id];
+      for (std::vector<Scheduler::Event>::iterator j = events.begin (); j != events.end (); j++)
+        {
+          j->key.m_uid = partition->uid;
+          partition->uid++;
+          partition->events->Insert (*j);
+        }
+      events.clear ();
+    }
+
+  partition->minSentTs = MAX_TS;
+  while (!partition->stopped
+         && !partition->events->IsEmpty ()
+         && partition->events->PeekNext ().key.m_ts < m_bound
+         && partition->events->PeekNext ().key.m_ts <= m_stopTs)
+    {
+      ProcessOneEvent (partition);
+    }
+  partition->nextTs = partition->minSentTs;
+  if (!partition->events->IsEmpty ()
+      && partition->events->PeekNext ().key.m_ts < partition->nextTs)
+    {
+      partition->nextTs = partition->events->PeekNext ().key.m_ts;
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  return NextTs () == MAX_TS || m_stopTs != MAX_TS;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::NextTs (void) const
+{
+  uint64_t nextTs = MAX_TS;
+  for (Partitions::const_iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+    {
+      if (!(*i)->events->IsEmpty ())
+        {
+          nextTs = std::min (nextTs, (*i)->events->PeekNext ().key.m_ts);
+        }
+    }
+  return nextTs;
+}
+
+Time
+MultithreadedSimulatorImpl::Next (void) const
+{
+  NS_ASSERT (NextTs () != MAX_TS);
+  return TimeStep (NextTs ());
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_partitioned)
+    {
+      CreatePartitions ();
+    }
+  uint32_t nPartitions = m_partitions.size () - 1;
+  Partition *global = GetGlobalPartition ();
+  m_stopTs = MAX_TS;
+  for (Partitions::iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+    {
+      (*i)->stopped = false;
+    }
+  m_done = false;
+  m_running = true;
+  g_running = this;
+  for (uint32_t i = 0; i < nPartitions; i++)
+    {
+      Partition *partition = m_partitions[i];
+      partition->nextTs = partition->events->IsEmpty () ? MAX_TS : partition->events->PeekNext ().key.m_ts;
+    }
+  if (nPartitions > 1)
+    {
+      m_barrier = new Barrier (nPartitions);
+      for (uint32_t i = 1; i < nPartitions; i++)
+        {
+          Partition *partition = m_partitions[i];
+          partition->thread = Create<SystemThread> (MakeCallback (&Partition::Loop, partition));
+          partition->thread->Start ();
+        }
+    }
+
+  while (true)
+    {
+      // All the other threads are waiting on the barrier.
+      Drain (m_parity, false);
+      uint64_t lbts = MAX_TS;
+      for (uint32_t i = 0; i < nPartitions; i++)
+        {
+          lbts = std::min (lbts, m_partitions[i]->nextTs);
+        }
+      uint64_t globalTs = global->events->IsEmpty () ? MAX_TS : global->events->PeekNext ().key.m_ts;
+      if (m_stopTs != MAX_TS || (lbts == MAX_TS && globalTs == MAX_TS))
+        {
+          break;
+        }
+      if (globalTs <= lbts)
+        {
+          // the global events are run alone, in the main thread.
+          while (!global->stopped
+                 && !global->events->IsEmpty ()
+                 && global->events->PeekNext ().key.m_ts == globalTs)
+            {
+              ProcessOneEvent (global);
+            }
+          continue;
+        }
+      m_bound = (m_lookAhead > MAX_TS - lbts) ? MAX_TS : lbts + m_lookAhead;
+      m_bound = std::min (m_bound, globalTs);
+      m_parity ^= 1;
+
+      if (nPartitions > 1)
+        {
+          m_barrier->Wait ();
+        }
+      pthread_setspecific (g_currentPartition, m_partitions[0]);
+      RunWindow (m_partitions[0]);
+      pthread_setspecific (g_currentPartition, 0);
+      if (nPartitions > 1)
+        {
+          m_barrier->Wait ();
+        }
+    }
+
+  m_done = true;
+  if (nPartitions > 1)
+    {
+      m_barrier->Wait ();
+      for (uint32_t i = 1; i < nPartitions; i++)
+        {
+          m_partitions[i]->thread->Join ();
+          m_partitions[i]->thread = 0;
+        }
+      delete m_barrier;
+      m_barrier = 0;
+    }
+  m_running = false;
+  g_running = 0;
+
+  // deliver the events which are still in flight and move the
+  // clock of the main thread to the time reached by the simulation.
+  Drain (0, true);
+  Drain (1, true);
+  for (uint32_t i = 0; i < nPartitions; i++)
+    {
+      global->currentTs = std::max (global->currentTs, m_partitions[i]->currentTs);
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId (void) const
+{
+  return 0;
+}
+
+void
+MultithreadedSimulatorImpl::RunOneEvent (void)
+{
+  Partition *next = 0;
+  for (Partitions::const_iterator i = m_partitions.begin (); i != m_partitions.end (); i++)
+    {
+      if (!(*i)->events->IsEmpty ()
+          && (next == 0 || (*i)->events->PeekNext ().key.m_ts < next->events->PeekNext ().key.m_ts))
+        {
+          next = *i;
+        }
+    }
+  NS_ASSERT (next != 0);
+  pthread_setspecific (g_currentPartition, next);
+  ProcessOneEvent (next);
+  pthread_setspecific (g_currentPartition, 0);
+  GetGlobalPartition ()->currentTs = std::max (GetGlobalPartition ()->currentTs, next->currentTs);
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  Partition *partition = GetCurrentPartition ();
+  partition->stopped = true;
+  uint64_t stopTs = m_stopTs;
+  while (partition->currentTs < stopTs
+         && !__sync_bool_compare_and_swap (&m_stopTs, stopTs, partition->currentTs))
+    {
+      stopTs = m_stopTs;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &time)
+{
+  Partition *partition = GetCurrentPartition ();
+  Partition *global = GetGlobalPartition ();
+  uint64_t ts = partition->currentTs + time.GetTimeStep ();
+  if (m_running && partition != global && ts < m_bound)
+    {
+      // the other partitions may already be past ts in this window.
+      Simulator::Schedule (time, &Simulator::Stop);
+      return;
+    }
+  // the global events bound the windows, so that no partition runs
+  // an event later than the stop.
+  Scheduler::Event ev;
+  ev.impl = MakeEvent (&Simulator::Stop);
+  ev.key.m_ts = ts;
+  ev.key.m_context = 0xffffffff;
+  Insert (partition, global, ev);
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &time, EventImpl *event)
+{
+  Partition *partition = GetCurrentPartition ();
+  Time tAbsolute = time + TimeStep (partition->currentTs);
+
+  NS_ASSERT (tAbsolute.IsPositive ());
+  NS_ASSERT (tAbsolute >= TimeStep (partition->currentTs));
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = static_cast<uint64_t> (tAbsolute.GetTimeStep ());
+  ev.key.m_context = partition->currentContext;
+  Insert (partition, partition, ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << time.GetTimeStep () << event);
+
+  Partition *partition = GetCurrentPartition ();
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = partition->currentTs + time.GetTimeStep ();
+  ev.key.m_context = context;
+  Insert (partition, GetPartition (context), ev);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  Partition *partition = GetCurrentPartition ();
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = partition->currentTs;
+  ev.key.m_context = partition->currentContext;
+  Insert (partition, partition, ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  EventId id (Ptr<EventImpl> (event, false), GetCurrentPartition ()->currentTs, 0xffffffff, 2);
+  CriticalSection cs (m_destroyMutex);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  return TimeStep (GetCurrentPartition ()->currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs () - GetCurrentPartition ()->currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      CriticalSection cs (m_destroyMutex);
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  GetPartition (id.GetContext ())->events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &ev) const
+{
+  if (ev.GetUid () == 2)
+    {
+      if (ev.PeekEventImpl () == 0
+          || ev.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      CriticalSection cs (const_cast<SystemMutex &> (m_destroyMutex));
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == ev)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  // the events of a node are always stored in, and expired
+  // by, the partition of that node.
+  Partition *partition = GetPartition (ev.GetContext ());
+  if (ev.PeekEventImpl () == 0
+      || ev.GetTs () < partition->currentTs
+      || (ev.GetTs () == partition->currentTs
+          && ev.GetUid () <= partition->currentUid)
+      || ev.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  // XXX: I am fairly certain other compilers use other non-standard
+  // post-fixes to indicate 64 bit constants.
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  return GetCurrentPartition ()->currentContext;
+}
+
+bool
+MultithreadedSimulatorImpl::IsPartitionBoundary (uint32_t a, uint32_t b)
+{
+  if (g_running == 0)
+    {
+      return false;
+    }
+  return g_running->GetPartition (a) != g_running->GetPartition (b);
+}
+
+} // namespace ns3
@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/simulator-impl.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/system-thread.h"
+#include "ns3/system-mutex.h"
+#include "ns3/ptr.h"
+
+#include <list>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief shared-memory parallel simulator implementation using lookahead
+ *
+ * This simulator implementation partitions the nodes of the simulation
+ * in a number of sets, each of which is run by its own thread. Events
+ * are assigned to the partition of the node identified by their context
+ * and events which are not associated with a node (such as the events
+ * scheduled from the main program) are run by the main thread while all
+ * other threads are idle.
+ *
+ * The nodes which share a channel which is not point-to-point are always
+ * placed in the same partition. The lookahead is the smallest delay
+ * of the point-to-point channels which connect two partitions, in the
+ * same way as DistributedSimulatorImpl::CalculateLookAhead. Each thread
+ * then runs, in parallel, all its events which are earlier than the
+ * smallest pending timestamp (LBTS) plus the lookahead. The events
+ * scheduled for another partition are stored in in-process queues which
+ * are merged in their destination partition at the start of the next
+ * window, in an order which does not depend on thread scheduling.
+ *
+ * Events scheduled for a node from another partition must respect
+ * the lookahead, that is, be at least as far in the future as the
+ * smallest delay of the point-to-point channels between partitions. If
+ * no such channel exists, everything is run by a single thread.
+ *
+ * The ordering of events within a partition is the same as with
+ * DefaultSimulatorImpl, except for events which have the same timestamp
+ * and which were scheduled from different partitions.
+ *
+ * When an event calls Stop, its partition stops immediately and the
+ * other partitions do not run the events which are later than that
+ * event, which they might however already have done if they were
+ * ahead of it in the same window. Stop (Time) is exact when it is
+ * called from the main thread, or from a node with a delay of at least
+ * the lookahead: the stop is then a global event. Otherwise, it
+ * behaves like a call to Stop from the node at the stop time.
+ *
+ * The nodes of a point-to-point channel whose TxRxPointToPoint trace
+ * source has sinks when Run is first called are kept in the same
+ * partition, since these sinks are given the receiving device.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  static TypeId GetTypeId (void);
+
+  MultithreadedSimulatorImpl ();
+  ~MultithreadedSimulatorImpl ();
+
+  // virtual from SimulatorImpl
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual Time Next (void) const;
+  virtual void Stop (void);
+  virtual void Stop (Time const &time);
+  virtual EventId Schedule (Time const &time, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &ev);
+  virtual void Cancel (const EventId &ev);
+  virtual bool IsExpired (const EventId &ev) const;
+  virtual void Run (void);
+  virtual void RunOneEvent (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+
+  /**
+   * \param a the context of a node
+   * \param b the context of another node
+   * \returns true if the two nodes are run by different threads of
+   *          the current simulator, and false otherwise, or if the
+   *          current simulator is not a MultithreadedSimulatorImpl.
+   *
+   * Models which pass objects from one node to another must not share
+   * them between partitions: they can use this method to decide when
+   * they need to make a private copy for the receiving node.
+   */
+  static bool IsPartitionBoundary (uint32_t a, uint32_t b);
+
+private:
+  struct Barrier;
+  struct Partition
+  {
+    MultithreadedSimulatorImpl *sim;
+    uint32_t id;
+    Ptr<Scheduler> events;
+    uint32_t uid;
+    uint64_t currentTs;
+    uint32_t currentUid;
+    uint32_t currentContext;
+    // smallest timestamp of the events pending in this partition
+    // or sent by it during the last window.
+    uint64_t nextTs;
+    uint64_t minSentTs;
+    // set when an event of this partition called Stop.
+    bool stopped;
+    // events sent to other partitions, indexed by window parity
+    // and destination partition.
+    std::vector<std::vector<Scheduler::Event> > outbox[2];
+    Ptr<SystemThread> thread;
+    void Loop (void);
+  };
+  typedef std::list<EventId> DestroyEvents;
+  typedef std::vector<Partition *> Partitions;
+
+  virtual void DoDispose (void);
+  void CreatePartitions (void);
+  Partition *CreatePartition (uint32_t id);
+  void DeletePartitions (void);
+  void CalculateLookAhead (void);
+  void RunWindow (Partition *partition);
+  void Drain (uint32_t parity, bool all);
+  void ProcessOneEvent (Partition *partition);
+  void Insert (Partition *from, Partition *to, Scheduler::Event &ev);
+  Partition *GetCurrentPartition (void) const;
+  Partition *GetPartition (uint32_t context) const;
+  Partition *GetGlobalPartition (void) const;
+  uint64_t NextTs (void) const;
+
+  DestroyEvents m_destroyEvents;
+  SystemMutex m_destroyMutex;
+  // timestamp of the earliest call to Stop made during this run,
+  // or MAX_TS. It is written by all threads with a compare-and-swap.
+  volatile uint64_t m_stopTs;
+  bool m_running;
+  bool m_done;
+  bool m_partitioned;
+  ObjectFactory m_schedulerFactory;
+  uint32_t m_maxThreads;
+  // the last partition is always the "global" partition which
+  // holds the events which are not associated with any node.
+  Partitions m_partitions;
+  // index of the partition of each node, indexed by node id.
+  std::vector<uint32_t> m_partitionOf;
+  uint64_t m_lookAhead;
+  uint64_t m_bound;
+  uint32_t m_parity;
+  Barrier *m_barrier;
+
+  static MultithreadedSimulatorImpl *g_running;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
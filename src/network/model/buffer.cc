@@ -18,15 +18,22 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "buffer.h"
+#include "thread-free-list.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#if defined (__AVX2__)
+#include <immintrin.h>
+#elif defined (__SSE2__)
+#include <emmintrin.h>
+#endif
 
 NS_LOG_COMPONENT_DEFINE ("Buffer");
 
 #define LOG_INTERNAL_STATE(y)                                                                    \
   NS_LOG_LOGIC (y << "start="<<m_start<<", end="<<m_end<<", zero start="<<m_zeroAreaStart<<              \
                 ", zero end="<<m_zeroAreaEnd<<", count="<<m_data->m_count<<", size="<<m_data->m_size<<   \
-                ", dirty start="<<m_data->m_dirtyStart<<", dirty end="<<m_data->m_dirtyEnd)
+                ", dirty start="<<m_data->m_dirtyStart<<", dirty end="<<m_data->m_dirtyEnd<<         \
+                ", tail size="<<m_tailSize)
 
 namespace {
 
@@ -41,51 +48,116 @@ static struct Zeroes
   const uint32_t size;
 } g_zeroes;
 
+/* The buffers smaller than this are copied rather than shared by
+ * Buffer::AddAtEnd (const Buffer &): a slab costs more than copying
+ * their bytes, both when it is created and when it is iterated over.
+ */
+static const uint32_t g_minSlabSize = 256;
+
+/* Add the little-endian 16 bit words of data to a ones-complement sum.
+ * If size is odd, the last byte is added as the low byte of a word.
+ * The result is not folded: the caller must fold it to 16 bits.
+ */
+static uint64_t
+ChecksumAdd (const uint8_t *data, uint32_t size)
+{
+  uint64_t sum = 0;
+#if defined (__AVX2__) || defined (__SSE2__)
+  // each 32 bit lane grows by at most 0x1fffe per iteration so
+  // the lanes must be emptied before 0x8000 iterations.
+  const uint32_t maxIterations = 4096;
+#if defined (__AVX2__)
+  const uint32_t width = 32;
+  while (size >= width)
+    {
+      __m256i zero = _mm256_setzero_si256 ();
+      __m256i acc = zero;
+      for (uint32_t n = 0; n < maxIterations && size >= width; n++)
+        {
+          __m256i v = _mm256_loadu_si256 (reinterpret_cast<const __m256i *> (data));
+          acc = _mm256_add_epi32 (acc, _mm256_unpacklo_epi16 (v, zero));
+          acc = _mm256_add_epi32 (acc, _mm256_unpackhi_epi16 (v, zero));
+          data += width;
+          size -= width;
+        }
+      uint32_t lanes[8];
+      _mm256_storeu_si256 (reinterpret_cast<__m256i *> (lanes), acc);
+      for (uint32_t j = 0; j < 8; j++)
+        {
+          sum += lanes[j];
+        }
+    }
+#else
+  const uint32_t width = 16;
+  while (size >= width)
+    {
+      __m128i zero = _mm_setzero_si128 ();
+      __m128i acc = zero;
+      for (uint32_t n = 0; n < maxIterations && size >= width; n++)
+        {
+          __m128i v = _mm_loadu_si128 (reinterpret_cast<const __m128i *> (data));
+          acc = _mm_add_epi32 (acc, _mm_unpacklo_epi16 (v, zero));
+          acc = _mm_add_epi32 (acc, _mm_unpackhi_epi16 (v, zero));
+          data += width;
+          size -= width;
+        }
+      uint32_t lanes[4];
+      _mm_storeu_si128 (reinterpret_cast<__m128i *> (lanes), acc);
+      for (uint32_t j = 0; j < 4; j++)
+        {
+          sum += lanes[j];
+        }
+    }
+#endif
+#endif
+  // 2^16 is 1 in ones-complement arithmetic so we can add 32 bit
+  // words and fold them later.
+  while (size >= 4)
+    {
+      sum += data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+      data += 4;
+      size -= 4;
+    }
+  if (size >= 2)
+    {
+      sum += data[0] | (data[1] << 8);
+      data += 2;
+      size -= 2;
+    }
+  if (size == 1)
+    {
+      sum += data[0];
+    }
+  return sum;
+}
+
+static uint16_t
+ChecksumFold (uint64_t sum)
+{
+  while (sum >> 16)
+    {
+      sum = (sum & 0xffff) + (sum >> 16);
+    }
+  return sum;
+}
+
 }
 
 namespace ns3 {
 
 
-uint32_t Buffer::g_recommendedStart = 0;
+__thread uint32_t Buffer::g_recommendedStart = 0;
 #ifdef BUFFER_FREE_LIST
-/* The following macros are pretty evil but they are needed to allow us to
- * keep track of 3 possible states for the g_freeList variable:
- *  - uninitialized means that no one has created a buffer yet
- *    so no one has created the associated free list (it is created
- *    on-demand when the first buffer is created)
- *  - initialized means that the free list exists and is valid
- *  - destroyed means that the static destructors of this compilation unit
- *    have run so, the free list has been cleared from its content
- * The key is that in destroyed state, we are careful not re-create it
- * which is a typical weakness of lazy evaluation schemes which use 
- * '0' as a special value to indicate both un-initialized and destroyed.
- * Note that it is important to use '0' as the marker for un-initialized state
- * because the variable holding this state information is initialized to zero
- * which the compiler assigns to zero-memory which is initialized to _zero_
- * before the constructors run so this ensures perfect handling of crazy 
- * constructor orderings.
- */
-#define MAGIC_DESTROYED (~(long) 0)
-#define IS_UNINITIALIZED(x) (x == (Buffer::FreeList*)0)
-#define IS_DESTROYED(x) (x == (Buffer::FreeList*)MAGIC_DESTROYED)
-#define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
-#define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
-#define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList *Buffer::g_freeList = 0;
+__thread uint32_t Buffer::g_maxSize = 0;
 struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor(void)
 {
-  if (IS_INITIALIZED(g_freeList))
+  FreeList::Destroy ();
+  struct Buffer::Data *data;
+  while ((data = FreeList::Pop ()) != 0)
     {
-      for (Buffer::FreeList::iterator i = g_freeList->begin ();
-           i != g_freeList->end (); i++)
-        {
-          Buffer::Deallocate (*i);
-        }
-      delete g_freeList;
-      g_freeList = DESTROYED;
+      Buffer::Deallocate (data);
     }
 }
 
@@ -93,45 +165,30 @@ void
 Buffer::Recycle (struct Buffer::Data *data)
 {
   NS_ASSERT (data->m_count == 0);
-  NS_ASSERT (!IS_UNINITIALIZED(g_freeList));
   g_maxSize = std::max (g_maxSize, data->m_size);
   /* feed into free list */
   if (data->m_size < g_maxSize ||
-      IS_DESTROYED(g_freeList) ||
-      g_freeList->size () > 1000)
+      !FreeList::Push (data))
     {
       Buffer::Deallocate (data);
     }
-  else
-    {
-      NS_ASSERT (IS_INITIALIZED(g_freeList));
-      g_freeList->push_back (data);
-    }
 }
 
 Buffer::Data *
 Buffer::Create (uint32_t dataSize)
 {
   /* try to find a buffer correctly sized. */
-  if (IS_UNINITIALIZED(g_freeList))
-    {
-      g_freeList = new Buffer::FreeList ();
-    }
-  else if (IS_INITIALIZED(g_freeList))
+  struct Buffer::Data *data;
+  while ((data = FreeList::Pop ()) != 0)
     {
-      while (!g_freeList->empty ()) 
+      if (data->m_size >= dataSize) 
         {
-          struct Buffer::Data *data = g_freeList->back ();
-          g_freeList->pop_back ();
-          if (data->m_size >= dataSize) 
-            {
-              data->m_count = 1;
-              return data;
-            }
-          Buffer::Deallocate (data);
+          data->m_count = 1;
+          return data;
         }
+      Buffer::Deallocate (data);
     }
-  struct Buffer::Data *data = Buffer::Allocate (dataSize);
+  data = Buffer::Allocate (dataSize);
   NS_ASSERT (data->m_count == 1);
   return data;
 }
@@ -175,18 +232,25 @@ Buffer::Deallocate (struct Buffer::Data *data)
 }
 
 Buffer::Buffer ()
+  : m_tail (0),
+    m_tailSize (0)
 {
   NS_LOG_FUNCTION (this);
   Initialize (0);
 }
 
 Buffer::Buffer (uint32_t dataSize)
+  : m_tail (0),
+    m_tailSize (0)
 {
   NS_LOG_FUNCTION (this << dataSize);
   Initialize (dataSize);
 }
 
 Buffer::Buffer (uint32_t dataSize, bool initialize)
+  : m_data (0),
+    m_tail (0),
+    m_tailSize (0)
 {
   NS_LOG_FUNCTION (this << dataSize << initialize);
   if (initialize == true)
@@ -259,6 +323,19 @@ Buffer::operator = (Buffer const&o)
       m_data = o.m_data;
       m_data->m_count++;
     }
+  if (m_tail != o.m_tail)
+    {
+      if (o.m_tail != 0)
+        {
+          o.m_tail->m_count++;
+        }
+      if (m_tail != 0)
+        {
+          Release (m_tail);
+        }
+      m_tail = o.m_tail;
+    }
+  m_tailSize = o.m_tailSize;
   g_recommendedStart = std::max (g_recommendedStart, m_maxZeroAreaStart);
   m_maxZeroAreaStart = o.m_maxZeroAreaStart;
   m_zeroAreaStart = o.m_zeroAreaStart;
@@ -279,6 +356,10 @@ Buffer::~Buffer ()
     {
       Recycle (m_data);
     }
+  if (m_tail != 0)
+    {
+      Release (m_tail);
+    }
 }
 
 uint32_t
@@ -292,6 +373,160 @@ Buffer::GetInternalEnd (void) const
   return m_end - (m_zeroAreaEnd - m_zeroAreaStart);
 }
 
+void
+Buffer::Release (struct Buffer::Tail *tail)
+{
+  tail->m_count--;
+  if (tail->m_count == 0)
+    {
+      for (std::vector<struct Slab>::iterator i = tail->m_slabs.begin ();
+           i != tail->m_slabs.end (); i++)
+        {
+          i->m_data->m_count--;
+          if (i->m_data->m_count == 0)
+            {
+              Recycle (i->m_data);
+            }
+        }
+      delete tail;
+    }
+}
+
+struct Buffer::Tail *
+Buffer::GetWritableTail (void)
+{
+  if (m_tail == 0)
+    {
+      m_tail = new struct Tail ();
+      m_tail->m_count = 1;
+    }
+  else if (m_tail->m_count > 1)
+    {
+      struct Tail *tail = new struct Tail ();
+      tail->m_count = 1;
+      tail->m_slabs = m_tail->m_slabs;
+      for (std::vector<struct Slab>::iterator i = tail->m_slabs.begin ();
+           i != tail->m_slabs.end (); i++)
+        {
+          i->m_data->m_count++;
+        }
+      m_tail->m_count--;
+      m_tail = tail;
+    }
+  return m_tail;
+}
+
+void
+Buffer::ClearTail (void)
+{
+  if (m_tail != 0)
+    {
+      Release (m_tail);
+      m_tail = 0;
+      m_tailSize = 0;
+    }
+}
+
+void
+Buffer::AddSlab (struct Buffer::Data *data, uint32_t start, uint32_t zeroAreaStart,
+                 uint32_t zeroAreaEnd, uint32_t end)
+{
+  if (end == start)
+    {
+      return;
+    }
+  struct Slab slab;
+  slab.m_data = data;
+  slab.m_start = start;
+  slab.m_zeroAreaStart = zeroAreaStart;
+  slab.m_zeroAreaEnd = zeroAreaEnd;
+  slab.m_end = end;
+  data->m_count++;
+  GetWritableTail ()->m_slabs.push_back (slab);
+  m_tailSize += end - start;
+}
+
+void
+Buffer::RemoveTailStart (uint32_t start)
+{
+  if (start >= m_tailSize)
+    {
+      ClearTail ();
+      return;
+    }
+  std::vector<struct Slab> &slabs = GetWritableTail ()->m_slabs;
+  m_tailSize -= start;
+  std::vector<struct Slab>::iterator i = slabs.begin ();
+  while (start >= i->m_end - i->m_start)
+    {
+      start -= i->m_end - i->m_start;
+      i->m_data->m_count--;
+      if (i->m_data->m_count == 0)
+        {
+          Recycle (i->m_data);
+        }
+      i++;
+    }
+  slabs.erase (slabs.begin (), i);
+  // same as RemoveAtStart, within the first slab.
+  struct Slab &slab = slabs.front ();
+  uint32_t newStart = slab.m_start + start;
+  if (newStart <= slab.m_zeroAreaStart)
+    {
+      slab.m_start = newStart;
+    }
+  else if (newStart <= slab.m_zeroAreaEnd)
+    {
+      uint32_t delta = newStart - slab.m_zeroAreaStart;
+      slab.m_start = slab.m_zeroAreaStart;
+      slab.m_zeroAreaEnd -= delta;
+      slab.m_end -= delta;
+    }
+  else
+    {
+      uint32_t zeroSize = slab.m_zeroAreaEnd - slab.m_zeroAreaStart;
+      slab.m_start = newStart - zeroSize;
+      slab.m_end -= zeroSize;
+      slab.m_zeroAreaStart = slab.m_start;
+      slab.m_zeroAreaEnd = slab.m_start;
+    }
+}
+
+void
+Buffer::RemoveTailEnd (uint32_t end)
+{
+  if (end >= m_tailSize)
+    {
+      ClearTail ();
+      return;
+    }
+  std::vector<struct Slab> &slabs = GetWritableTail ()->m_slabs;
+  m_tailSize -= end;
+  while (end >= slabs.back ().m_end - slabs.back ().m_start)
+    {
+      struct Slab &slab = slabs.back ();
+      end -= slab.m_end - slab.m_start;
+      slab.m_data->m_count--;
+      if (slab.m_data->m_count == 0)
+        {
+          Recycle (slab.m_data);
+        }
+      slabs.pop_back ();
+    }
+  // same as RemoveAtEnd, within the last slab.
+  struct Slab &slab = slabs.back ();
+  uint32_t newEnd = slab.m_end - end;
+  slab.m_end = newEnd;
+  if (newEnd <= slab.m_zeroAreaEnd)
+    {
+      slab.m_zeroAreaEnd = newEnd;
+    }
+  if (newEnd <= slab.m_zeroAreaStart)
+    {
+      slab.m_zeroAreaStart = newEnd;
+    }
+}
+
 bool
 Buffer::AddAtStart (uint32_t start)
 {
@@ -349,6 +584,23 @@ Buffer::AddAtEnd (uint32_t end)
   NS_LOG_FUNCTION (this << end);
   bool dirty;
   NS_ASSERT (CheckInternalState ());
+  if (m_tail != 0)
+    {
+      /* the new bytes go in a slab of their own, which is the only one
+       * of the tail this buffer can write to.
+       */
+      if (end == 0)
+        {
+          return false;
+        }
+      struct Buffer::Data *data = Buffer::Create (end);
+      data->m_dirtyStart = 0;
+      data->m_dirtyEnd = end;
+      AddSlab (data, 0, end, end, end);
+      data->m_count--;
+      LOG_INTERNAL_STATE ("add end=" << end << ", ");
+      return true;
+    }
   bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
   if (GetInternalEnd () + end <= m_data->m_size && !isDirty)
     {
@@ -402,7 +654,9 @@ void
 Buffer::AddAtEnd (const Buffer &o)
 {
   NS_LOG_FUNCTION (this << &o);
-  if (m_data->m_count == 1 &&
+  if (m_tail == 0 &&
+      o.m_tail == 0 &&
+      m_data->m_count == 1 &&
       m_end == m_zeroAreaEnd &&
       m_end == m_data->m_dirtyEnd &&
       o.m_start == o.m_zeroAreaStart &&
@@ -428,14 +682,29 @@ Buffer::AddAtEnd (const Buffer &o)
       return;
     }
 
-  Buffer dst = CreateFullCopy ();
-  Buffer src = o.CreateFullCopy ();
+  // o might be this buffer.
+  Buffer src = o;
+  if (src.GetSize () < g_minSlabSize)
+    {
+      AddAtEnd (src.GetSize ());
+      Buffer::Iterator destStart = End ();
+      destStart.Prev (src.GetSize ());
+      destStart.Write (src.Begin (), src.End ());
+      NS_ASSERT (CheckInternalState ());
+      return;
+    }
 
-  dst.AddAtEnd (src.GetSize ());
-  Buffer::Iterator destStart = dst.End ();
-  destStart.Prev (src.GetSize ());
-  destStart.Write (src.Begin (), src.End ());
-  *this = dst;
+  /* share the bytes of src: they become slabs of our tail. */
+  AddSlab (src.m_data, src.m_start, src.m_zeroAreaStart, src.m_zeroAreaEnd, src.m_end);
+  if (src.m_tail != 0)
+    {
+      for (std::vector<struct Slab>::const_iterator i = src.m_tail->m_slabs.begin ();
+           i != src.m_tail->m_slabs.end (); i++)
+        {
+          AddSlab (i->m_data, i->m_start, i->m_zeroAreaStart, i->m_zeroAreaEnd, i->m_end);
+        }
+    }
+  LOG_INTERNAL_STATE ("add buffer=" << src.GetSize () << ", ");
   NS_ASSERT (CheckInternalState ());
 }
 
@@ -444,6 +713,12 @@ Buffer::RemoveAtStart (uint32_t start)
 {
   NS_LOG_FUNCTION (this << start);
   NS_ASSERT (CheckInternalState ());
+  uint32_t tailStart = 0;
+  if (m_tail != 0 && start > m_end - m_start)
+    {
+      tailStart = start - (m_end - m_start);
+      start = m_end - m_start;
+    }
   uint32_t newStart = m_start + start;
   if (newStart <= m_zeroAreaStart)
     {
@@ -480,6 +755,10 @@ Buffer::RemoveAtStart (uint32_t start)
       m_zeroAreaEnd = m_end;
       m_zeroAreaStart = m_end;
     }
+  if (tailStart != 0)
+    {
+      RemoveTailStart (tailStart);
+    }
   m_maxZeroAreaStart = std::max (m_maxZeroAreaStart, m_zeroAreaStart);
   LOG_INTERNAL_STATE ("rem start=" << start << ", ");
   NS_ASSERT (CheckInternalState ());
@@ -489,6 +768,18 @@ Buffer::RemoveAtEnd (uint32_t end)
 {
   NS_LOG_FUNCTION (this << end);
   NS_ASSERT (CheckInternalState ());
+  if (m_tail != 0)
+    {
+      if (end < m_tailSize)
+        {
+          RemoveTailEnd (end);
+          LOG_INTERNAL_STATE ("rem end=" << end << ", ");
+          NS_ASSERT (CheckInternalState ());
+          return;
+        }
+      end -= m_tailSize;
+      ClearTail ();
+    }
   uint32_t newEnd = m_end - std::min (end, m_end - m_start);
   if (newEnd > m_zeroAreaEnd)
     {
@@ -537,6 +828,14 @@ Buffer::CreateFullCopy (void) const
 {
   NS_LOG_FUNCTION (this);
   NS_ASSERT (CheckInternalState ());
+  if (m_tail != 0)
+    {
+      Buffer tmp;
+      tmp.AddAtStart (GetSize ());
+      CopyData (tmp.m_data->m_data + tmp.m_start, GetSize ());
+      NS_ASSERT (tmp.CheckInternalState ());
+      return tmp;
+    }
   if (m_zeroAreaEnd - m_zeroAreaStart != 0) 
     {
       Buffer tmp;
@@ -560,6 +859,10 @@ Buffer::CreateFullCopy (void) const
 uint32_t 
 Buffer::GetSerializedSize (void) const
 {
+  if (m_tail != 0)
+    {
+      return CreateFullCopy ().GetSerializedSize ();
+    }
   uint32_t dataStart = (m_zeroAreaStart - m_start + 3) & (~0x3);
   uint32_t dataEnd = (m_end - m_zeroAreaEnd + 3) & (~0x3);
 
@@ -579,6 +882,10 @@ Buffer::GetSerializedSize (void) const
 uint32_t
 Buffer::Serialize (uint8_t* buffer, uint32_t maxSize) const
 {
+  if (m_tail != 0)
+    {
+      return CreateFullCopy ().Serialize (buffer, maxSize);
+    }
   uint32_t* p = reinterpret_cast<uint32_t *> (buffer);
   uint32_t size = 0;
 
@@ -658,6 +965,15 @@ Buffer::Deserialize (const uint8_t *buffer, uint32_t size)
   sizeCheck -= 4;
 
   // Create zero bytes
+  ClearTail ();
+  if (m_data != 0)
+    {
+      m_data->m_count--;
+      if (m_data->m_count == 0)
+        {
+          Recycle (m_data);
+        }
+    }
   Initialize (zeroDataLength);
 
   // Add start data
@@ -698,7 +1014,7 @@ Buffer::GetCurrentStartOffset (void) const
 int32_t 
 Buffer::GetCurrentEndOffset (void) const
 {
-  return m_end;
+  return m_end + m_tailSize;
 }
 
 
@@ -724,14 +1040,18 @@ Buffer::PeekData (void) const
 void
 Buffer::CopyData(std::ostream *os, uint32_t size) const
 {
-  if (size > 0)
+  Buffer::Iterator i = Begin ();
+  size = std::min (size, GetSize ());
+  while (size > 0)
     {
-      uint32_t tmpsize = std::min (m_zeroAreaStart-m_start, size);
-      os->write((const char*)(m_data->m_data + m_start), tmpsize);
-      if (size > tmpsize) 
-        { 
-          size -= m_zeroAreaStart-m_start;
-          tmpsize = std::min (m_zeroAreaEnd - m_zeroAreaStart, size);
+      uint8_t const *data;
+      uint32_t tmpsize = std::min (size, i.PeekChunk (&data));
+      if (data != 0)
+        {
+          os->write ((const char*)data, tmpsize);
+        }
+      else
+        {
           uint32_t left = tmpsize;
           while (left > 0)
             {
@@ -739,46 +1059,18 @@ Buffer::CopyData(std::ostream *os, uint32_t size) const
               os->write (g_zeroes.buffer, toWrite);
               left -= toWrite;
             }
-          if (size > tmpsize)
-            {
-              size -= tmpsize;
-              tmpsize = std::min (m_end - m_zeroAreaEnd, size);
-              os->write ((const char*)(m_data->m_data + m_zeroAreaStart), tmpsize); 
-            }
         }
+      i.m_current += tmpsize;
+      size -= tmpsize;
     }
 }
 
 uint32_t 
 Buffer::CopyData (uint8_t *buffer, uint32_t size) const
 {
-  uint32_t originalSize = size;
-  if (size > 0)
-    {
-      uint32_t tmpsize = std::min (m_zeroAreaStart-m_start, size);
-      memcpy (buffer, (const char*)(m_data->m_data + m_start), tmpsize);
-      buffer += tmpsize;
-      if (size > tmpsize) 
-        { 
-          size -= m_zeroAreaStart-m_start;
-          tmpsize = std::min (m_zeroAreaEnd - m_zeroAreaStart, size);
-          uint32_t left = tmpsize;
-          while (left > 0)
-            {
-              uint32_t toWrite = std::min (left, g_zeroes.size);
-              memcpy (buffer, g_zeroes.buffer, toWrite);
-              left -= toWrite;
-              buffer += toWrite;
-            }
-          if (size > tmpsize)
-            {
-              size -= tmpsize;
-              tmpsize = std::min (m_end - m_zeroAreaEnd, size);
-              memcpy (buffer, (const char*)(m_data->m_data + m_zeroAreaStart), tmpsize);
-            }
-        }
-    }
-  return originalSize - size;
+  size = std::min (size, GetSize ());
+  Begin ().Read (buffer, size);
+  return size;
 }
 
 /******************************************************
@@ -789,7 +1081,7 @@ Buffer::CopyData (uint8_t *buffer, uint32_t size) const
 uint32_t
 Buffer::Iterator::GetDistanceFrom (Iterator const &o) const
 {
-  NS_ASSERT (m_data == o.m_data);
+  NS_ASSERT (m_dataStart == o.m_dataStart && m_dataEnd == o.m_dataEnd);
   int32_t diff = m_current - o.m_current;
   if (diff < 0)
     {
@@ -812,6 +1104,73 @@ Buffer::Iterator::IsStart (void) const
   return m_current == m_dataStart;
 }
 
+void
+Buffer::Iterator::Seek (void)
+{
+  if (m_segment == 0 && m_segmentEnd == m_dataEnd && m_current >= m_segmentStart)
+    {
+      /* the buffer has no tail: like the iterators of earlier versions,
+       * this one does not need the Buffer it was created from.
+       */
+      return;
+    }
+  const Buffer *buffer = m_buffer;
+  if (buffer->m_tail == 0 || m_current < buffer->m_end)
+    {
+      Construct (buffer);
+      return;
+    }
+  /* look for the slab which holds m_current, from the current one if
+   * m_current moved forward. The last slab holds the end of the buffer.
+   */
+  const std::vector<struct Slab> &slabs = buffer->m_tail->m_slabs;
+  uint32_t index = 0;
+  uint32_t start = buffer->m_end;
+  if (m_segment != 0 && m_current >= m_segmentStart)
+    {
+      index = m_segment - 1;
+      start = m_segmentStart;
+    }
+  while (index + 1 < slabs.size () &&
+         m_current >= start + (slabs[index].m_end - slabs[index].m_start))
+    {
+      start += slabs[index].m_end - slabs[index].m_start;
+      index++;
+    }
+  const struct Slab &slab = slabs[index];
+  m_segment = index + 1;
+  m_segmentStart = start;
+  m_segmentEnd = start + (slab.m_end - slab.m_start);
+  m_zeroStart = start + (slab.m_zeroAreaStart - slab.m_start);
+  m_zeroEnd = start + (slab.m_zeroAreaEnd - slab.m_start);
+  // m_data[m_segmentStart] is the first byte of the slab.
+  m_data = slab.m_data->m_data + slab.m_start - start;
+}
+
+uint32_t
+Buffer::Iterator::PeekChunk (uint8_t const **data)
+{
+  if (!IsInSegment (1))
+    {
+      Seek ();
+    }
+  if (m_current < m_zeroStart)
+    {
+      *data = &m_data[m_current];
+      return m_zeroStart - m_current;
+    }
+  else if (m_current < m_zeroEnd)
+    {
+      *data = 0;
+      return m_zeroEnd - m_current;
+    }
+  else
+    {
+      *data = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+      return m_segmentEnd - m_current;
+    }
+}
+
 bool 
 Buffer::Iterator::CheckNoZero (uint32_t start, uint32_t end) const
 {
@@ -837,36 +1196,27 @@ Buffer::Iterator::Check (uint32_t i) const
 void 
 Buffer::Iterator::Write (Iterator start, Iterator end)
 {
-  NS_ASSERT (start.m_data == end.m_data);
+  NS_ASSERT (start.m_dataStart == end.m_dataStart && start.m_dataEnd == end.m_dataEnd);
   NS_ASSERT (start.m_current <= end.m_current);
-  NS_ASSERT (start.m_zeroStart == end.m_zeroStart);
-  NS_ASSERT (start.m_zeroEnd == end.m_zeroEnd);
-  NS_ASSERT (m_data != start.m_data);
+  NS_ASSERT (m_buffer != start.m_buffer);
   uint32_t size = end.m_current - start.m_current;
-  Iterator cur = start;
   NS_ASSERT_MSG (CheckNoZero (m_current, m_current + size),
                  GetWriteErrorMessage ());
-  if (start.m_current <= start.m_zeroStart)
-    {
-      uint32_t toCopy = std::min (size, start.m_zeroStart - start.m_current);
-      memcpy (&m_data[m_current], &start.m_data[start.m_current], toCopy);
-      start.m_current += toCopy;
-      m_current += toCopy;
-      size -= toCopy;
-    }
-  if (start.m_current <= start.m_zeroEnd)
+  while (size > 0)
     {
-      uint32_t toCopy = std::min (size, start.m_zeroEnd - start.m_current);
-      memset (&m_data[m_current], 0, toCopy);
+      uint8_t const *from;
+      uint32_t toCopy = std::min (size, start.PeekChunk (&from));
+      if (from != 0)
+        {
+          Write (from, toCopy);
+        }
+      else
+        {
+          WriteU8 (0, toCopy);
+        }
       start.m_current += toCopy;
-      m_current += toCopy;
       size -= toCopy;
     }
-  uint32_t toCopy = std::min (size, start.m_dataEnd - start.m_current);
-  uint8_t *from = &start.m_data[start.m_current - (start.m_zeroEnd-start.m_zeroStart)];
-  uint8_t *to = &m_data[m_current];
-  memcpy (to, from, toCopy);
-  m_current += toCopy;
 }
 
 void 
@@ -948,19 +1298,38 @@ Buffer::Iterator::WriteHtonU64 (uint64_t data)
 void 
 Buffer::Iterator::Write (uint8_t const*buffer, uint32_t size)
 {
-  NS_ASSERT_MSG (CheckNoZero (m_current, size),
+  NS_ASSERT_MSG (CheckNoZero (m_current, m_current + size),
                  GetWriteErrorMessage ());
-  uint8_t *to;
-  if (m_current <= m_zeroStart)
+  while (size > 0)
     {
-      to = &m_data[m_current];
+      if (!IsInSegment (1))
+        {
+          Seek ();
+        }
+      uint32_t toCopy = std::min (size, m_segmentEnd - m_current);
+      uint8_t *to;
+      if (m_current <= m_zeroStart)
+        {
+          to = &m_data[m_current];
+        }
+      else
+        {
+          to = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+        }
+      memcpy (to, buffer, toCopy);
+      m_current += toCopy;
+      buffer += toCopy;
+      size -= toCopy;
     }
-  else
+}
+
+void
+Buffer::Iterator::SlowWriteU8 (uint8_t data, uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i++)
     {
-      to = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+      WriteU8 (data);
     }
-  memcpy (to, buffer, size);
-  m_current += size;
 }
 
 uint32_t 
@@ -1109,9 +1478,24 @@ Buffer::Iterator::ReadLsbtohU64 (void)
 void 
 Buffer::Iterator::Read (uint8_t *buffer, uint32_t size)
 {
-  for (uint32_t i = 0; i < size; i++)
+  NS_ASSERT_MSG (m_current >= m_dataStart &&
+                 m_current + size <= m_dataEnd,
+                 GetReadErrorMessage ());
+  while (size > 0)
     {
-      buffer[i] = ReadU8 ();
+      uint8_t const *from;
+      uint32_t toCopy = std::min (size, PeekChunk (&from));
+      if (from != 0)
+        {
+          memcpy (buffer, from, toCopy);
+        }
+      else
+        {
+          memset (buffer, 0, toCopy);
+        }
+      m_current += toCopy;
+      buffer += toCopy;
+      size -= toCopy;
     }
 }
 
@@ -1125,17 +1509,41 @@ uint16_t
 Buffer::Iterator::CalculateIpChecksum(uint16_t size, uint32_t initialChecksum)
 {
   /* see RFC 1071 to understand this code. */
-  uint32_t sum = initialChecksum;
-
-  for (int j = 0; j < size/2; j++)
-    sum += ReadU16 ();
-
-  if (size & 1)
-    sum += ReadU8 ();
+  NS_ASSERT_MSG (m_current >= m_dataStart &&
+                 m_current + size <= m_dataEnd,
+                 GetReadErrorMessage ());
+  uint64_t sum = initialChecksum;
+  bool odd = false;
+  while (size > 0)
+    {
+      uint8_t const *data;
+      uint32_t length = std::min ((uint32_t)size, PeekChunk (&data));
+      if (data != 0)
+        {
+          uint16_t chunk = ChecksumFold (ChecksumAdd (data, length));
+          if (odd)
+            {
+              // the bytes of this chunk are swapped relative to the
+              // words of the checksum, and so is their sum.
+              chunk = (chunk >> 8) | (chunk << 8);
+            }
+          sum += chunk;
+        }
+      odd ^= (length & 1);
+      m_current += length;
+      size -= length;
+    }
+  return ~ChecksumFold (sum);
+}
 
-  while (sum >> 16)
-    sum = (sum & 0xffff) + (sum >> 16);
-  return ~sum;
+uint16_t
+Buffer::Iterator::UpdateIpChecksum (uint16_t checksum, uint16_t oldValue, uint16_t newValue)
+{
+  /* see RFC 1624, equation 3. */
+  uint32_t sum = (uint16_t)~checksum;
+  sum += (uint16_t)~oldValue;
+  sum += newValue;
+  return ~ChecksumFold (sum);
 }
 
 uint32_t 
@@ -29,6 +29,8 @@
 
 namespace ns3 {
 
+template <typename T, uint32_t MaxSize> class ThreadFreeList;
+
 /**
  * \ingroup packet
  *
@@ -86,10 +88,24 @@ namespace ns3 {
  *                        |------------------------------------------^ m_end
  *
  * A simple state invariant is that m_start <= m_zeroStart <= m_zeroEnd <= m_end
+ *
+ * The bytes described above may be followed by a "tail": a list of
+ * slabs, each of which is a read-only view of the bytes of another
+ * BufferData instance, with its own virtual zero area. Appending a
+ * large buffer to another one, with Buffer::AddAtEnd (const Buffer &),
+ * does not copy its bytes: it adds a reference to its BufferData
+ * instances to the tail of the other buffer, so that concatenation and
+ * fragmentation cost O(number of slabs) rather than O(number of bytes).
+ * The tail is itself shared by the copies of a buffer until one of them
+ * removes bytes from it, and the bytes added at the end of a buffer
+ * which has a tail go in a new slab which only this buffer references.
+ * The virtual offsets of the bytes of the tail follow m_end.
  */
 class Buffer 
 {
 public:
+  class WriteSpan;
+  class ReadSpan;
   /**
    * \brief iterator in a Buffer instance
    */
@@ -352,6 +368,20 @@ public:
      */
     uint16_t CalculateIpChecksum(uint16_t size, uint32_t initialChecksum);
 
+    /**
+     * \brief Update a checksum after a change in the data it covers.
+     * \param checksum the checksum of the original data, as
+     *        returned by CalculateIpChecksum
+     * \param oldValue the 16 bit word of the original data which
+     *        changed, as read by ReadU16
+     * \param newValue the new value of this word, as read by ReadU16
+     * \return the checksum of the new data
+     *
+     * This is much cheaper than recomputing the checksum of the new
+     * data: see RFC 1624.
+     */
+    static uint16_t UpdateIpChecksum (uint16_t checksum, uint16_t oldValue, uint16_t newValue);
+
     /**
      * \returns the size of the underlying buffer we are iterating
      */
@@ -359,22 +389,29 @@ public:
 
 private:
     friend class Buffer;
+    friend class WriteSpan;
+    friend class ReadSpan;
     inline Iterator (Buffer const*buffer);
     inline Iterator (Buffer const*buffer, bool);
     inline void Construct (const Buffer *buffer);
+    inline bool IsInSegment (uint32_t size) const;
+    void Seek (void);
+    inline uint8_t *PeekContiguous (uint32_t size);
+    uint32_t PeekChunk (uint8_t const **data);
     bool CheckNoZero (uint32_t start, uint32_t end) const;
     bool Check (uint32_t i) const;
+    void SlowWriteU8 (uint8_t data, uint32_t len);
     uint16_t SlowReadNtohU16 (void);
     uint32_t SlowReadNtohU32 (void);
     std::string GetReadErrorMessage (void) const;
     std::string GetWriteErrorMessage (void) const;
 
     /* offset in virtual bytes from the start of the data buffer to the
-     * start of the "virtual zero area".
+     * start of the "virtual zero area" of the current segment.
      */
     uint32_t m_zeroStart;
     /* offset in virtual bytes from the start of the data buffer to the
-     * end of the "virtual zero area".
+     * end of the "virtual zero area" of the current segment.
      */
     uint32_t m_zeroEnd;
     /* offset in virtual bytes from the start of the data buffer to the
@@ -389,10 +426,99 @@ private:
      * current position represented by this iterator.
      */
     uint32_t m_current;
-    /* a pointer to the underlying byte buffer. All offsets are relative
-     * to this pointer.
+    /* offsets in virtual bytes from the start of the data buffer to the
+     * start and to the end of the current segment: the bytes of the
+     * Buffer itself or those of one of the slabs of its tail. The other
+     * segments are looked up by Seek when m_current leaves this one.
+     */
+    uint32_t m_segmentStart;
+    uint32_t m_segmentEnd;
+    /* zero for the bytes of the Buffer itself, the index of the slab
+     * plus one otherwise.
+     */
+    uint32_t m_segment;
+    /* a pointer to the byte buffer of the current segment. All offsets
+     * in this segment are relative to this pointer.
      */
     uint8_t *m_data;
+    Buffer const *m_buffer;
+  };
+
+  /**
+   * \brief write a known number of bytes in a buffer
+   *
+   * The constructor checks once that the bytes which follow an
+   * iterator can be written and moves the iterator past them. If these
+   * bytes are contiguous in memory, as the bytes reserved by
+   * Buffer::AddAtStart and Buffer::AddAtEnd usually are, the methods of
+   * this class then write them directly without the checks made by
+   * each method of Buffer::Iterator. Otherwise, they write them through
+   * a copy of the original iterator.
+   *
+   * This is meant for the Serialize methods of headers and trailers:
+   * \code
+   * Buffer::WriteSpan i (start, GetSerializedSize ());
+   * i.WriteU8 (m_type);
+   * i.WriteHtonU16 (m_length);
+   * \endcode
+   * The methods of this class write the data in the same format as the
+   * methods of the same name of Buffer::Iterator. No more than size
+   * bytes must be written.
+   */
+  class WriteSpan
+  {
+public:
+    /**
+     * \param i the iterator to write at, moved forward by size bytes
+     * \param size the number of bytes to write
+     */
+    inline WriteSpan (Iterator &i, uint32_t size);
+    inline void WriteU8 (uint8_t data);
+    inline void WriteU8 (uint8_t data, uint32_t len);
+    inline void WriteU16 (uint16_t data);
+    inline void WriteHtonU16 (uint16_t data);
+    inline void WriteHtonU32 (uint32_t data);
+    inline void WriteHtonU64 (uint64_t data);
+    inline void WriteHtolsbU16 (uint16_t data);
+    inline void Write (uint8_t const *buffer, uint32_t size);
+private:
+    // zero if the bytes are not contiguous.
+    uint8_t *m_current;
+    uint8_t *m_end;
+    Iterator m_slow;
+  };
+
+  /**
+   * \brief read a known number of bytes from a buffer
+   *
+   * The counterpart of Buffer::WriteSpan for the Deserialize methods
+   * of headers and trailers. Reading the virtual zero area of a buffer
+   * is allowed but goes through a copy of the original iterator.
+   */
+  class ReadSpan
+  {
+public:
+    /**
+     * \param i the iterator to read at, moved forward by size bytes
+     * \param size the number of bytes to read
+     */
+    inline ReadSpan (Iterator &i, uint32_t size);
+    inline uint8_t ReadU8 (void);
+    inline uint16_t ReadU16 (void);
+    inline uint16_t ReadNtohU16 (void);
+    inline uint32_t ReadNtohU32 (void);
+    inline uint64_t ReadNtohU64 (void);
+    inline uint16_t ReadLsbtohU16 (void);
+    inline void Read (uint8_t *buffer, uint32_t size);
+    /**
+     * \param delta the number of bytes to skip
+     */
+    inline void Next (uint32_t delta);
+private:
+    // zero if the bytes are not contiguous.
+    uint8_t const *m_current;
+    uint8_t const *m_end;
+    Iterator m_slow;
   };
 
   /**
@@ -565,11 +691,43 @@ private:
     uint8_t m_data[1];
   };
 
+  /**
+   * A read-only view of some of the bytes of a Buffer::Data instance,
+   * which holds a reference to it. The offsets have the same meaning
+   * as the m_start, m_zeroAreaStart, m_zeroAreaEnd and m_end fields of
+   * a Buffer.
+   */
+  struct Slab
+  {
+    struct Data *m_data;
+    uint32_t m_start;
+    uint32_t m_zeroAreaStart;
+    uint32_t m_zeroAreaEnd;
+    uint32_t m_end;
+  };
+  /**
+   * The slabs which follow the bytes of a Buffer. Each buffer which
+   * references an instance holds a count, and a buffer must own the
+   * only reference to its tail to modify it.
+   */
+  struct Tail
+  {
+    uint32_t m_count;
+    std::vector<struct Slab> m_slabs;
+  };
+
   void TransformIntoRealBuffer (void) const;
   bool CheckInternalState (void) const;
   void Initialize (uint32_t zeroSize);
   uint32_t GetInternalSize (void) const;
   uint32_t GetInternalEnd (void) const;
+  struct Tail *GetWritableTail (void);
+  void AddSlab (struct Data *data, uint32_t start, uint32_t zeroAreaStart,
+                uint32_t zeroAreaEnd, uint32_t end);
+  void RemoveTailStart (uint32_t start);
+  void RemoveTailEnd (uint32_t end);
+  void ClearTail (void);
+  static void Release (struct Buffer::Tail *tail);
   static void Recycle (struct Buffer::Data *data);
   static struct Buffer::Data *Create (uint32_t size);
   static struct Buffer::Data *Allocate (uint32_t reqSize);
@@ -590,9 +748,9 @@ private:
   /**
    * location in a newly-allocated buffer where you should start
    * writing data. i.e., m_start should be initialized to this 
-   * value.
+   * value. Each thread learns its own value.
    */
-  static uint32_t g_recommendedStart;
+  static __thread uint32_t g_recommendedStart;
 
   /* offset to the start of the virtual zero area from the start 
    * of m_data->m_data
@@ -610,15 +768,19 @@ private:
    * instance from the start of m_data->m_data
    */
   uint32_t m_end;
+  /* the slabs which follow m_end, zero if there are none, and the
+   * number of virtual bytes they hold.
+   */
+  struct Tail *m_tail;
+  uint32_t m_tailSize;
 
 #ifdef BUFFER_FREE_LIST
-  typedef std::vector<struct Buffer::Data*> FreeList;
+  typedef ThreadFreeList<struct Buffer::Data, 1000> FreeList;
   struct LocalStaticDestructor 
   {
     ~LocalStaticDestructor ();
   };
-  static uint32_t g_maxSize;
-  static FreeList *g_freeList;
+  static __thread uint32_t g_maxSize;
   static struct LocalStaticDestructor g_localStaticDestructor;
 #endif
 };
@@ -636,7 +798,11 @@ Buffer::Iterator::Iterator ()
     m_dataStart (0),
     m_dataEnd (0),
     m_current (0),
-    m_data (0)
+    m_segmentStart (0),
+    m_segmentEnd (0),
+    m_segment (0),
+    m_data (0),
+    m_buffer (0)
 {
 }
 Buffer::Iterator::Iterator (Buffer const*buffer)
@@ -656,8 +822,18 @@ Buffer::Iterator::Construct (const Buffer *buffer)
   m_zeroStart = buffer->m_zeroAreaStart;
   m_zeroEnd = buffer->m_zeroAreaEnd;
   m_dataStart = buffer->m_start;
-  m_dataEnd = buffer->m_end;
+  m_dataEnd = buffer->m_end + buffer->m_tailSize;
+  m_segmentStart = buffer->m_start;
+  m_segmentEnd = buffer->m_end;
+  m_segment = 0;
   m_data = buffer->m_data->m_data;
+  m_buffer = buffer;
+}
+
+bool
+Buffer::Iterator::IsInSegment (uint32_t size) const
+{
+  return m_current >= m_segmentStart && m_current + size <= m_segmentEnd;
 }
 
 void 
@@ -690,6 +866,10 @@ Buffer::Iterator::WriteU8 (uint8_t data)
   NS_ASSERT_MSG (Check (m_current),
                  GetWriteErrorMessage ());
 
+  if (!IsInSegment (1))
+    {
+      Seek ();
+    }
   if (m_current < m_zeroStart)
     {
       m_data[m_current] = data;
@@ -707,6 +887,11 @@ Buffer::Iterator::WriteU8 (uint8_t  data, uint32_t len)
 {
   NS_ASSERT_MSG (CheckNoZero (m_current, m_current + len),
                  GetWriteErrorMessage ());
+  if (!IsInSegment (len))
+    {
+      SlowWriteU8 (data, len);
+      return;
+    }
   if (m_current <= m_zeroStart)
     {
       memset (&(m_data[m_current]), data, len);
@@ -725,6 +910,12 @@ Buffer::Iterator::WriteHtonU16 (uint16_t data)
 {
   NS_ASSERT_MSG (CheckNoZero (m_current, m_current + 2),
                  GetWriteErrorMessage ());
+  if (!IsInSegment (2))
+    {
+      WriteU8 ((data >> 8) & 0xff);
+      WriteU8 ((data >> 0) & 0xff);
+      return;
+    }
   uint8_t *buffer;
   if (m_current + 2 <= m_zeroStart)
     {
@@ -744,7 +935,14 @@ Buffer::Iterator::WriteHtonU32 (uint32_t data)
 {
   NS_ASSERT_MSG (CheckNoZero (m_current, m_current + 4),
                  GetWriteErrorMessage ());
-
+  if (!IsInSegment (4))
+    {
+      WriteU8 ((data >> 24) & 0xff);
+      WriteU8 ((data >> 16) & 0xff);
+      WriteU8 ((data >> 8) & 0xff);
+      WriteU8 ((data >> 0) & 0xff);
+      return;
+    }
   uint8_t *buffer;
   if (m_current + 4 <= m_zeroStart)
     {
@@ -765,13 +963,17 @@ uint16_t
 Buffer::Iterator::ReadNtohU16 (void)
 {
   uint8_t *buffer;
+  if (!IsInSegment (2))
+    {
+      return SlowReadNtohU16 ();
+    }
   if (m_current + 2 <= m_zeroStart)
     {
       buffer = &m_data[m_current];
     }
   else if (m_current >= m_zeroEnd)
     {
-      buffer = &m_data[m_current];
+      buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
     }
   else
     {
@@ -789,13 +991,17 @@ uint32_t
 Buffer::Iterator::ReadNtohU32 (void)
 {
   uint8_t *buffer;
+  if (!IsInSegment (4))
+    {
+      return SlowReadNtohU32 ();
+    }
   if (m_current + 4 <= m_zeroStart)
     {
       buffer = &m_data[m_current];
     }
   else if (m_current >= m_zeroEnd)
     {
-      buffer = &m_data[m_current];
+      buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
     }
   else
     {
@@ -820,6 +1026,10 @@ Buffer::Iterator::ReadU8 (void)
                  m_current <= m_dataEnd,
                  GetReadErrorMessage ());
 
+  if (!IsInSegment (1))
+    {
+      Seek ();
+    }
   if (m_current < m_zeroStart)
     {
       uint8_t data = m_data[m_current];
@@ -857,16 +1067,254 @@ Buffer::Buffer (Buffer const&o)
     m_zeroAreaStart (o.m_zeroAreaStart),
     m_zeroAreaEnd (o.m_zeroAreaEnd),
     m_start (o.m_start),
-    m_end (o.m_end)
+    m_end (o.m_end),
+    m_tail (o.m_tail),
+    m_tailSize (o.m_tailSize)
 {
   m_data->m_count++;
+  if (m_tail != 0)
+    {
+      m_tail->m_count++;
+    }
   NS_ASSERT (CheckInternalState ());
 }
 
 uint32_t 
 Buffer::GetSize (void) const
 {
-  return m_end - m_start;
+  return m_end - m_start + m_tailSize;
+}
+
+uint8_t *
+Buffer::Iterator::PeekContiguous (uint32_t size)
+{
+  if (!IsInSegment (size))
+    {
+      if (m_current >= m_dataEnd)
+        {
+          return 0;
+        }
+      Seek ();
+      if (!IsInSegment (size))
+        {
+          return 0;
+        }
+    }
+  if (m_current + size <= m_zeroStart)
+    {
+      return &m_data[m_current];
+    }
+  else if (m_current >= m_zeroEnd)
+    {
+      return &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+    }
+  return 0;
+}
+
+Buffer::WriteSpan::WriteSpan (Iterator &i, uint32_t size)
+  : m_slow (i)
+{
+  NS_ASSERT_MSG (i.CheckNoZero (i.m_current, i.m_current + size),
+                 i.GetWriteErrorMessage ());
+  m_current = i.PeekContiguous (size);
+  m_end = (m_current == 0) ? 0 : m_current + size;
+  i.m_current += size;
+}
+void
+Buffer::WriteSpan::WriteU8 (uint8_t data)
+{
+  if (m_current == 0)
+    {
+      m_slow.WriteU8 (data);
+      return;
+    }
+  NS_ASSERT (m_current + 1 <= m_end);
+  *m_current++ = data;
+}
+void
+Buffer::WriteSpan::WriteU8 (uint8_t data, uint32_t len)
+{
+  if (m_current == 0)
+    {
+      m_slow.WriteU8 (data, len);
+      return;
+    }
+  NS_ASSERT (m_current + len <= m_end);
+  memset (m_current, data, len);
+  m_current += len;
+}
+void
+Buffer::WriteSpan::WriteU16 (uint16_t data)
+{
+  if (m_current == 0)
+    {
+      m_slow.WriteU16 (data);
+      return;
+    }
+  NS_ASSERT (m_current + 2 <= m_end);
+  m_current[0] = data & 0xff;
+  m_current[1] = (data >> 8) & 0xff;
+  m_current += 2;
+}
+void
+Buffer::WriteSpan::WriteHtonU16 (uint16_t data)
+{
+  if (m_current == 0)
+    {
+      m_slow.WriteHtonU16 (data);
+      return;
+    }
+  NS_ASSERT (m_current + 2 <= m_end);
+  m_current[0] = (data >> 8) & 0xff;
+  m_current[1] = data & 0xff;
+  m_current += 2;
+}
+void
+Buffer::WriteSpan::WriteHtonU32 (uint32_t data)
+{
+  if (m_current == 0)
+    {
+      m_slow.WriteHtonU32 (data);
+      return;
+    }
+  NS_ASSERT (m_current + 4 <= m_end);
+  m_current[0] = (data >> 24) & 0xff;
+  m_current[1] = (data >> 16) & 0xff;
+  m_current[2] = (data >> 8) & 0xff;
+  m_current[3] = data & 0xff;
+  m_current += 4;
+}
+void
+Buffer::WriteSpan::WriteHtonU64 (uint64_t data)
+{
+  WriteHtonU32 (data >> 32);
+  WriteHtonU32 (data & 0xffffffff);
+}
+void
+Buffer::WriteSpan::WriteHtolsbU16 (uint16_t data)
+{
+  if (m_current == 0)
+    {
+      m_slow.WriteHtolsbU16 (data);
+      return;
+    }
+  NS_ASSERT (m_current + 2 <= m_end);
+  m_current[0] = data & 0xff;
+  m_current[1] = (data >> 8) & 0xff;
+  m_current += 2;
+}
+void
+Buffer::WriteSpan::Write (uint8_t const *buffer, uint32_t size)
+{
+  if (m_current == 0)
+    {
+      m_slow.Write (buffer, size);
+      return;
+    }
+  NS_ASSERT (m_current + size <= m_end);
+  memcpy (m_current, buffer, size);
+  m_current += size;
+}
+
+Buffer::ReadSpan::ReadSpan (Iterator &i, uint32_t size)
+  : m_slow (i)
+{
+  NS_ASSERT_MSG (i.m_current >= i.m_dataStart &&
+                 i.m_current + size <= i.m_dataEnd,
+                 i.GetReadErrorMessage ());
+  m_current = i.PeekContiguous (size);
+  m_end = (m_current == 0) ? 0 : m_current + size;
+  i.m_current += size;
+}
+uint8_t
+Buffer::ReadSpan::ReadU8 (void)
+{
+  if (m_current == 0)
+    {
+      return m_slow.ReadU8 ();
+    }
+  NS_ASSERT (m_current + 1 <= m_end);
+  return *m_current++;
+}
+uint16_t
+Buffer::ReadSpan::ReadU16 (void)
+{
+  if (m_current == 0)
+    {
+      return m_slow.ReadU16 ();
+    }
+  NS_ASSERT (m_current + 2 <= m_end);
+  uint16_t data = m_current[0] | (m_current[1] << 8);
+  m_current += 2;
+  return data;
+}
+uint16_t
+Buffer::ReadSpan::ReadNtohU16 (void)
+{
+  if (m_current == 0)
+    {
+      return m_slow.ReadNtohU16 ();
+    }
+  NS_ASSERT (m_current + 2 <= m_end);
+  uint16_t data = (m_current[0] << 8) | m_current[1];
+  m_current += 2;
+  return data;
+}
+uint32_t
+Buffer::ReadSpan::ReadNtohU32 (void)
+{
+  if (m_current == 0)
+    {
+      return m_slow.ReadNtohU32 ();
+    }
+  NS_ASSERT (m_current + 4 <= m_end);
+  uint32_t data = ((uint32_t)m_current[0] << 24) | (m_current[1] << 16) |
+    (m_current[2] << 8) | m_current[3];
+  m_current += 4;
+  return data;
+}
+uint64_t
+Buffer::ReadSpan::ReadNtohU64 (void)
+{
+  uint64_t data = ReadNtohU32 ();
+  data <<= 32;
+  data |= ReadNtohU32 ();
+  return data;
+}
+uint16_t
+Buffer::ReadSpan::ReadLsbtohU16 (void)
+{
+  if (m_current == 0)
+    {
+      return m_slow.ReadLsbtohU16 ();
+    }
+  NS_ASSERT (m_current + 2 <= m_end);
+  uint16_t data = m_current[0] | (m_current[1] << 8);
+  m_current += 2;
+  return data;
+}
+void
+Buffer::ReadSpan::Read (uint8_t *buffer, uint32_t size)
+{
+  if (m_current == 0)
+    {
+      m_slow.Read (buffer, size);
+      return;
+    }
+  NS_ASSERT (m_current + size <= m_end);
+  memcpy (buffer, m_current, size);
+  m_current += size;
+}
+void
+Buffer::ReadSpan::Next (uint32_t delta)
+{
+  if (m_current == 0)
+    {
+      m_slow.Next (delta);
+      return;
+    }
+  NS_ASSERT (m_current + delta <= m_end);
+  m_current += delta;
 }
 
 Buffer::Iterator 
@@ -18,6 +18,7 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "byte-tag-list.h"
+#include "thread-free-list.h"
 #include "ns3/log.h"
 #include <vector>
 #include <string.h>
@@ -38,19 +39,23 @@ struct ByteTagListData {
 };
 
 #ifdef USE_FREE_LIST
-static class ByteTagListDataFreeList : public std::vector<struct ByteTagListData *>
+typedef ThreadFreeList<struct ByteTagListData, FREE_LIST_SIZE> ByteTagListDataFreeList;
+static struct LocalStaticDestructor
 {
-public:
-  ~ByteTagListDataFreeList ();
-} g_freeList;
-static uint32_t g_maxSize = 0;
+  ~LocalStaticDestructor ();
+} g_localStaticDestructor;
+/* the size of the largest data released by the calling thread: the
+ * free list of each thread only keeps data of that size.
+ */
+static __thread uint32_t g_maxSize = 0;
 
-ByteTagListDataFreeList::~ByteTagListDataFreeList ()
+LocalStaticDestructor::~LocalStaticDestructor ()
 {
-  for (ByteTagListDataFreeList::iterator i = begin ();
-       i != end (); i++)
+  ByteTagListDataFreeList::Destroy ();
+  struct ByteTagListData *data;
+  while ((data = ByteTagListDataFreeList::Pop ()) != 0)
     {
-      uint8_t *buffer = (uint8_t *)(*i);
+      uint8_t *buffer = (uint8_t *)data;
       delete [] buffer;
     }
 }
@@ -88,8 +93,8 @@ ByteTagList::Iterator::PrepareForNext (void)
       TagBuffer buf = TagBuffer (m_current, m_end);
       m_nextTid = buf.ReadU32 ();
       m_nextSize = buf.ReadU32 ();
-      m_nextStart = buf.ReadU32 ();
-      m_nextEnd = buf.ReadU32 ();
+      m_nextStart = buf.ReadU32 () + m_adjustment;
+      m_nextEnd = buf.ReadU32 () + m_adjustment;
       if (m_nextStart >= m_offsetEnd || m_nextEnd <= m_offsetStart)
         {
           m_current += 4 + 4 + 4 + 4 + m_nextSize;
@@ -100,11 +105,13 @@ ByteTagList::Iterator::PrepareForNext (void)
         }
     }
 }
-ByteTagList::Iterator::Iterator (uint8_t *start, uint8_t *end, int32_t offsetStart, int32_t offsetEnd)
+ByteTagList::Iterator::Iterator (uint8_t *start, uint8_t *end, int32_t offsetStart, int32_t offsetEnd,
+                                 int32_t adjustment)
   : m_current (start),
     m_end (end),
     m_offsetStart (offsetStart),
-    m_offsetEnd (offsetEnd)
+    m_offsetEnd (offsetEnd),
+    m_adjustment (adjustment)
 {
   PrepareForNext ();
 }
@@ -118,12 +125,18 @@ ByteTagList::Iterator::GetOffsetStart (void) const
 
 ByteTagList::ByteTagList ()
   : m_used (0),
+    m_adjustment (0),
+    m_minStart (0),
+    m_maxEnd (0),
     m_data (0)
 {
   NS_LOG_FUNCTION (this);
 }
 ByteTagList::ByteTagList (const ByteTagList &o)
   : m_used (o.m_used),
+    m_adjustment (o.m_adjustment),
+    m_minStart (o.m_minStart),
+    m_maxEnd (o.m_maxEnd),
     m_data (o.m_data)
 {
   NS_LOG_FUNCTION (this << &o);
@@ -144,6 +157,9 @@ ByteTagList::operator = (const ByteTagList &o)
   Deallocate (m_data);
   m_data = o.m_data;
   m_used = o.m_used;
+  m_adjustment = o.m_adjustment;
+  m_minStart = o.m_minStart;
+  m_maxEnd = o.m_maxEnd;
   if (m_data != 0)
     {
       m_data->count++;
@@ -179,6 +195,18 @@ ByteTagList::Add (TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
     }
   TagBuffer tag = TagBuffer (&m_data->data[m_used], 
                              &m_data->data[spaceNeeded]);
+  start -= m_adjustment;
+  end -= m_adjustment;
+  if (m_used == 0)
+    {
+      m_minStart = start;
+      m_maxEnd = end;
+    }
+  else
+    {
+      m_minStart = std::min (m_minStart, start);
+      m_maxEnd = std::max (m_maxEnd, end);
+    }
   tag.WriteU32 (tid.GetUid ());
   tag.WriteU32 (bufferSize);
   tag.WriteU32 (start);
@@ -208,6 +236,7 @@ ByteTagList::RemoveAll (void)
   Deallocate (m_data);
   m_data = 0;
   m_used = 0;
+  m_adjustment = 0;
 }
 
 ByteTagList::Iterator 
@@ -225,11 +254,12 @@ ByteTagList::Begin (int32_t offsetStart, int32_t offsetEnd) const
   NS_LOG_FUNCTION (this << offsetStart << offsetEnd);
   if (m_data == 0)
     {
-      return Iterator (0, 0, offsetStart, offsetEnd);
+      return Iterator (0, 0, offsetStart, offsetEnd, m_adjustment);
     }
   else
     {
-      return Iterator (m_data->data, &m_data->data[m_used], offsetStart, offsetEnd);
+      return Iterator (m_data->data, &m_data->data[m_used], offsetStart, offsetEnd,
+                       m_adjustment);
     }
 }
 
@@ -237,39 +267,22 @@ bool
 ByteTagList::IsDirtyAtEnd (int32_t appendOffset)
 {
   NS_LOG_FUNCTION (this << appendOffset);
-  ByteTagList::Iterator i = BeginAll ();
-  while (i.HasNext ())
-    {
-      ByteTagList::Iterator::Item item = i.Next ();
-      if (item.end > appendOffset)
-        {
-          return true;
-        }
-    }
-  return false;
+  return m_used != 0 && m_maxEnd + m_adjustment > appendOffset;
 }
 
 bool 
 ByteTagList::IsDirtyAtStart (int32_t prependOffset)
 {
   NS_LOG_FUNCTION (this << prependOffset);
-  ByteTagList::Iterator i = BeginAll ();
-  while (i.HasNext ())
-    {
-      ByteTagList::Iterator::Item item = i.Next ();
-      if (item.start < prependOffset)
-        {
-          return true;
-        }
-    }
-  return false;
+  return m_used != 0 && m_minStart + m_adjustment < prependOffset;
 }
 
 void 
 ByteTagList::AddAtEnd (int32_t adjustment, int32_t appendOffset)
 {
   NS_LOG_FUNCTION (this << adjustment << appendOffset);
-  if (adjustment == 0 && !IsDirtyAtEnd (appendOffset))
+  m_adjustment += adjustment;
+  if (!IsDirtyAtEnd (appendOffset))
     {
       return;
     }
@@ -278,8 +291,6 @@ ByteTagList::AddAtEnd (int32_t adjustment, int32_t appendOffset)
   while (i.HasNext ())
     {
       ByteTagList::Iterator::Item item = i.Next ();
-      item.start += adjustment;
-      item.end += adjustment;
 
       if (item.start >= appendOffset)
         {
@@ -303,7 +314,8 @@ void
 ByteTagList::AddAtStart (int32_t adjustment, int32_t prependOffset)
 {
   NS_LOG_FUNCTION (this << adjustment << prependOffset);
-  if (adjustment == 0 && !IsDirtyAtStart (prependOffset))
+  m_adjustment += adjustment;
+  if (!IsDirtyAtStart (prependOffset))
     {
       return;
     }
@@ -312,8 +324,6 @@ ByteTagList::AddAtStart (int32_t adjustment, int32_t prependOffset)
   while (i.HasNext ())
     {
       ByteTagList::Iterator::Item item = i.Next ();
-      item.start += adjustment;
-      item.end += adjustment;
 
       if (item.end <= prependOffset)
         {
@@ -339,11 +349,9 @@ struct ByteTagListData *
 ByteTagList::Allocate (uint32_t size)
 {
   NS_LOG_FUNCTION (this << size);
-  while (!g_freeList.empty ())
+  struct ByteTagListData *data;
+  while ((data = ByteTagListDataFreeList::Pop ()) != 0)
     {
-      struct ByteTagListData *data = g_freeList.back ();
-      g_freeList.pop_back ();
-      NS_ASSERT (data != 0);
       if (data->size >= size)
         {
           data->count = 1;
@@ -354,7 +362,7 @@ ByteTagList::Allocate (uint32_t size)
       delete [] buffer;
     }
   uint8_t *buffer = new uint8_t [std::max (size, g_maxSize) + sizeof (struct ByteTagListData) - 4];
-  struct ByteTagListData *data = (struct ByteTagListData *)buffer;
+  data = (struct ByteTagListData *)buffer;
   data->count = 1;
   data->size = size;
   data->dirty = 0;
@@ -373,16 +381,12 @@ ByteTagList::Deallocate (struct ByteTagListData *data)
   data->count--;
   if (data->count == 0)
     {
-      if (g_freeList.size () > FREE_LIST_SIZE ||
-          data->size < g_maxSize)
+      if (data->size < g_maxSize ||
+          !ByteTagListDataFreeList::Push (data))
         {
           uint8_t *buffer = (uint8_t *)data;
           delete [] buffer;
         }
-      else
-        {
-          g_freeList.push_back (data);
-        }
     }
 }
 
@@ -64,6 +64,14 @@ struct ByteTagListData;
  *     either the next call to Packet::AddHeader or Packet::AddTrailer or when
  *     the user iterates the tag list with Packet::GetTagIterator and 
  *     TagIterator::Next.
+ *
+ *   - the offsets stored in the tag byte buffer are relative to m_adjustment,
+ *     which is private to each ByteTagList instance: the adjustments of
+ *     ByteTagList::AddAtStart and ByteTagList::AddAtEnd only change this
+ *     integer, so the byte buffer stays shared among the copies of a packet.
+ *     It is copied only when a tag must be trimmed because it overlaps the
+ *     bytes added to the packet, which m_minStart and m_maxEnd, the bounds
+ *     of the stored offsets, tell without looking at the tags.
  */
 class ByteTagList
 {
@@ -89,12 +97,14 @@ private:
     uint32_t GetOffsetStart (void) const;
 private:
     friend class ByteTagList;
-    Iterator (uint8_t *start, uint8_t *end, int32_t offsetStart, int32_t offsetEnd);
+    Iterator (uint8_t *start, uint8_t *end, int32_t offsetStart, int32_t offsetEnd,
+              int32_t adjustment);
     void PrepareForNext (void);
     uint8_t *m_current;
     uint8_t *m_end;
     int32_t m_offsetStart;
     int32_t m_offsetEnd;
+    int32_t m_adjustment;
     uint32_t m_nextTid;
     uint32_t m_nextSize;
     int32_t m_nextStart;
@@ -162,6 +172,9 @@ private:
   void Deallocate (struct ByteTagListData *data);
 
   uint16_t m_used;
+  int32_t m_adjustment;
+  int32_t m_minStart;
+  int32_t m_maxEnd;
   struct ByteTagListData *m_data;
 };
 
@@ -22,6 +22,8 @@
 #include "ns3/log.h"
 #include "ns3/uinteger.h"
 #include "net-device.h"
+#include "ns3/packet.h"
+#include "ns3/packet-burst.h"
 
 NS_LOG_COMPONENT_DEFINE ("NetDevice");
 
@@ -42,4 +44,16 @@ NetDevice::~NetDevice ()
   NS_LOG_FUNCTION_NOARGS ();
 }
 
+bool
+NetDevice::SendBurst (Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber)
+{
+  NS_LOG_FUNCTION (this << burst << dest << protocolNumber);
+  bool ok = true;
+  for (std::list<Ptr<Packet> >::const_iterator i = burst->Begin (); i != burst->End (); ++i)
+    {
+      ok = Send (*i, dest, protocolNumber) && ok;
+    }
+  return ok;
+}
+
 } // namespace ns3
@@ -35,6 +35,7 @@ namespace ns3 {
 class Node;
 class Channel;
 class Packet;
+class PacketBurst;
 
 /**
  * \ingroup node
@@ -235,6 +236,22 @@ public:
    * \return whether the Send operation succeeded 
    */
   virtual bool SendFrom(Ptr<Packet> packet, const Address& source, const Address& dest, uint16_t protocolNumber) = 0;
+  /**
+   * \param burst packets sent from above down to Network Device, in
+   *        the order in which they must be sent
+   * \param dest mac address of the destination (already resolved)
+   * \param protocolNumber identifies the type of payload contained in
+   *        these packets. Used to call the right L3Protocol when the
+   *        packets are received.
+   *
+   *  Called from higher layer to send several packets at once into
+   *  Network Device to the specified destination Address. The default
+   *  implementation calls Send for each packet of the burst: subclasses
+   *  can override it to handle the whole burst in a single pass.
+   *
+   * \return true if all the packets of the burst were accepted
+   */
+  virtual bool SendBurst (Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber);
   /**
    * \returns the node base class which contains this network
    *          interface.
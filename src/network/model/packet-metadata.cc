@@ -19,10 +19,12 @@
  */
 #include <utility>
 #include <list>
+#include <iostream>
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 #include "packet-metadata.h"
+#include "thread-free-list.h"
 #include "buffer.h"
 #include "header.h"
 #include "trailer.h"
@@ -33,23 +35,35 @@ namespace ns3 {
 
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
+bool PacketMetadata::m_onDemand = false;
+Callback<bool,uint64_t> PacketMetadata::m_filter;
 bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
+__thread uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+struct PacketMetadata::LocalStaticDestructor PacketMetadata::m_localStaticDestructor;
 
-PacketMetadata::DataFreeList::~DataFreeList ()
+PacketMetadata::LocalStaticDestructor::~LocalStaticDestructor ()
 {
-  for (iterator i = begin (); i != end (); i++)
+  DataFreeList::Destroy ();
+  struct PacketMetadata::Data *data;
+  while ((data = DataFreeList::Pop ()) != 0)
     {
-      PacketMetadata::Deallocate (*i);
+      PacketMetadata::Deallocate (data);
     }
   PacketMetadata::m_enable = false;
+  PacketMetadata::m_onDemand = false;
 }
 
 void 
 PacketMetadata::Enable (void)
 {
+  if (m_onDemand)
+    {
+      NS_LOG_WARN ("The packet metadata is recorded on demand, so it is not "
+                   "enabled for every packet. Call "
+                   "ns3::Packet::DisablePrintingOnDemand first to do so.");
+      return;
+    }
   NS_ASSERT_MSG (!m_metadataSkipped,
                  "Error: attempting to enable the packet metadata "
                  "subsystem too late in the simulation, which is not allowed.\n"
@@ -67,6 +81,28 @@ PacketMetadata::EnableChecking (void)
   m_enableChecking = true;
 }
 
+void
+PacketMetadata::EnableOnDemand (Callback<bool,uint64_t> filter)
+{
+  // the packets which exist already are simply not recorded.
+  m_onDemand = true;
+  m_filter = filter;
+}
+
+void
+PacketMetadata::DisableOnDemand (void)
+{
+  // the packets recorded so far keep recording, the others never will.
+  m_onDemand = false;
+  m_filter = Callback<bool,uint64_t> ();
+}
+
+bool
+PacketMetadata::Select (uint64_t uid)
+{
+  return !m_filter.IsNull () && m_filter (uid);
+}
+
 void
 PacketMetadata::ReserveCopy (uint32_t size)
 {
@@ -498,6 +534,7 @@ PacketMetadata::ReplaceTail (PacketMetadata::SmallItem *item,
 
   // create a copy of the packet.
   PacketMetadata h (m_packetUid, 0);
+  h.m_recording = true;
   uint16_t current = m_head;
   while (current != 0xffff && current != m_tail)
     {
@@ -570,18 +607,17 @@ PacketMetadata::Create (uint32_t size)
     {
       m_maxSize = size;
     }
-  while (!m_freeList.empty ()) 
+  struct PacketMetadata::Data *data;
+  while ((data = DataFreeList::Pop ()) != 0)
     {
-      struct PacketMetadata::Data *data = m_freeList.back ();
-      m_freeList.pop_back ();
       if (data->m_size >= size) 
         {
           NS_LOG_LOGIC ("create found size="<<data->m_size);
           data->m_count = 1;
           return data;
         }
-      PacketMetadata::Deallocate (data);
       NS_LOG_LOGIC ("create dealloc size="<<data->m_size);
+      PacketMetadata::Deallocate (data);
     }
   NS_LOG_LOGIC ("create alloc size="<<m_maxSize);
   return PacketMetadata::Allocate (m_maxSize);
@@ -590,21 +626,17 @@ PacketMetadata::Create (uint32_t size)
 void
 PacketMetadata::Recycle (struct PacketMetadata::Data *data)
 {
-  if (!m_enable)
+  if (!m_enable && !m_onDemand)
     {
       PacketMetadata::Deallocate (data);
       return;
     } 
-  NS_LOG_LOGIC ("recycle size="<<data->m_size<<", list="<<m_freeList.size ());
+  NS_LOG_LOGIC ("recycle size="<<data->m_size);
   NS_ASSERT (data->m_count == 0);
-  if (m_freeList.size () > 1000 ||
-      data->m_size < m_maxSize) 
+  if (data->m_size < m_maxSize ||
+      !DataFreeList::Push (data))
     {
       PacketMetadata::Deallocate (data);
-    } 
-  else 
-    {
-      m_freeList.push_back (data);
     }
 }
 
@@ -653,7 +685,7 @@ void
 PacketMetadata::DoAddHeader (uint32_t uid, uint32_t size)
 {
   NS_LOG_FUNCTION (this << uid << size);
-  if (!m_enable)
+  if (!IsRecording ())
     {
       m_metadataSkipped = true;
       return;
@@ -664,8 +696,7 @@ PacketMetadata::DoAddHeader (uint32_t uid, uint32_t size)
   item.prev = 0xffff;
   item.typeUid = uid;
   item.size = size;
-  item.chunkUid = m_chunkUid;
-  m_chunkUid++;
+  item.chunkUid = __sync_fetch_and_add (&m_chunkUid, 1);
   uint16_t written = AddSmall (&item);
   UpdateHead (written);
 }
@@ -675,7 +706,7 @@ PacketMetadata::RemoveHeader (const Header &header, uint32_t size)
   uint32_t uid = header.GetInstanceTypeId ().GetUid () << 1;
   NS_LOG_FUNCTION (this << uid << size);
   NS_ASSERT (IsStateOk ());
-  if (!m_enable) 
+  if (!IsRecording ()) 
     {
       m_metadataSkipped = true;
       return;
@@ -723,7 +754,7 @@ PacketMetadata::AddTrailer (const Trailer &trailer, uint32_t size)
   uint32_t uid = trailer.GetInstanceTypeId ().GetUid () << 1;
   NS_LOG_FUNCTION (this << uid << size);
   NS_ASSERT (IsStateOk ());
-  if (!m_enable)
+  if (!IsRecording ())
     {
       m_metadataSkipped = true;
       return;
@@ -733,8 +764,7 @@ PacketMetadata::AddTrailer (const Trailer &trailer, uint32_t size)
   item.prev = m_tail;
   item.typeUid = uid;
   item.size = size;
-  item.chunkUid = m_chunkUid;
-  m_chunkUid++;
+  item.chunkUid = __sync_fetch_and_add (&m_chunkUid, 1);
   uint16_t written = AddSmall (&item);
   UpdateTail (written);
   NS_ASSERT (IsStateOk ());
@@ -745,7 +775,7 @@ PacketMetadata::RemoveTrailer (const Trailer &trailer, uint32_t size)
   uint32_t uid = trailer.GetInstanceTypeId ().GetUid () << 1;
   NS_LOG_FUNCTION (this << uid << size);
   NS_ASSERT (IsStateOk ());
-  if (!m_enable) 
+  if (!IsRecording ()) 
     {
       m_metadataSkipped = true;
       return;
@@ -792,7 +822,7 @@ PacketMetadata::AddAtEnd (PacketMetadata const&o)
 {
   NS_LOG_FUNCTION (this << &o);
   NS_ASSERT (IsStateOk ());
-  if (!m_enable) 
+  if (!IsRecording ()) 
     {
       m_metadataSkipped = true;
       return;
@@ -863,7 +893,7 @@ PacketMetadata::AddAtEnd (PacketMetadata const&o)
 void
 PacketMetadata::AddPaddingAtEnd (uint32_t end)
 {
-  if (!m_enable)
+  if (!IsRecording ())
     {
       m_metadataSkipped = true;
       return;
@@ -874,7 +904,7 @@ PacketMetadata::RemoveAtStart (uint32_t start)
 {
   NS_LOG_FUNCTION (this << start);
   NS_ASSERT (IsStateOk ());
-  if (!m_enable) 
+  if (!IsRecording ()) 
     {
       m_metadataSkipped = true;
       return;
@@ -906,6 +936,7 @@ PacketMetadata::RemoveAtStart (uint32_t start)
         {
           // fragment the list item.
           PacketMetadata fragment (m_packetUid, 0);
+          fragment.m_recording = true;
           extraItem.fragmentStart += leftToRemove;
           leftToRemove = 0;
           uint16_t written = fragment.AddBig (0xffff, fragment.m_tail,
@@ -937,7 +968,7 @@ PacketMetadata::RemoveAtEnd (uint32_t end)
 {
   NS_LOG_FUNCTION (this << end);
   NS_ASSERT (IsStateOk ());
-  if (!m_enable) 
+  if (!IsRecording ()) 
     {
       m_metadataSkipped = true;
       return;
@@ -970,6 +1001,7 @@ PacketMetadata::RemoveAtEnd (uint32_t end)
         {
           // fragment the list item.
           PacketMetadata fragment (m_packetUid, 0);
+          fragment.m_recording = true;
           NS_ASSERT (extraItem.fragmentEnd > leftToRemove);
           extraItem.fragmentEnd -= leftToRemove;
           leftToRemove = 0;
@@ -1024,6 +1056,21 @@ PacketMetadata::GetUid (void) const
 {
   return m_packetUid;
 }
+void
+PacketMetadata::Record (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  if (m_recording || (!m_enable && !m_onDemand))
+    {
+      return;
+    }
+  NS_ASSERT (m_head == 0xffff && m_tail == 0xffff);
+  m_recording = true;
+  if (size > 0)
+    {
+      DoAddHeader (0, size);
+    }
+}
 PacketMetadata::ItemIterator 
 PacketMetadata::BeginItem (Buffer buffer) const
 {
@@ -1120,10 +1167,10 @@ PacketMetadata::GetSerializedSize (void) const
   // add 8 bytes for the packet uid
   totalSize += 8;
 
-  // if packet-metadata not enabled, total size
+  // if packet-metadata not recorded, total size
   // is simply 4-bytes for itself plus 8-bytes 
   // for packet uid
-  if (!m_enable)
+  if (!IsRecording ())
     {
       return totalSize;
     }
@@ -1266,6 +1313,8 @@ PacketMetadata::Deserialize (const uint8_t* buffer, uint32_t size)
 
   buffer = ReadFromRawU64 (m_packetUid, start, buffer, size);
   desSize -= 8;
+  // the items are serialized only if the original packet was recorded.
+  m_recording = desSize > 0 || (m_enable && !m_onDemand);
 
   struct PacketMetadata::SmallItem item;
   struct PacketMetadata::ExtraItem extraItem;
@@ -31,6 +31,7 @@ namespace ns3 {
 
 class Chunk;
 class Buffer;
+template <typename T, uint32_t MaxSize> class ThreadFreeList;
 class Header;
 class Trailer;
 
@@ -126,6 +127,23 @@ private:
 
   static void Enable (void);
   static void EnableChecking (void);
+  /**
+   * \param filter called with the uid of each new packet, returns
+   *        true if the metadata of this packet should be recorded.
+   *        May be null.
+   *
+   * Record the metadata of the packets selected by the filter, and of
+   * the packets for which Record is called, rather than of every
+   * packet. Once this mode is selected, Enable does nothing.
+   */
+  static void EnableOnDemand (Callback<bool,uint64_t> filter);
+  /**
+   * Leave the mode selected by EnableOnDemand. The packets created
+   * afterwards are recorded only if Enable was called before
+   * EnableOnDemand. The packets which exist already keep recording
+   * or not, as they did.
+   */
+  static void DisableOnDemand (void);
 
   inline PacketMetadata (uint64_t uid, uint32_t size);
   inline PacketMetadata (PacketMetadata const &o);
@@ -153,6 +171,19 @@ private:
 
   uint64_t GetUid (void) const;
 
+  /**
+   * \param size the current size of the packet
+   *
+   * Start recording the metadata of this packet, if the metadata
+   * subsystem is enabled and it is not recorded yet. The current
+   * content of the packet is recorded as payload.
+   */
+  void Record (uint32_t size);
+  /**
+   * \returns true if the operations on this packet are recorded.
+   */
+  inline bool IsRecording (void) const;
+
   uint32_t GetSerializedSize (void) const;
 
   ItemIterator BeginItem (Buffer buffer) const;
@@ -284,13 +315,13 @@ private:
     uint64_t packetUid;
   };
 
-  class DataFreeList : public std::vector<struct Data *>
+  typedef ThreadFreeList<struct Data, 1000> DataFreeList;
+  struct LocalStaticDestructor
   {
-public:
-    ~DataFreeList ();
+    ~LocalStaticDestructor ();
   };
 
-  friend DataFreeList::~DataFreeList ();
+  friend struct LocalStaticDestructor;
   friend class ItemIterator;
 
   PacketMetadata ();
@@ -322,21 +353,26 @@ public:
   bool IsSharedPointerOk (uint16_t pointer) const;
 
 
+  static bool Select (uint64_t uid);
   static struct PacketMetadata::Data *Create (uint32_t size);
   static void Recycle (struct PacketMetadata::Data *data);
   static struct PacketMetadata::Data *Allocate (uint32_t n);
   static void Deallocate (struct PacketMetadata::Data *data);
 
-  static DataFreeList m_freeList;
+  static struct LocalStaticDestructor m_localStaticDestructor;
   static bool m_enable;
   static bool m_enableChecking;
+  static bool m_onDemand;
+  static Callback<bool,uint64_t> m_filter;
 
   // set to true when adding metadata to a packet is skipped because
   // m_enable is false; used to detect enabling of metadata in the
   // middle of a simulation, which isn't allowed.
   static bool m_metadataSkipped;
 
-  static uint32_t m_maxSize;
+  // the size of the largest metadata created by the calling thread:
+  // the free list of each thread only keeps data of that size.
+  static __thread uint32_t m_maxSize;
   static uint16_t m_chunkUid;
 
   struct Data *m_data;
@@ -348,6 +384,11 @@ public:
   uint16_t m_head;
   uint16_t m_tail;
   uint16_t m_used;
+  /* true if the operations on this packet are recorded: set when the
+   * packet is created, from the mode of the metadata subsystem, or
+   * by Record.
+   */
+  bool m_recording;
   uint64_t m_packetUid;
 };
 
@@ -360,6 +401,7 @@ PacketMetadata::PacketMetadata (uint64_t uid, uint32_t size)
     m_head (0xffff),
     m_tail (0xffff),
     m_used (0),
+    m_recording (m_onDemand ? Select (uid) : m_enable),
     m_packetUid (uid)
 {
   memset (m_data->m_data, 0xff, 4);
@@ -373,6 +415,7 @@ PacketMetadata::PacketMetadata (PacketMetadata const &o)
     m_head (o.m_head),
     m_tail (o.m_tail),
     m_used (o.m_used),
+    m_recording (o.m_recording),
     m_packetUid (o.m_packetUid)
 {
   NS_ASSERT (m_data != 0);
@@ -397,9 +440,15 @@ PacketMetadata::operator = (PacketMetadata const& o)
   m_head = o.m_head;
   m_tail = o.m_tail;
   m_used = o.m_used;
+  m_recording = o.m_recording;
   m_packetUid = o.m_packetUid;
   return *this;
 }
+bool
+PacketMetadata::IsRecording (void) const
+{
+  return m_recording;
+}
 PacketMetadata::~PacketMetadata ()
 {
   NS_ASSERT (m_data != 0);
@@ -20,6 +20,7 @@
 #include "packet-tag-list.h"
 #include "tag-buffer.h"
 #include "tag.h"
+#include "thread-free-list.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 #include <string.h>
@@ -30,21 +31,26 @@ namespace ns3 {
 
 #ifdef USE_FREE_LIST
 
-struct PacketTagList::TagData *PacketTagList::g_free = 0;
-uint32_t PacketTagList::g_nfree = 0;
+typedef ThreadFreeList<struct PacketTagList::TagData, 1000> TagDataFreeList;
+static struct LocalStaticDestructor
+{
+  ~LocalStaticDestructor ()
+  {
+    TagDataFreeList::Destroy ();
+    struct PacketTagList::TagData *data;
+    while ((data = TagDataFreeList::Pop ()) != 0)
+      {
+        delete data;
+      }
+  }
+} g_localStaticDestructor;
 
 struct PacketTagList::TagData *
 PacketTagList::AllocData (void) const
 {
-  NS_LOG_FUNCTION (g_nfree);
-  struct PacketTagList::TagData *retval;
-  if (g_free != 0) 
-    {
-      retval = g_free;
-      g_free = g_free->m_next;
-      g_nfree--;
-    } 
-  else 
+  NS_LOG_FUNCTION_NOARGS ();
+  struct PacketTagList::TagData *retval = TagDataFreeList::Pop ();
+  if (retval == 0) 
     {
       retval = new struct PacketTagList::TagData ();
     }
@@ -54,16 +60,12 @@ PacketTagList::AllocData (void) const
 void
 PacketTagList::FreeData (struct TagData *data) const
 {
-  NS_LOG_FUNCTION (g_nfree << data);
-  if (g_nfree > 1000) 
+  NS_LOG_FUNCTION (data);
+  data->tid = TypeId ();
+  if (!TagDataFreeList::Push (data))
     {
       delete data;
-      return;
     }
-  g_nfree++;
-  data->next = g_free;
-  data->tid = TypeId ();
-  g_free = data;
 }
 #else
 struct PacketTagList::TagData *
@@ -87,6 +89,26 @@ bool
 PacketTagList::Remove (Tag &tag)
 {
   NS_LOG_FUNCTION (this << tag.GetInstanceTypeId ());
+  TypeId tid = tag.GetInstanceTypeId ();
+  int32_t index = FindInline (tid);
+  if (index < 0)
+    {
+      return RemoveFromList (tag);
+    }
+  tag.Deserialize (TagBuffer (m_inlineData[index], m_inlineData[index]+PACKET_TAG_MAX_SIZE));
+  m_nInline--;
+  for (uint32_t i = index; i < m_nInline; i++)
+    {
+      m_inlineTid[i] = m_inlineTid[i+1];
+    }
+  memmove (m_inlineData[index], m_inlineData[index+1],
+           (m_nInline - index) * PACKET_TAG_MAX_SIZE);
+  return true;
+}
+
+bool
+PacketTagList::RemoveFromList (Tag &tag)
+{
   TypeId tid = tag.GetInstanceTypeId ();
   bool found = false;
   for (struct TagData *cur = m_next; cur != 0; cur = cur->next) 
@@ -124,29 +146,65 @@ PacketTagList::Remove (Tag &tag)
       prevNext = &copy->next;
     }
   *prevNext = 0;
-  RemoveAll ();
+  RemoveList ();
   m_next = start;
   return true;
 }
 
+void
+PacketTagList::DeepCopy (PacketTagList const &o)
+{
+  NS_LOG_FUNCTION (this << &o);
+  if (this == &o)
+    {
+      return;
+    }
+  RemoveList ();
+  m_nInline = o.m_nInline;
+  CopyInline (o);
+  struct TagData **prevNext = &m_next;
+  for (struct TagData *cur = o.m_next; cur != 0; cur = cur->next) 
+    {
+      struct TagData *copy = AllocData ();
+      copy->tid = cur->tid;
+      copy->count = 1;
+      copy->next = 0;
+      memcpy (copy->data, cur->data, PACKET_TAG_MAX_SIZE);
+      *prevNext = copy;
+      prevNext = &copy->next;
+    }
+  *prevNext = 0;
+}
+
 void 
 PacketTagList::Add (const Tag &tag) const
 {
   NS_LOG_FUNCTION (this << tag.GetInstanceTypeId ());
+  TypeId tid = tag.GetInstanceTypeId ();
   // ensure this id was not yet added
+  NS_ASSERT (FindInline (tid) < 0);
   for (struct TagData *cur = m_next; cur != 0; cur = cur->next) 
     {
-      NS_ASSERT (cur->tid != tag.GetInstanceTypeId ());
+      NS_ASSERT (cur->tid != tid);
+    }
+  NS_ASSERT (tag.GetSerializedSize () <= PACKET_TAG_MAX_SIZE);
+  PacketTagList *self = const_cast<PacketTagList *> (this);
+  if (m_nInline < PACKET_TAG_INLINE)
+    {
+      uint8_t *data = self->m_inlineData[m_nInline];
+      tag.Serialize (TagBuffer (data, data+tag.GetSerializedSize ()));
+      self->m_inlineTid[m_nInline] = tid;
+      self->m_nInline++;
+      return;
     }
   struct TagData *head = AllocData ();
   head->count = 1;
   head->next = 0;
-  head->tid = tag.GetInstanceTypeId ();
+  head->tid = tid;
   head->next = m_next;
-  NS_ASSERT (tag.GetSerializedSize () <= PACKET_TAG_MAX_SIZE);
   tag.Serialize (TagBuffer (head->data, head->data+tag.GetSerializedSize ()));
 
-  const_cast<PacketTagList *> (this)->m_next = head;
+  self->m_next = head;
 }
 
 bool
@@ -154,6 +212,13 @@ PacketTagList::Peek (Tag &tag) const
 {
   NS_LOG_FUNCTION (this << tag.GetInstanceTypeId ());
   TypeId tid = tag.GetInstanceTypeId ();
+  int32_t index = FindInline (tid);
+  if (index >= 0)
+    {
+      uint8_t *data = const_cast<uint8_t *> (m_inlineData[index]);
+      tag.Deserialize (TagBuffer (data, data+PACKET_TAG_MAX_SIZE));
+      return true;
+    }
   for (struct TagData *cur = m_next; cur != 0; cur = cur->next) 
     {
       if (cur->tid == tid) 
@@ -167,11 +232,5 @@ PacketTagList::Peek (Tag &tag) const
   return false;
 }
 
-const struct PacketTagList::TagData *
-PacketTagList::Head (void) const
-{
-  return m_next;
-}
-
 } // namespace ns3
 
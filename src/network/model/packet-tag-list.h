@@ -22,6 +22,7 @@
 
 #include <stdint.h>
 #include <ostream>
+#include <string.h>
 #include "ns3/type-id.h"
 
 namespace ns3 {
@@ -36,6 +37,19 @@ class Tag;
  */
 #define PACKET_TAG_MAX_SIZE 20
 
+class PacketTagIterator;
+
+/**
+ * \internal
+ * \brief the packet tags of a packet
+ *
+ * The first PACKET_TAG_INLINE tags added to a packet are stored
+ * inside the PacketTagList itself, with their TypeIds in an array of
+ * their own, so that copying a packet does not touch any other memory
+ * and finding one of these tags only scans this array. The tags added
+ * after these are kept in a list of TagData, which is shared by the
+ * copies of a packet until one of them removes a tag from it.
+ */
 class PacketTagList 
 {
 public:
@@ -55,18 +69,31 @@ public:
   bool Remove (Tag &tag);
   bool Peek (Tag &tag) const;
   inline void RemoveAll (void);
-
-  const struct PacketTagList::TagData *Head (void) const;
+  /**
+   * \param o the list to copy
+   *
+   * Replace the content of this list by a copy of o which does not
+   * share any TagData with it.
+   */
+  void DeepCopy (PacketTagList const &o);
 
 private:
+  friend class PacketTagIterator;
+
+  enum {
+    PACKET_TAG_INLINE = 4
+  };
 
-  bool Remove (TypeId tid);
+  inline void CopyInline (PacketTagList const &o);
+  inline void RemoveList (void);
+  inline int32_t FindInline (TypeId tid) const;
+  bool RemoveFromList (Tag &tag);
   struct PacketTagList::TagData *AllocData (void) const;
   void FreeData (struct TagData *data) const;
 
-  static struct PacketTagList::TagData *g_free;
-  static uint32_t g_nfree;
-
+  TypeId m_inlineTid[PACKET_TAG_INLINE];
+  uint8_t m_inlineData[PACKET_TAG_INLINE][PACKET_TAG_MAX_SIZE];
+  uint32_t m_nInline;
   struct TagData *m_next;
 };
 
@@ -79,13 +106,16 @@ private:
 namespace ns3 {
 
 PacketTagList::PacketTagList ()
-  : m_next ()
+  : m_nInline (0),
+    m_next ()
 {
 }
 
 PacketTagList::PacketTagList (PacketTagList const &o)
-  : m_next (o.m_next)
+  : m_nInline (o.m_nInline),
+    m_next (o.m_next)
 {
+  CopyInline (o);
   if (m_next != 0)
     {
       m_next->count++;
@@ -96,26 +126,61 @@ PacketTagList &
 PacketTagList::operator = (PacketTagList const &o)
 {
   // self assignment
-  if (m_next == o.m_next) 
+  if (this == &o) 
     {
       return *this;
     }
-  RemoveAll ();
-  m_next = o.m_next;
-  if (m_next != 0) 
+  m_nInline = o.m_nInline;
+  CopyInline (o);
+  if (m_next != o.m_next)
     {
-      m_next->count++;
+      RemoveList ();
+      m_next = o.m_next;
+      if (m_next != 0) 
+        {
+          m_next->count++;
+        }
     }
   return *this;
 }
 
 PacketTagList::~PacketTagList ()
 {
-  RemoveAll ();
+  RemoveList ();
+}
+
+void
+PacketTagList::CopyInline (PacketTagList const &o)
+{
+  for (uint32_t i = 0; i < m_nInline; i++)
+    {
+      m_inlineTid[i] = o.m_inlineTid[i];
+    }
+  memcpy (m_inlineData, o.m_inlineData, m_nInline * PACKET_TAG_MAX_SIZE);
+}
+
+int32_t
+PacketTagList::FindInline (TypeId tid) const
+{
+  for (uint32_t i = 0; i < m_nInline; i++)
+    {
+      if (m_inlineTid[i] == tid)
+        {
+          return i;
+        }
+    }
+  return -1;
 }
 
 void
 PacketTagList::RemoveAll (void)
+{
+  m_nInline = 0;
+  RemoveList ();
+}
+
+void
+PacketTagList::RemoveList (void)
 {
   struct TagData *prev = 0;
   for (struct TagData *cur = m_next; cur != 0; cur = cur->next) 
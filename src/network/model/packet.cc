@@ -22,15 +22,79 @@
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "thread-free-list.h"
 #include <string>
+#include <set>
 #include <stdarg.h>
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#endif
 
 NS_LOG_COMPONENT_DEFINE ("Packet");
 
+namespace {
+
+/* The memory of the Packet instances which were released and can be
+ * reused, and the statistics of the calling thread about it. The
+ * free list holds at most enough instances for the copies of a packet
+ * sent to every receiver of a large broadcast channel.
+ */
+class PacketMemory
+{};
+typedef ns3::ThreadFreeList<PacketMemory,10000> PacketFreeList;
+
+static struct LocalStaticDestructor
+{
+  ~LocalStaticDestructor ()
+  {
+    PacketFreeList::Destroy ();
+    PacketMemory *p;
+    while ((p = PacketFreeList::Pop ()) != 0)
+      {
+        ::operator delete (p);
+      }
+  }
+} g_localStaticDestructor;
+
+static __thread ns3::Packet::PoolStatistics g_poolStatistics;
+
+}
+
 namespace ns3 {
 
 uint32_t Packet::m_globalUid = 0;
 
+void *
+Packet::operator new (size_t size)
+{
+  NS_ASSERT (size == sizeof (Packet));
+  g_poolStatistics.allocations++;
+  void *p = PacketFreeList::Pop ();
+  if (p != 0)
+    {
+      g_poolStatistics.hits++;
+      return p;
+    }
+  return ::operator new (size);
+}
+
+void
+Packet::operator delete (void *p)
+{
+  if (!PacketFreeList::Push (static_cast<PacketMemory *> (p)))
+    {
+      ::operator delete (p);
+    }
+}
+
+struct Packet::PoolStatistics
+Packet::GetPoolStatistics (void)
+{
+  struct PoolStatistics statistics = g_poolStatistics;
+  statistics.size = PacketFreeList::GetSize ();
+  return statistics;
+}
+
 TypeId 
 ByteTagIterator::Item::GetTypeId (void) const
 {
@@ -82,38 +146,47 @@ ByteTagIterator::ByteTagIterator (ByteTagList::Iterator i)
 }
 
 
-PacketTagIterator::PacketTagIterator (const struct PacketTagList::TagData *head)
-  : m_current (head)
+PacketTagIterator::PacketTagIterator (const PacketTagList *list)
+  : m_list (list),
+    m_current (list->m_next),
+    m_inline (list->m_nInline)
 {
 }
 bool
 PacketTagIterator::HasNext (void) const
 {
-  return m_current != 0;
+  return m_current != 0 || m_inline != 0;
 }
 PacketTagIterator::Item
 PacketTagIterator::Next (void)
 {
   NS_ASSERT (HasNext ());
-  const struct PacketTagList::TagData *prev = m_current;
-  m_current = m_current->next;
-  return PacketTagIterator::Item (prev);
+  // the tags of the list were added after the inline ones.
+  if (m_current != 0)
+    {
+      const struct PacketTagList::TagData *prev = m_current;
+      m_current = m_current->next;
+      return PacketTagIterator::Item (prev->tid, prev->data);
+    }
+  m_inline--;
+  return PacketTagIterator::Item (m_list->m_inlineTid[m_inline], m_list->m_inlineData[m_inline]);
 }
 
-PacketTagIterator::Item::Item (const struct PacketTagList::TagData *data)
-  : m_data (data)
+PacketTagIterator::Item::Item (TypeId tid, const uint8_t *data)
+  : m_tid (tid),
+    m_data (data)
 {
 }
 TypeId
 PacketTagIterator::Item::GetTypeId (void) const
 {
-  return m_data->tid;
+  return m_tid;
 }
 void
 PacketTagIterator::Item::GetTag (Tag &tag) const
 {
-  NS_ASSERT (tag.GetInstanceTypeId () == m_data->tid);
-  tag.Deserialize (TagBuffer ((uint8_t*)m_data->data, (uint8_t*)m_data->data+PACKET_TAG_MAX_SIZE));
+  NS_ASSERT (tag.GetInstanceTypeId () == m_tid);
+  tag.Deserialize (TagBuffer ((uint8_t*)m_data, (uint8_t*)m_data+PACKET_TAG_MAX_SIZE));
 }
 
 
@@ -126,6 +199,24 @@ Packet::Copy (void) const
   return Ptr<Packet> (new Packet (*this), false);
 }
 
+Ptr<Packet>
+Packet::DeepCopy (void) const
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t size = GetSerializedSize ();
+  uint8_t *buffer = new uint8_t[size];
+  Serialize (buffer, size);
+  Ptr<Packet> copy = Create<Packet> (buffer, size, true);
+  delete [] buffer;
+  // the byte tags refer to the offsets of our buffer: move them
+  // to the offsets of the new buffer.
+  copy->m_byteTagList.Add (m_byteTagList);
+  copy->m_byteTagList.AddAtStart (copy->m_buffer.GetCurrentStartOffset () - m_buffer.GetCurrentStartOffset (),
+                                  copy->m_buffer.GetCurrentStartOffset ());
+  copy->m_packetTagList.DeepCopy (m_packetTagList);
+  return copy;
+}
+
 Packet::Packet ()
   : m_buffer (),
     m_byteTagList (),
@@ -136,10 +227,9 @@ Packet::Packet ()
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, 0),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | __sync_fetch_and_add (&m_globalUid, 1), 0),
     m_nixVector (0)
 {
-  m_globalUid++;
 }
 
 Packet::Packet (const Packet &o)
@@ -178,10 +268,9 @@ Packet::Packet (uint32_t size)
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | __sync_fetch_and_add (&m_globalUid, 1), size),
     m_nixVector (0)
 {
-  m_globalUid++;
 }
 Packet::Packet (uint8_t const *buffer, uint32_t size, bool magic)
   : m_buffer (0, false),
@@ -204,10 +293,9 @@ Packet::Packet (uint8_t const*buffer, uint32_t size)
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | __sync_fetch_and_add (&m_globalUid, 1), size),
     m_nixVector (0)
 {
-  m_globalUid++;
   m_buffer.AddAtStart (size);
   Buffer::Iterator i = m_buffer.Begin ();
   i.Write (buffer, size);
@@ -326,7 +414,17 @@ Packet::AddAtEnd (Ptr<const Packet> packet)
   copy.AddAtStart (m_buffer.GetCurrentEndOffset () - bEnd,
                    appendPrependOffset);
   m_byteTagList.Add (copy);
-  m_metadata.AddAtEnd (packet->m_metadata);
+  if (m_metadata.IsRecording () && !packet->m_metadata.IsRecording ())
+    {
+      // the content of the other packet is recorded as payload.
+      PacketMetadata metadata = packet->m_metadata;
+      metadata.Record (packet->GetSize ());
+      m_metadata.AddAtEnd (metadata);
+    }
+  else
+    {
+      m_metadata.AddAtEnd (packet->m_metadata);
+    }
 }
 void
 Packet::AddPaddingAtEnd (uint32_t size)
@@ -561,6 +659,27 @@ Packet::EnableChecking (void)
   PacketMetadata::EnableChecking ();
 }
 
+void
+Packet::EnablePrintingOnDemand (Callback<bool,uint64_t> filter)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  PacketMetadata::EnableOnDemand (filter);
+}
+
+void
+Packet::DisablePrintingOnDemand (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  PacketMetadata::DisableOnDemand ();
+}
+
+void
+Packet::RecordMetadata (void) const
+{
+  NS_LOG_FUNCTION (this);
+  const_cast<PacketMetadata &> (m_metadata).Record (m_buffer.GetSize ());
+}
+
 uint32_t Packet::GetSerializedSize (void) const
 {
   uint32_t size = 0;
@@ -888,7 +1007,7 @@ Packet::PrintPacketTags (std::ostream &os) const
 PacketTagIterator 
 Packet::GetPacketTagIterator (void) const
 {
-  return PacketTagIterator (m_packetTagList.Head ());
+  return PacketTagIterator (&m_packetTagList);
 }
 
 std::ostream& operator<< (std::ostream& os, const Packet &packet)
@@ -1307,8 +1426,258 @@ PacketTest::DoRun (void)
     CHECK (tmp, 1, E (20, 1, 1001));
 #endif
   }
+
+  {
+    // the copies of a packet share its byte tags but see them at their
+    // own offsets, whether their buffer is reallocated or not.
+    Ptr<Packet> tmp = Create<Packet> (100);
+    tmp->AddByteTag (ATestTag<20> ());
+    Ptr<Packet> a = tmp->Copy ();
+    Ptr<Packet> b = tmp->Copy ();
+    for (uint32_t i = 0; i < 20; i++)
+      {
+        a->AddHeader (ATestHeader<100> ());
+      }
+    CHECK (a, 1, E (20, 2000, 2100));
+    b->AddTrailer (ATestTrailer<10> ());
+    b->AddHeader (ATestHeader<10> ());
+    CHECK (b, 1, E (20, 10, 110));
+    CHECK (tmp, 1, E (20, 0, 100));
+    a->AddByteTag (ATestTag<21> ());
+    CHECK (a, 2, E (20, 2000, 2100), E (21, 0, 2100));
+    a->RemoveAtStart (1950);
+    CHECK (a, 2, E (20, 50, 150), E (21, 0, 150));
+    a->AddAtEnd (b);
+    CHECK (a, 3, E (20, 50, 150), E (21, 0, 150), E (20, 160, 260));
+    CHECK (b, 1, E (20, 10, 110));
+    CHECK (tmp, 1, E (20, 0, 100));
+  }
+
+  {
+    // a deep copy keeps the byte tags at the same offsets and the
+    // packet tags, but shares none of them with the original.
+    Ptr<Packet> tmp = Create<Packet> (100);
+    tmp->AddByteTag (ATestTag<20> ());
+    tmp->AddHeader (ATestHeader<10> ());
+    tmp->AddByteTag (ATestTag<21> ());
+    tmp->AddPacketTag (ATestTag<1> ());
+    tmp->AddPacketTag (ATestTag<2> ());
+    tmp->AddPacketTag (ATestTag<3> ());
+    tmp->AddPacketTag (ATestTag<4> ());
+    tmp->AddPacketTag (ATestTag<5> ());
+    Ptr<Packet> copy = tmp->DeepCopy ();
+    NS_TEST_EXPECT_MSG_EQ (copy->GetSize (), 110, "Wrong size");
+    CHECK (copy, 2, E (20, 10, 110), E (21, 0, 110));
+    ATestTag<5> listTag;
+    NS_TEST_EXPECT_MSG_EQ (copy->RemovePacketTag (listTag), true, "Tag missing from the copy");
+    NS_TEST_EXPECT_MSG_EQ (listTag.m_error, false, "Bad tag content");
+    ATestTag<1> inlineTag;
+    NS_TEST_EXPECT_MSG_EQ (copy->PeekPacketTag (inlineTag), true, "Inline tag missing from the copy");
+    NS_TEST_EXPECT_MSG_EQ (tmp->PeekPacketTag (listTag), true, "Tag missing from the original");
+    copy->AddByteTag (ATestTag<22> ());
+    CHECK (tmp, 2, E (20, 10, 110), E (21, 0, 110));
+    ATestHeader<10> h;
+    copy->RemoveHeader (h);
+    NS_TEST_EXPECT_MSG_EQ (h.m_error, false, "Bad header content");
+    CHECK (copy, 3, E (20, 0, 100), E (21, 0, 100), E (22, 0, 100));
+  }
+}
+
+class PacketPoolTest : public TestCase
+{
+public:
+  PacketPoolTest ();
+  virtual void DoRun (void);
+};
+
+PacketPoolTest::PacketPoolTest ()
+  : TestCase ("Packet pool")
+{
+}
+
+void
+PacketPoolTest::DoRun (void)
+{
+  Ptr<Packet> p = Create<Packet> (reinterpret_cast<const uint8_t*> ("hello"), 5);
+  std::vector<Ptr<Packet> > copies;
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      copies.push_back (p->Copy ());
+    }
+  copies.clear ();
+  Packet::PoolStatistics before = Packet::GetPoolStatistics ();
+  NS_TEST_EXPECT_MSG_EQ ((before.size >= 10), true, "The copies were not released to the pool");
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      copies.push_back (p->Copy ());
+      copies.back ()->AddHeader (ATestHeader<2> ());
+    }
+  Packet::PoolStatistics after = Packet::GetPoolStatistics ();
+  NS_TEST_EXPECT_MSG_EQ (after.allocations - before.allocations, 10, "Wrong allocation count");
+  NS_TEST_EXPECT_MSG_EQ (after.hits - before.hits, 10, "The copies were not allocated from the pool");
+  NS_TEST_EXPECT_MSG_EQ (before.size - after.size, 10, "Wrong pool size");
+  // the recycled instances hold the state of the new packets only.
+  for (uint32_t i = 0; i < copies.size (); i++)
+    {
+      uint8_t buf[7];
+      NS_TEST_EXPECT_MSG_EQ (copies[i]->GetSize (), 7, "Bad size");
+      copies[i]->CopyData (buf, 7);
+      NS_TEST_EXPECT_MSG_EQ (memcmp (buf + 2, "hello", 5), 0, "Bad content");
+      NS_TEST_EXPECT_MSG_EQ (copies[i]->GetUid (), p->GetUid (), "Bad uid");
+    }
 }
 //-----------------------------------------------------------------------------
+class PacketTagListTest : public TestCase
+{
+public:
+  PacketTagListTest ();
+  virtual void DoRun (void);
+private:
+  template <int N>
+  bool Check (Ptr<const Packet> p, bool present);
+};
+
+PacketTagListTest::PacketTagListTest ()
+  : TestCase ("Packet tags stored inline and in the overflow list")
+{
+}
+
+template <int N>
+bool
+PacketTagListTest::Check (Ptr<const Packet> p, bool present)
+{
+  ATestTag<N> tag;
+  return p->PeekPacketTag (tag) == present && !tag.m_error;
+}
+
+void
+PacketTagListTest::DoRun (void)
+{
+  Ptr<Packet> p = Create<Packet> (10);
+  // more tags than can be stored inline.
+  p->AddPacketTag (ATestTag<1> ());
+  p->AddPacketTag (ATestTag<2> ());
+  p->AddPacketTag (ATestTag<3> ());
+  p->AddPacketTag (ATestTag<4> ());
+  p->AddPacketTag (ATestTag<5> ());
+  p->AddPacketTag (ATestTag<20> ());
+  Ptr<Packet> copy = p->Copy ();
+
+  ATestTag<2> inlineTag;
+  NS_TEST_EXPECT_MSG_EQ (copy->RemovePacketTag (inlineTag), true, "Could not remove an inline tag");
+  NS_TEST_EXPECT_MSG_EQ (inlineTag.m_error, false, "Bad inline tag content");
+  ATestTag<5> listTag;
+  NS_TEST_EXPECT_MSG_EQ (copy->RemovePacketTag (listTag), true, "Could not remove a tag of the list");
+  NS_TEST_EXPECT_MSG_EQ (listTag.m_error, false, "Bad tag content");
+  NS_TEST_EXPECT_MSG_EQ (copy->RemovePacketTag (listTag), false, "Removed a tag twice");
+  // the original packet is not affected.
+  NS_TEST_EXPECT_MSG_EQ (Check<2> (p, true), true, "Inline tag missing from the original");
+  NS_TEST_EXPECT_MSG_EQ (Check<5> (p, true), true, "Tag missing from the original");
+  NS_TEST_EXPECT_MSG_EQ (Check<2> (copy, false), true, "Removed inline tag found");
+  NS_TEST_EXPECT_MSG_EQ (Check<5> (copy, false), true, "Removed tag found");
+  NS_TEST_EXPECT_MSG_EQ (Check<1> (copy, true), true, "Inline tag missing");
+  NS_TEST_EXPECT_MSG_EQ (Check<3> (copy, true), true, "Inline tag missing");
+  NS_TEST_EXPECT_MSG_EQ (Check<4> (copy, true), true, "Inline tag missing");
+  NS_TEST_EXPECT_MSG_EQ (Check<20> (copy, true), true, "Tag missing");
+
+  // a tag added after a removal goes to the free inline slot.
+  copy->AddPacketTag (ATestTag<6> ());
+  NS_TEST_EXPECT_MSG_EQ (Check<6> (copy, true), true, "Tag missing");
+
+  // the iterator returns the tags of the list first, and then the
+  // inline tags, the most recent first.
+  uint32_t sizes[] = {20, 6, 4, 3, 1};
+  uint32_t n = 0;
+  PacketTagIterator i = p->GetPacketTagIterator ();
+  while (i.HasNext ())
+    {
+      i.Next ();
+      n++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (n, 6, "Wrong number of tags in the original");
+  n = 0;
+  i = copy->GetPacketTagIterator ();
+  while (i.HasNext ())
+    {
+      PacketTagIterator::Item item = i.Next ();
+      NS_TEST_EXPECT_MSG_EQ ((n < 5), true, "Too many tags");
+      if (n < 5)
+        {
+          std::ostringstream oss;
+          oss << "anon::ATestTag<" << sizes[n] << ">";
+          NS_TEST_EXPECT_MSG_EQ (item.GetTypeId ().GetName (), oss.str (), "Wrong tag order");
+        }
+      n++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (n, 5, "Wrong number of tags in the copy");
+
+  copy->RemoveAllPacketTags ();
+  NS_TEST_EXPECT_MSG_EQ (copy->GetPacketTagIterator ().HasNext (), false, "Tags left");
+  NS_TEST_EXPECT_MSG_EQ (Check<20> (p, true), true, "Tag missing from the original");
+}
+
+#ifdef HAVE_PTHREAD_H
+//-----------------------------------------------------------------------------
+class PacketThreadTest : public TestCase
+{
+public:
+  PacketThreadTest ();
+  virtual void DoRun (void);
+private:
+  class Worker
+  {
+public:
+    void Run (void);
+    std::vector<uint64_t> m_uids;
+  };
+};
+
+PacketThreadTest::PacketThreadTest ()
+  : TestCase ("Packets created by many threads")
+{
+}
+
+void
+PacketThreadTest::Worker::Run (void)
+{
+  std::vector<Ptr<Packet> > packets;
+  for (uint32_t i = 0; i < 10000; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (100);
+      p->AddHeader (ATestHeader<10> ());
+      m_uids.push_back (p->GetUid ());
+      // keep some packets for a while to move instances through the
+      // global pool.
+      packets.push_back (p->Copy ());
+      if (packets.size () == 100)
+        {
+          packets.clear ();
+        }
+    }
+}
+
+void
+PacketThreadTest::DoRun (void)
+{
+  // make sure the simulator, which gives its id to the packets, exists.
+  Simulator::GetSystemId ();
+  std::vector<Worker> workers (4);
+  std::vector<Ptr<SystemThread> > threads;
+  for (uint32_t i = 0; i < workers.size (); i++)
+    {
+      threads.push_back (Create<SystemThread> (MakeCallback (&Worker::Run, &workers[i])));
+      threads.back ()->Start ();
+    }
+  std::set<uint64_t> uids;
+  for (uint32_t i = 0; i < workers.size (); i++)
+    {
+      threads[i]->Join ();
+      uids.insert (workers[i].m_uids.begin (), workers[i].m_uids.end ());
+    }
+  NS_TEST_EXPECT_MSG_EQ (uids.size (), 40000, "Two packets got the same uid");
+}
+#endif /* HAVE_PTHREAD_H */
+//-----------------------------------------------------------------------------
 class PacketTestSuite : public TestSuite
 {
 public:
@@ -1319,6 +1688,11 @@ PacketTestSuite::PacketTestSuite ()
   : TestSuite ("packet", UNIT)
 {
   AddTestCase (new PacketTest);
+  AddTestCase (new PacketPoolTest);
+  AddTestCase (new PacketTagListTest);
+#ifdef HAVE_PTHREAD_H
+  AddTestCase (new PacketThreadTest);
+#endif
 }
 
 static PacketTestSuite g_packetTestSuite;
@@ -134,8 +134,9 @@ public:
     void GetTag (Tag &tag) const;
 private:
     friend class PacketTagIterator;
-    Item (const struct PacketTagList::TagData *data);
-    const struct PacketTagList::TagData *m_data;
+    Item (TypeId tid, const uint8_t *data);
+    TypeId m_tid;
+    const uint8_t *m_data;
   };
   /**
    * \returns true if calling Next is safe, false otherwise.
@@ -147,8 +148,10 @@ private:
   Item Next (void);
 private:
   friend class Packet;
-  PacketTagIterator (const struct PacketTagList::TagData *head);
+  PacketTagIterator (const PacketTagList *list);
+  const PacketTagList *m_list;
   const struct PacketTagList::TagData *m_current;
+  uint32_t m_inline;
 };
 
 /**
@@ -171,6 +174,8 @@ private:
  * output from Packet::Print and Packet::Print. If you wish to only enable
  * checking of metadata, and do not need any printing capability, you can
  * call Packet::EnableChecking: its runtime cost is lower than Packet::EnablePrinting.
+ * To pay for it only for some packets, call Packet::EnablePrintingOnDemand
+ * instead.
  *
  * - The set of tags contain simulation-specific information which cannot
  * be stored in the packet byte buffer because the protocol headers or trailers
@@ -373,6 +378,15 @@ public:
    */
   Ptr<Packet> Copy (void) const;
 
+  /**
+   * \returns a copy of the packet which shares no data with it.
+   *
+   * The copy has the same content, metadata, nix-vector, packet tags
+   * and byte tags as the original packet, but none of them are
+   * shared with it, so that it can be handed to another thread.
+   */
+  Ptr<Packet> DeepCopy (void) const;
+
   /**
    * A packet is allocated a new uid when it is created
    * empty or with zero-filled payload.
@@ -429,6 +443,78 @@ public:
    * errors will be detected and will abort the program.
    */
   static void EnableChecking (void);
+  /**
+   * \param filter called with the uid of each new packet, returns
+   *        true if the metadata of this packet should be recorded.
+   *        May be a null callback.
+   *
+   * Keep the metadata needed by the Print methods only for the
+   * packets selected by the filter, as they are created, and for the
+   * packets on which RecordMetadata is called, and for their copies
+   * and fragments. The other packets cost no more than without
+   * metadata, and print nothing. Once this method has been called,
+   * EnablePrinting and EnableChecking, which the ascii trace helpers
+   * call, no longer enable the metadata of all packets. Checking
+   * applies to the recorded packets only.
+   *
+   * A packet which the filter did not select is recorded by the
+   * first ascii trace point which prints it: there, the headers which
+   * were added to it before are printed as a single "Payload".
+   *
+   * \sa RecordMetadata
+   */
+  static void EnablePrintingOnDemand (Callback<bool,uint64_t> filter);
+  /**
+   * Stop selecting the packets whose metadata is kept: the packets
+   * created afterwards keep their metadata only if EnablePrinting was
+   * called before EnablePrintingOnDemand. The packets which exist
+   * already are not affected.
+   */
+  static void DisablePrintingOnDemand (void);
+  /**
+   * Start keeping the metadata of this packet, if
+   * EnablePrintingOnDemand was called and it is not kept yet. The
+   * bytes which are already in the packet are printed as payload: to
+   * print all its headers, call this method as soon as the packet is
+   * created. Like AddPacketTag, this method is const because it does
+   * not change the content of the packet. The ascii trace helpers call
+   * it on each packet they print.
+   */
+  void RecordMetadata (void) const;
+
+  /**
+   * \brief the counters of the pool of Packet instances
+   *
+   * \sa GetPoolStatistics
+   */
+  struct PoolStatistics
+  {
+    /* the number of Packet instances allocated by the calling thread
+     * since its start.
+     */
+    uint64_t allocations;
+    /* the number of these allocations which reused an instance from
+     * the pool rather than allocating memory.
+     */
+    uint64_t hits;
+    /* the number of instances currently held by the pool, for use
+     * by the calling thread or by any other thread.
+     */
+    uint32_t size;
+  };
+  /**
+   * \returns the counters of the pool of Packet instances.
+   *
+   * The Packet instances created by Create<Packet> and Packet::Copy
+   * are allocated from a pool of the instances which were released
+   * earlier, if it is not empty, rather than from the heap. The
+   * hit rate of the pool is hits / allocations. The counters are
+   * kept separately by each thread.
+   */
+  static struct PoolStatistics GetPoolStatistics (void);
+
+  static void *operator new (size_t size);
+  static void operator delete (void *p);
 
   /**
    * For packet serializtion, the total size is checked 
@@ -566,6 +652,9 @@ private:
   /* Please see comments above about nix-vector */
   Ptr<NixVector> m_nixVector;
 
+  /* incremented atomically: packets may be created by many threads
+   * at once.
+   */
   static uint32_t m_globalUid;
 };
 
@@ -609,6 +698,11 @@ std::ostream& operator<< (std::ostream& os, const Packet &packet);
  * dirty operations have been optimized for common use-cases which
  * means that most of the time, these operations will not trigger
  * data copies and will thus be still very fast.
+ *
+ * The Packet instances themselves are recycled: when the last reference
+ * to a packet goes away, its memory is kept in a pool from which the
+ * next packets are allocated. Packet::GetPoolStatistics reports how
+ * often this avoids a heap allocation.
  */
 
 } // namespace ns3
@@ -0,0 +1,280 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef THREAD_FREE_LIST_H
+#define THREAD_FREE_LIST_H
+
+#include "ns3/core-config.h"
+#include <stdint.h>
+#include <vector>
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+namespace ns3 {
+
+/**
+ * \brief a free list which can be used from many threads at once
+ *
+ * This class is used by the packet subsystem to recycle the memory
+ * of its objects. Each thread keeps a small cache of free objects
+ * which it can use without any synchronization. When this cache
+ * overflows, half of it is moved to a global pool, protected by a
+ * spin lock, from which the caches of all threads are refilled when
+ * they run empty. The global pool holds at most MaxSize objects.
+ *
+ * All the storage of this class is zero-initialized so it can be used
+ * from the constructors and destructors of other static objects. The
+ * user must call Destroy from its own static destructor, and then Pop
+ * all the remaining objects to release them: from that point on, Push
+ * always fails. When a thread other than the main thread exits, the
+ * content of its cache is moved to the global pool.
+ */
+template <typename T, uint32_t MaxSize>
+class ThreadFreeList
+{
+public:
+  /**
+   * \returns a free object, or zero if there is none.
+   */
+  static T *Pop (void);
+  /**
+   * \param item the object to keep for later use
+   * \returns false if the object could not be kept, in which case
+   *          the caller must release it.
+   */
+  static bool Push (T *item);
+  /**
+   * Make any subsequent call to Push fail.
+   */
+  static void Destroy (void);
+  /**
+   * \returns the number of objects in the cache of the calling
+   *          thread and in the global pool.
+   */
+  static uint32_t GetSize (void);
+
+private:
+  enum {
+    CACHE_SIZE = 64,
+    BATCH_SIZE = CACHE_SIZE / 2
+  };
+  struct Cache
+  {
+    T *m_items[CACHE_SIZE];
+    uint32_t m_n;
+    bool m_registered;
+  };
+  static void Lock (void);
+  static void Unlock (void);
+  static void Refill (struct Cache *cache);
+  static bool Spill (struct Cache *cache, uint32_t n);
+#ifdef HAVE_PTHREAD_H
+  static void Register (struct Cache *cache);
+  static void CreateKey (void);
+  static void ThreadExit (void *cache);
+  static pthread_once_t g_once;
+  static pthread_key_t g_key;
+#endif
+
+  static __thread struct Cache g_cache;
+  static std::vector<T *> *g_pool;
+  static int g_lock;
+  static bool g_destroyed;
+};
+
+} // namespace ns3
+
+namespace ns3 {
+
+template <typename T, uint32_t MaxSize>
+__thread struct ThreadFreeList<T,MaxSize>::Cache ThreadFreeList<T,MaxSize>::g_cache;
+template <typename T, uint32_t MaxSize>
+std::vector<T *> *ThreadFreeList<T,MaxSize>::g_pool = 0;
+template <typename T, uint32_t MaxSize>
+int ThreadFreeList<T,MaxSize>::g_lock = 0;
+template <typename T, uint32_t MaxSize>
+bool ThreadFreeList<T,MaxSize>::g_destroyed = false;
+#ifdef HAVE_PTHREAD_H
+template <typename T, uint32_t MaxSize>
+pthread_once_t ThreadFreeList<T,MaxSize>::g_once = PTHREAD_ONCE_INIT;
+template <typename T, uint32_t MaxSize>
+pthread_key_t ThreadFreeList<T,MaxSize>::g_key;
+#endif
+
+template <typename T, uint32_t MaxSize>
+T *
+ThreadFreeList<T,MaxSize>::Pop (void)
+{
+  struct Cache *cache = &g_cache;
+  if (cache->m_n == 0)
+    {
+      Refill (cache);
+      if (cache->m_n == 0)
+        {
+          return 0;
+        }
+    }
+  cache->m_n--;
+  return cache->m_items[cache->m_n];
+}
+
+template <typename T, uint32_t MaxSize>
+bool
+ThreadFreeList<T,MaxSize>::Push (T *item)
+{
+  struct Cache *cache = &g_cache;
+  if (g_destroyed)
+    {
+      return false;
+    }
+  if (cache->m_n == CACHE_SIZE && !Spill (cache, BATCH_SIZE))
+    {
+      return false;
+    }
+#ifdef HAVE_PTHREAD_H
+  if (!cache->m_registered)
+    {
+      Register (cache);
+    }
+#endif
+  cache->m_items[cache->m_n] = item;
+  cache->m_n++;
+  return true;
+}
+
+template <typename T, uint32_t MaxSize>
+void
+ThreadFreeList<T,MaxSize>::Destroy (void)
+{
+  g_destroyed = true;
+}
+
+template <typename T, uint32_t MaxSize>
+uint32_t
+ThreadFreeList<T,MaxSize>::GetSize (void)
+{
+  Lock ();
+  uint32_t size = g_cache.m_n + (g_pool == 0 ? 0 : g_pool->size ());
+  Unlock ();
+  return size;
+}
+
+template <typename T, uint32_t MaxSize>
+void
+ThreadFreeList<T,MaxSize>::Lock (void)
+{
+  while (__sync_lock_test_and_set (&g_lock, 1))
+    {
+    }
+}
+
+template <typename T, uint32_t MaxSize>
+void
+ThreadFreeList<T,MaxSize>::Unlock (void)
+{
+  __sync_lock_release (&g_lock);
+}
+
+template <typename T, uint32_t MaxSize>
+void
+ThreadFreeList<T,MaxSize>::Refill (struct Cache *cache)
+{
+  Lock ();
+  if (g_pool != 0)
+    {
+      while (!g_pool->empty () && cache->m_n < BATCH_SIZE)
+        {
+          cache->m_items[cache->m_n] = g_pool->back ();
+          cache->m_n++;
+          g_pool->pop_back ();
+        }
+      if (g_pool->empty () && g_destroyed)
+        {
+          // nothing will ever be pushed to the pool again.
+          delete g_pool;
+          g_pool = 0;
+        }
+    }
+  Unlock ();
+}
+
+template <typename T, uint32_t MaxSize>
+bool
+ThreadFreeList<T,MaxSize>::Spill (struct Cache *cache, uint32_t n)
+{
+  Lock ();
+  if (g_pool == 0)
+    {
+      g_pool = new std::vector<T *> ();
+    }
+  if (g_pool->size () + n > MaxSize)
+    {
+      Unlock ();
+      return false;
+    }
+  while (n > 0)
+    {
+      cache->m_n--;
+      g_pool->push_back (cache->m_items[cache->m_n]);
+      n--;
+    }
+  Unlock ();
+  return true;
+}
+
+#ifdef HAVE_PTHREAD_H
+template <typename T, uint32_t MaxSize>
+void
+ThreadFreeList<T,MaxSize>::Register (struct Cache *cache)
+{
+  // the destructor of the key is not called for the main thread: its
+  // cache is released by the user of this class from Destroy.
+  pthread_once (&g_once, &ThreadFreeList::CreateKey);
+  pthread_setspecific (g_key, cache);
+  cache->m_registered = true;
+}
+
+template <typename T, uint32_t MaxSize>
+void
+ThreadFreeList<T,MaxSize>::CreateKey (void)
+{
+  pthread_key_create (&g_key, &ThreadFreeList::ThreadExit);
+}
+
+template <typename T, uint32_t MaxSize>
+void
+ThreadFreeList<T,MaxSize>::ThreadExit (void *cache)
+{
+  struct Cache *exiting = static_cast<struct Cache *> (cache);
+  Lock ();
+  if (g_pool == 0)
+    {
+      g_pool = new std::vector<T *> ();
+    }
+  // the pool may grow past MaxSize here: the objects of the cache
+  // would be lost otherwise.
+  while (exiting->m_n > 0)
+    {
+      exiting->m_n--;
+      g_pool->push_back (exiting->m_items[exiting->m_n]);
+    }
+  Unlock ();
+}
+#endif
+
+} // namespace ns3
+
+#endif /* THREAD_FREE_LIST_H */
@@ -1,6 +1,9 @@
 #include "ns3/buffer.h"
 #include "ns3/random-variable.h"
 #include "ns3/test.h"
+#include <vector>
+#include <algorithm>
+#include <string.h>
 
 namespace ns3 {
 
@@ -317,6 +320,307 @@ BufferTest::DoRun (void)
   i = other.Begin ();
   i.Write (buffer.Begin (), buffer.End ());
   ENSURE_WRITTEN_BYTES (other, 9, 0x1, 0x2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3, 0x4);
+
+  // spans write and read the same bytes as the iterators, whether
+  // they are contiguous or not.
+  buffer = Buffer (4);
+  buffer.AddAtStart (11);
+  i = buffer.Begin ();
+  {
+    Buffer::WriteSpan span (i, 11);
+    span.WriteU8 (0x1);
+    span.WriteHtonU16 (0x0203);
+    span.WriteHtolsbU16 (0x0504);
+    span.WriteHtonU32 (0x06070809);
+    span.WriteU8 (0xa, 2);
+  }
+  NS_TEST_EXPECT_MSG_EQ (i.GetDistanceFrom (buffer.Begin ()), 11, "Span did not move the iterator");
+  buffer.AddAtEnd (3);
+  i = buffer.End ();
+  i.Prev (3);
+  {
+    uint8_t bytes[] = {0xb, 0xc, 0xd};
+    Buffer::WriteSpan span (i, 3);
+    span.Write (bytes, 3);
+  }
+  ENSURE_WRITTEN_BYTES (buffer, 18, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8, 0x9, 0xa, 0xa,
+                        0x00, 0x00, 0x00, 0x00, 0xb, 0xc, 0xd);
+  for (uint32_t start = 0; start < 18; start++)
+    {
+      // the spans which start after the first byte include the zero area.
+      i = buffer.Begin ();
+      i.Next (start);
+      Buffer::ReadSpan span (i, 18 - start);
+      Buffer::Iterator j = buffer.Begin ();
+      j.Next (start);
+      bool ok = true;
+      for (uint32_t k = start; k + 2 <= 18; k += 2)
+        {
+          ok = ok && span.ReadNtohU16 () == j.ReadNtohU16 ();
+        }
+      NS_TEST_EXPECT_MSG_EQ (ok, true, "Bad span read at " << start);
+      NS_TEST_EXPECT_MSG_EQ (i.IsEnd (), true, "Span did not move the iterator");
+    }
+
+  // the example of RFC 1071, section 3, followed by its checksum.
+  buffer = Buffer ();
+  buffer.AddAtStart (10);
+  i = buffer.Begin ();
+  i.WriteHtonU16 (0x0001);
+  i.WriteHtonU16 (0xf203);
+  i.WriteHtonU16 (0xf4f5);
+  i.WriteHtonU16 (0xf6f7);
+  i.WriteHtonU16 (0);
+  i = buffer.Begin ();
+  uint16_t checksum = i.CalculateIpChecksum (10);
+  NS_TEST_EXPECT_MSG_EQ (i.IsEnd (), true, "Checksum did not consume the buffer");
+  i.Prev (2);
+  i.WriteU16 (checksum);
+  i.Prev (2);
+  NS_TEST_EXPECT_MSG_EQ (i.ReadNtohU16 (), 0x220d, "Bad checksum");
+  i = buffer.Begin ();
+  uint16_t verify = i.CalculateIpChecksum (10);
+  NS_TEST_EXPECT_MSG_EQ (verify, 0, "Bad checksum verification");
+  // change a word and update the checksum rather than calculate it.
+  i = buffer.Begin ();
+  i.Next (2);
+  uint16_t oldValue = i.ReadU16 ();
+  i.Prev (2);
+  i.WriteHtonU16 (0x1234);
+  i.Prev (2);
+  checksum = Buffer::Iterator::UpdateIpChecksum (checksum, oldValue, i.ReadU16 ());
+  i = buffer.Begin ();
+  i.Next (8);
+  i.WriteU16 (checksum);
+  i = buffer.Begin ();
+  verify = i.CalculateIpChecksum (10);
+  NS_TEST_EXPECT_MSG_EQ (verify, 0, "Bad checksum update");
+}
+
+/**
+ * Applies random operations to buffers built by concatenation and
+ * fragmentation, so that they hold slabs, and checks their content
+ * against a plain array of bytes.
+ */
+class BufferSlabTest : public TestCase {
+private:
+  typedef std::vector<uint8_t> Bytes;
+  Buffer Build (Bytes *bytes, uint32_t size);
+  void Fill (Buffer::Iterator i, Bytes::iterator bytes, uint32_t size);
+  bool Compare (const Buffer &buffer, const Bytes &bytes);
+  bool CompareChecksum (const Buffer &buffer, const Bytes &bytes);
+public:
+  virtual void DoRun (void);
+  BufferSlabTest ();
+private:
+  UniformVariable m_rng;
+};
+
+BufferSlabTest::BufferSlabTest ()
+  : TestCase ("Buffer with slabs")
+{
+}
+
+void
+BufferSlabTest::Fill (Buffer::Iterator i, Bytes::iterator bytes, uint32_t size)
+{
+  for (uint32_t j = 0; j < size; j++)
+    {
+      uint8_t byte = m_rng.GetInteger (0, 255);
+      i.WriteU8 (byte);
+      *bytes++ = byte;
+    }
+}
+
+// a buffer with a zero area, data before and after it.
+Buffer
+BufferSlabTest::Build (Bytes *bytes, uint32_t size)
+{
+  uint32_t zeroes = m_rng.GetInteger (0, size);
+  uint32_t before = m_rng.GetInteger (0, size - zeroes);
+  uint32_t after = size - zeroes - before;
+  Buffer buffer = Buffer (zeroes);
+  bytes->assign (size, 0);
+  buffer.AddAtStart (before);
+  Fill (buffer.Begin (), bytes->begin (), before);
+  buffer.AddAtEnd (after);
+  Buffer::Iterator i = buffer.End ();
+  i.Prev (after);
+  Fill (i, bytes->begin () + before + zeroes, after);
+  return buffer;
+}
+
+bool
+BufferSlabTest::Compare (const Buffer &buffer, const Bytes &bytes)
+{
+  if (buffer.GetSize () != bytes.size ())
+    {
+      return false;
+    }
+  Bytes copy (bytes.size () + 1, 0xff);
+  if (buffer.CopyData (&copy[0], copy.size ()) != bytes.size () ||
+      !std::equal (bytes.begin (), bytes.end (), copy.begin ()))
+    {
+      return false;
+    }
+  // byte by byte, forward and backward, and across the slab boundaries.
+  Buffer::Iterator i = buffer.Begin ();
+  for (uint32_t j = 0; j < bytes.size (); j++)
+    {
+      if (i.ReadU8 () != bytes[j])
+        {
+          return false;
+        }
+    }
+  if (!i.IsEnd ())
+    {
+      return false;
+    }
+  for (uint32_t j = bytes.size (); j > 0; j--)
+    {
+      i.Prev ();
+      uint8_t byte = i.ReadU8 ();
+      i.Prev ();
+      if (byte != bytes[j - 1])
+        {
+          return false;
+        }
+    }
+  i = buffer.Begin ();
+  for (uint32_t j = 0; j + 4 <= bytes.size (); j += 3)
+    {
+      uint32_t expected = (bytes[j] << 24) | (bytes[j + 1] << 16) | (bytes[j + 2] << 8) | bytes[j + 3];
+      uint32_t u32 = i.ReadNtohU32 ();
+      i.Prev (4);
+      uint16_t u16 = i.ReadNtohU16 ();
+      i.Next (1);
+      if (u32 != expected || u16 != (expected >> 16))
+        {
+          return false;
+        }
+    }
+  // a span reads the same bytes, whether it is contiguous or not.
+  uint32_t start = m_rng.GetInteger (0, bytes.size ());
+  uint32_t size = m_rng.GetInteger (0, std::min ((uint32_t)bytes.size () - start, 64U));
+  i = buffer.Begin ();
+  i.Next (start);
+  Buffer::ReadSpan span (i, size);
+  for (uint32_t j = start; j < start + size; j++)
+    {
+      if (span.ReadU8 () != bytes[j])
+        {
+          return false;
+        }
+    }
+  if (i.GetDistanceFrom (buffer.Begin ()) != start + size)
+    {
+      return false;
+    }
+  // the serialized form holds the same bytes.
+  // the size given to Deserialize accounts for the length which
+  // Packet::Serialize writes before the buffer.
+  uint32_t serializedSize = buffer.GetSerializedSize ();
+  std::vector<uint32_t> serialized (serializedSize / 4);
+  buffer.Serialize (reinterpret_cast<uint8_t *> (&serialized[0]), serializedSize);
+  Buffer deserialized;
+  deserialized.Deserialize (reinterpret_cast<uint8_t *> (&serialized[0]), serializedSize + 4);
+  Buffer copyOfBuffer = buffer;
+  return deserialized.GetSize () == bytes.size () &&
+         (bytes.empty () ||
+          (memcmp (deserialized.PeekData (), &bytes[0], bytes.size ()) == 0 &&
+           memcmp (copyOfBuffer.PeekData (), &bytes[0], bytes.size ()) == 0));
+}
+
+// the checksum of the bytes at a random offset, calculated over the
+// contiguous regions of the buffer, matches a naive calculation.
+bool
+BufferSlabTest::CompareChecksum (const Buffer &buffer, const Bytes &bytes)
+{
+  uint32_t start = m_rng.GetInteger (0, bytes.size ());
+  uint16_t size = std::min ((uint32_t)bytes.size () - start, 0xffffU);
+  uint32_t initial = m_rng.GetInteger (0, 0xffff);
+  uint32_t sum = initial;
+  for (uint32_t j = 0; j < size; j++)
+    {
+      sum += ((j & 1) == 0) ? bytes[start + j] : (bytes[start + j] << 8);
+      sum = (sum & 0xffff) + (sum >> 16);
+    }
+  Buffer::Iterator i = buffer.Begin ();
+  i.Next (start);
+  uint16_t checksum = i.CalculateIpChecksum (size, initial);
+  return checksum == (uint16_t)~sum &&
+         i.GetDistanceFrom (buffer.Begin ()) == start + size;
+}
+
+void
+BufferSlabTest::DoRun (void)
+{
+  for (uint32_t run = 0; run < 20; run++)
+    {
+      Bytes bytes;
+      Buffer buffer = Build (&bytes, 0);
+      for (uint32_t step = 0; step < 40; step++)
+        {
+          // a copy must not see the changes made to the buffer.
+          Buffer copy = buffer;
+          Bytes copyBytes = bytes;
+          uint32_t size = m_rng.GetInteger (0, 600);
+          switch (m_rng.GetInteger (0, 5))
+            {
+            case 0: {
+                Bytes other;
+                Buffer o = Build (&other, size);
+                buffer.AddAtEnd (o);
+                bytes.insert (bytes.end (), other.begin (), other.end ());
+                NS_TEST_EXPECT_MSG_EQ (Compare (o, other), true, "Appended buffer changed");
+              } break;
+            case 1: {
+                uint32_t start = m_rng.GetInteger (0, bytes.size ());
+                uint32_t length = m_rng.GetInteger (0, bytes.size () - start);
+                Buffer fragment = buffer.CreateFragment (start, length);
+                Bytes fragmentBytes (bytes.begin () + start, bytes.begin () + start + length);
+                NS_TEST_EXPECT_MSG_EQ (Compare (fragment, fragmentBytes), true, "Bad fragment");
+                // put it back, twice.
+                buffer.AddAtEnd (fragment);
+                bytes.insert (bytes.end (), fragmentBytes.begin (), fragmentBytes.end ());
+                buffer.AddAtEnd (buffer);
+                bytes.insert (bytes.end (), bytes.begin (), bytes.end ());
+              } break;
+            case 2:
+              size = std::min (size, (uint32_t)bytes.size ());
+              buffer.RemoveAtStart (size);
+              bytes.erase (bytes.begin (), bytes.begin () + size);
+              break;
+            case 3:
+              size = std::min (size, (uint32_t)bytes.size ());
+              buffer.RemoveAtEnd (size);
+              bytes.erase (bytes.end () - size, bytes.end ());
+              break;
+            case 4:
+              size = m_rng.GetInteger (0, 60);
+              buffer.AddAtStart (size);
+              bytes.insert (bytes.begin (), size, 0);
+              Fill (buffer.Begin (), bytes.begin (), size);
+              break;
+            case 5: {
+                size = m_rng.GetInteger (0, 60);
+                buffer.AddAtEnd (size);
+                bytes.insert (bytes.end (), size, 0);
+                Buffer::Iterator i = buffer.End ();
+                i.Prev (size);
+                Fill (i, bytes.end () - size, size);
+              } break;
+            }
+          NS_TEST_EXPECT_MSG_EQ (Compare (buffer, bytes), true, "Bad content at step " << step);
+          NS_TEST_EXPECT_MSG_EQ (Compare (copy, copyBytes), true, "Copy changed at step " << step);
+          NS_TEST_EXPECT_MSG_EQ (CompareChecksum (buffer, bytes), true, "Bad checksum at step " << step);
+          if (bytes.size () > 100000)
+            {
+              buffer = buffer.CreateFragment (0, 1000);
+              bytes.resize (1000);
+            }
+        }
+    }
 }
 //-----------------------------------------------------------------------------
 class BufferTestSuite : public TestSuite
@@ -329,6 +633,7 @@ BufferTestSuite::BufferTestSuite ()
   : TestSuite ("buffer", UNIT)
 {
   AddTestCase (new BufferTest);
+  AddTestCase (new BufferSlabTest);
 }
 
 static BufferTestSuite g_bufferTestSuite;
@@ -25,6 +25,7 @@
 #include "ns3/trailer.h"
 #include "ns3/packet.h"
 #include "ns3/packet-metadata.h"
+#include "ns3/trace-helper.h"
 
 using namespace ns3;
 
@@ -244,6 +245,12 @@ HistoryTrailer<N>::Deserialize (Buffer::Iterator start)
   return N;
 }
 
+bool
+SelectAll (uint64_t uid)
+{
+  return true;
+}
+
 }
 
 namespace ns3 {
@@ -784,6 +791,53 @@ PacketMetadataTest::DoRun (void)
   p1 = p->CreateFragment (0,6);
   p2 = p->CreateFragment (6,535-6);
   p1->AddAtEnd(p2);
+
+  // on-demand recording: the packets not selected are not recorded.
+  Packet::EnablePrintingOnDemand (MakeNullCallback<bool,uint64_t> ());
+  p = Create<Packet> (100);
+  ADD_HEADER (p, 10);
+  CHECK_HISTORY (p, 0);
+  p->RecordMetadata ();
+  ADD_HEADER (p, 20);
+  CHECK_HISTORY (p, 2, 20, 110);
+  p1 = p->Copy ();
+  ADD_TRAILER (p1, 5);
+  CHECK_HISTORY (p1, 3, 20, 110, 5);
+  CHECK_HISTORY (p, 2, 20, 110);
+  p2 = Create<Packet> (30);
+  ADD_HEADER (p2, 8);
+  p1->AddAtEnd (p2);
+  CHECK_HISTORY (p1, 4, 20, 110, 5, 38);
+  CHECK_HISTORY (p2, 0);
+  p2->AddAtEnd (p);
+  CHECK_HISTORY (p2, 0);
+  p1 = p->CreateFragment (10, 50);
+  CHECK_HISTORY (p1, 2, 10, 40);
+  // the ascii trace sinks record the packets they print.
+  std::ostringstream trace;
+  p = Create<Packet> (100);
+  ADD_HEADER (p, 10);
+  AsciiTraceHelper::DefaultEnqueueSinkWithoutContext (Create<OutputStreamWrapper> (&trace), p);
+  ADD_HEADER (p, 20);
+  CHECK_HISTORY (p, 2, 20, 110);
+  // the packets selected by the filter are recorded from their creation.
+  Packet::EnablePrintingOnDemand (MakeCallback (&SelectAll));
+  p = Create<Packet> (100);
+  ADD_HEADER (p, 10);
+  CHECK_HISTORY (p, 2, 10, 100);
+  // back to the metadata of every packet, as enabled above: the packets
+  // which were not recorded stay so.
+  p2 = Create<Packet> (30);
+  Packet::EnablePrintingOnDemand (MakeNullCallback<bool,uint64_t> ());
+  p1 = Create<Packet> (50);
+  Packet::DisablePrintingOnDemand ();
+  ADD_HEADER (p1, 10);
+  CHECK_HISTORY (p1, 0);
+  ADD_HEADER (p2, 10);
+  CHECK_HISTORY (p2, 2, 10, 30);
+  p = Create<Packet> (100);
+  ADD_HEADER (p, 10);
+  CHECK_HISTORY (p, 2, 10, 100);
 }
 //-----------------------------------------------------------------------------
 class PacketMetadataTestSuite : public TestSuite
@@ -68,6 +68,28 @@ void ReadFrom (Buffer::Iterator &i, Mac48Address &ad)
   ad.CopyFrom (mac);
 }
 
+void WriteTo (Buffer::WriteSpan &i, Ipv4Address ad)
+{
+  i.WriteHtonU32 (ad.Get ());
+}
+void WriteTo (Buffer::WriteSpan &i, Mac48Address ad)
+{
+  uint8_t mac[6];
+  ad.CopyTo (mac);
+  i.Write (mac, 6);
+}
+
+void ReadFrom (Buffer::ReadSpan &i, Ipv4Address &ad)
+{
+  ad.Set (i.ReadNtohU32 ());
+}
+void ReadFrom (Buffer::ReadSpan &i, Mac48Address &ad)
+{
+  uint8_t mac[6];
+  i.Read (mac, 6);
+  ad.CopyFrom (mac);
+}
+
 namespace addressUtils {
 
 bool IsMulticast (const Address &ad)
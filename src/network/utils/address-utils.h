@@ -38,6 +38,12 @@ void ReadFrom (Buffer::Iterator &i, Ipv6Address &ad);
 void ReadFrom (Buffer::Iterator &i, Address &ad, uint32_t len);
 void ReadFrom (Buffer::Iterator &i, Mac48Address &ad);
 
+void WriteTo (Buffer::WriteSpan &i, Ipv4Address ad);
+void WriteTo (Buffer::WriteSpan &i, Mac48Address ad);
+
+void ReadFrom (Buffer::ReadSpan &i, Ipv4Address &ad);
+void ReadFrom (Buffer::ReadSpan &i, Mac48Address &ad);
+
 namespace addressUtils {
 
 /**
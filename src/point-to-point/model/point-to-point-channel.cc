@@ -22,6 +22,11 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/multithreaded-simulator-impl.h"
+#endif
 
 NS_LOG_COMPONENT_DEFINE ("PointToPointChannel");
 
@@ -76,6 +81,13 @@ PointToPointChannel::Attach(Ptr<PointToPointNetDevice> device)
       m_link[1].m_dst = m_link[0].m_src;
       m_link[0].m_state = IDLE;
       m_link[1].m_state = IDLE;
+      for (uint32_t i = 0; i < N_DEVICES; i++)
+        {
+          if (m_link[i].m_dst->GetNode () != 0)
+            {
+              m_link[i].m_dstNode = m_link[i].m_dst->GetNode ()->GetId ();
+            }
+        }
     }
 }
 
@@ -93,12 +105,30 @@ PointToPointChannel::TransmitStart(
 
   uint32_t wire = src == m_link[0].m_src ? 0 : 1;
 
-  Simulator::ScheduleWithContext (m_link[wire].m_dst->GetNode ()->GetId (),
-                                  txTime + m_delay, &PointToPointNetDevice::Receive,
-                                  m_link[wire].m_dst, p);
+  if (m_link[wire].m_dstNode == 0xffffffff)
+    {
+      m_link[wire].m_dstNode = m_link[wire].m_dst->GetNode ()->GetId ();
+    }
+#ifdef HAVE_PTHREAD_H
+  if (MultithreadedSimulatorImpl::IsPartitionBoundary (Simulator::GetContext (), m_link[wire].m_dstNode))
+    {
+      // The receiving node is run by another thread: hand it a deep
+      // copy of the packet and do not share any reference count with it.
+      Simulator::ScheduleWithContext (m_link[wire].m_dstNode,
+                                      txTime + m_delay, &PointToPointNetDevice::Receive,
+                                      PeekPointer (m_link[wire].m_dst), p->DeepCopy ());
+    }
+  else
+#endif
+    {
+      Simulator::ScheduleWithContext (m_link[wire].m_dstNode,
+                                      txTime + m_delay, &PointToPointNetDevice::Receive,
+                                      m_link[wire].m_dst, p);
+    }
 
-  // Call the tx anim callback on the net device
-  m_txrxPointToPoint (p, src, m_link[wire].m_dst, txTime, txTime + m_delay);
+  // Call the tx anim callback on the net device. The multithreaded
+  // simulator keeps both devices in the same thread when somebody listens.
+  NS_TRACE (m_txrxPointToPoint, p, src, m_link[wire].m_dst, txTime, txTime + m_delay);
   return true;
 }
 
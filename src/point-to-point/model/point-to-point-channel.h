@@ -154,10 +154,13 @@ private:
   class Link
   {
   public:
-    Link() : m_state (INITIALIZING), m_src (0), m_dst (0) {}
+    Link() : m_state (INITIALIZING), m_src (0), m_dst (0), m_dstNode (0xffffffff) {}
     WireState                  m_state;
     Ptr<PointToPointNetDevice> m_src;
     Ptr<PointToPointNetDevice> m_dst;
+    // id of the node of m_dst, cached to avoid touching the reference
+    // count of that node when it is run by another thread.
+    uint32_t                   m_dstNode;
   };
     
   Link    m_link[N_DEVICES];
@@ -25,6 +25,7 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 #include "ns3/pointer.h"
+#include "ns3/packet-burst.h"
 #include "ns3/mpi-interface.h"
 #include "point-to-point-net-device.h"
 #include "point-to-point-channel.h"
@@ -487,6 +488,40 @@ PointToPointNetDevice::Send(
 
   m_macTxTrace (packet);
 
+  return EnqueueOrTransmit (packet);
+}
+
+bool
+PointToPointNetDevice::SendBurst (
+  Ptr<PacketBurst> burst, 
+  const Address &dest, 
+  uint16_t protocolNumber)
+{
+  NS_LOG_FUNCTION (this << burst << burst->GetNPackets ());
+
+  if (IsLinkUp () == false)
+    {
+      for (std::list<Ptr<Packet> >::const_iterator i = burst->Begin (); i != burst->End (); ++i)
+        {
+          m_macTxDropTrace (*i);
+        }
+      return false;
+    }
+
+  bool ok = true;
+  for (std::list<Ptr<Packet> >::const_iterator i = burst->Begin (); i != burst->End (); ++i)
+    {
+      Ptr<Packet> packet = *i;
+      AddHeader(packet, protocolNumber);
+      m_macTxTrace (packet);
+      ok = EnqueueOrTransmit (packet) && ok;
+    }
+  return ok;
+}
+
+bool
+PointToPointNetDevice::EnqueueOrTransmit (Ptr<Packet> packet)
+{
   //
   // If there's a transmission in progress, we enque the packet for later
   // transmission; otherwise we send it now.
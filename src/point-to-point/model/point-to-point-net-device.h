@@ -167,6 +167,7 @@ public:
 
   virtual bool Send(Ptr<Packet> packet, const Address &dest, uint16_t protocolNumber);
   virtual bool SendFrom(Ptr<Packet> packet, const Address& source, const Address& dest, uint16_t protocolNumber);
+  virtual bool SendBurst (Ptr<PacketBurst> burst, const Address &dest, uint16_t protocolNumber);
 
   virtual Ptr<Node> GetNode (void) const;
   virtual void SetNode (Ptr<Node> node);
@@ -233,6 +234,15 @@ private:
    */
   bool TransmitStart (Ptr<Packet> p);
 
+  /**
+   * Start sending a packet which was given to the device by the upper
+   * layers, or enqueue it if a transmission is in progress.
+   *
+   * @param p a reference to the packet to send
+   * @returns true if success, false on failure
+   */
+  bool EnqueueOrTransmit (Ptr<Packet> p);
+
   /**
    * Stop Sending a Packet Down the Wire and Begin the Interframe Gap.
    *
@@ -1,6 +1,7 @@
 #include "ns3/test.h"
 #include "ns3/drop-tail-queue.h"
 #include "ns3/simulator.h"
+#include "ns3/packet-burst.h"
 #include "point-to-point-net-device.h"
 #include "point-to-point-channel.h"
 
@@ -54,6 +55,76 @@ PointToPointTest::DoRun (void)
 
   Simulator::Destroy ();
 }
+
+class PointToPointBurstTest : public TestCase
+{
+public:
+  PointToPointBurstTest ();
+
+  virtual void DoRun (void);
+
+private:
+  void SendBurst (Ptr<PointToPointNetDevice> device);
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t protocol, const Address &from);
+  std::vector<uint32_t> m_received;
+};
+
+PointToPointBurstTest::PointToPointBurstTest ()
+  : TestCase ("PointToPoint SendBurst")
+{}
+
+void
+PointToPointBurstTest::SendBurst (Ptr<PointToPointNetDevice> device)
+{
+  Ptr<PacketBurst> burst = Create<PacketBurst> ();
+  for (uint32_t i = 1; i <= 5; i++)
+    {
+      burst->AddPacket (Create<Packet> (i * 100));
+    }
+  bool sent = device->SendBurst (burst, device->GetBroadcast (), 0x800);
+  NS_TEST_EXPECT_MSG_EQ (sent, true, "Burst not queued");
+}
+
+bool
+PointToPointBurstTest::Receive (Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t protocol, const Address &from)
+{
+  NS_TEST_EXPECT_MSG_EQ (protocol, 0x800, "Wrong protocol");
+  m_received.push_back (p->GetSize ());
+  return true;
+}
+
+void
+PointToPointBurstTest::DoRun (void)
+{
+  Ptr<Node> a = CreateObject<Node> ();
+  Ptr<Node> b = CreateObject<Node> ();
+  Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel> ();
+
+  devA->Attach (channel);
+  devA->SetAddress (Mac48Address::Allocate ());
+  devA->SetQueue (CreateObject<DropTailQueue> ());
+  devB->Attach (channel);
+  devB->SetAddress (Mac48Address::Allocate ());
+  devB->SetQueue (CreateObject<DropTailQueue> ());
+
+  a->AddDevice (devA);
+  b->AddDevice (devB);
+  devB->SetReceiveCallback (MakeCallback (&PointToPointBurstTest::Receive, this));
+
+  Simulator::Schedule (Seconds (1.0), &PointToPointBurstTest::SendBurst, this, devA);
+
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_received.size (), 5, "Some packets of the burst were lost");
+  for (uint32_t i = 0; i < m_received.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_received[i], (i + 1) * 100, "Packets of the burst received out of order");
+    }
+
+  Simulator::Destroy ();
+}
 //-----------------------------------------------------------------------------
 class PointToPointTestSuite : public TestSuite
 {
@@ -65,6 +136,7 @@ PointToPointTestSuite::PointToPointTestSuite ()
   : TestSuite ("devices-point-to-point", UNIT)
 {
   AddTestCase (new PointToPointTest);
+  AddTestCase (new PointToPointBurstTest);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite;
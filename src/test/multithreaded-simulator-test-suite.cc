@@ -0,0 +1,429 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/global-value.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/channel.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/packet.h"
+#include "ns3/tag.h"
+
+#include <algorithm>
+#include <vector>
+#include <utility>
+
+using namespace ns3;
+
+/**
+ * Runs the same set of synthetic events on a ring of nodes connected
+ * by point-to-point links, first with the default simulator and then
+ * with the multithreaded simulator, and checks that every node sees
+ * exactly the same events at the same times.
+ */
+class MultithreadedSimulatorTestCase : public TestCase
+{
+public:
+  MultithreadedSimulatorTestCase ();
+
+private:
+  typedef std::vector<std::pair<uint64_t, uint32_t> > Records;
+
+  virtual void DoRun (void);
+  void RunOnce (std::string impl, std::vector<Records> &records);
+  void Handle (uint32_t node, uint32_t value);
+
+  std::vector<Records> *m_records;
+  std::vector<uint32_t> m_badContext;
+};
+
+static const uint32_t N_NODES = 8;
+
+MultithreadedSimulatorTestCase::MultithreadedSimulatorTestCase ()
+  : TestCase ("Check that the multithreaded simulator runs events like the default simulator")
+{
+}
+
+void
+MultithreadedSimulatorTestCase::Handle (uint32_t node, uint32_t value)
+{
+  // only the thread which runs this node touches its records.
+  (*m_records)[node].push_back (std::make_pair (Simulator::Now ().GetTimeStep (), value));
+  if (Simulator::GetContext () != node)
+    {
+      m_badContext[node]++;
+    }
+  uint32_t next = value * 1103515245 + 12345;
+  uint32_t choice = next >> 16;
+  if (choice % 3 == 0)
+    {
+      // send to a neighbour, never earlier than the link delay.
+      uint32_t neighbour = (choice & 0x8) ? (node + 1) % N_NODES : (node + N_NODES - 1) % N_NODES;
+      Simulator::ScheduleWithContext (neighbour, MilliSeconds (2) + MicroSeconds (choice % 50),
+                                      &MultithreadedSimulatorTestCase::Handle, this, neighbour, next);
+    }
+  else
+    {
+      Simulator::Schedule (MicroSeconds (1 + choice % 100),
+                           &MultithreadedSimulatorTestCase::Handle, this, node, next);
+    }
+}
+
+void
+MultithreadedSimulatorTestCase::RunOnce (std::string impl, std::vector<Records> &records)
+{
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue (impl));
+  records.clear ();
+  records.resize (N_NODES);
+  m_records = &records;
+
+  NodeContainer nodes;
+  nodes.Create (N_NODES);
+  PointToPointHelper p2p;
+  p2p.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  for (uint32_t i = 0; i < N_NODES; i++)
+    {
+      p2p.Install (nodes.Get (i), nodes.Get ((i + 1) % N_NODES));
+    }
+
+  for (uint32_t i = 0; i < N_NODES; i++)
+    {
+      for (uint32_t j = 0; j < 4; j++)
+        {
+          Simulator::ScheduleWithContext (i, MicroSeconds (j * 10), &MultithreadedSimulatorTestCase::Handle,
+                                          this, i, i * 4 + j);
+        }
+    }
+  // the events all happen on a microsecond boundary: none of them
+  // can share its timestamp with the stop event.
+  Simulator::Stop (Seconds (1) + NanoSeconds (500));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // events which happen at the same time on a node, but which were
+  // sent from different threads, are run in an unspecified order.
+  for (uint32_t i = 0; i < N_NODES; i++)
+    {
+      std::sort (records[i].begin (), records[i].end ());
+    }
+}
+
+void
+MultithreadedSimulatorTestCase::DoRun (void)
+{
+  Simulator::Destroy ();
+  m_badContext.assign (N_NODES, 0);
+  std::vector<Records> expected;
+  RunOnce ("ns3::DefaultSimulatorImpl", expected);
+
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue (4));
+  std::vector<Records> got;
+  RunOnce ("ns3::MultithreadedSimulatorImpl", got);
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue (0));
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+
+  for (uint32_t i = 0; i < N_NODES; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_badContext[i], 0, "Events run with the wrong context on node " << i);
+      NS_TEST_EXPECT_MSG_EQ ((expected[i].size () > 100), true, "Too few events on node " << i);
+      NS_TEST_EXPECT_MSG_EQ (got[i].size (), expected[i].size (), "Wrong number of events on node " << i);
+      NS_TEST_EXPECT_MSG_EQ ((got[i] == expected[i]), true, "Different events on node " << i);
+    }
+}
+
+/**
+ * Counts the number of hops made by a packet.
+ */
+class HopTag : public Tag
+{
+public:
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::MultithreadedSimulatorTestHopTag")
+      .SetParent<Tag> ()
+      .AddConstructor<HopTag> ()
+      .HideFromDocumentation ()
+    ;
+    return tid;
+  }
+  virtual TypeId GetInstanceTypeId (void) const
+  {
+    return GetTypeId ();
+  }
+  virtual uint32_t GetSerializedSize (void) const
+  {
+    return 4;
+  }
+  virtual void Serialize (TagBuffer buf) const
+  {
+    buf.WriteU32 (m_hops);
+  }
+  virtual void Deserialize (TagBuffer buf)
+  {
+    m_hops = buf.ReadU32 ();
+  }
+  virtual void Print (std::ostream &os) const
+  {
+    os << m_hops;
+  }
+  HopTag ()
+    : m_hops (0)
+  {
+  }
+  uint32_t m_hops;
+};
+
+/**
+ * Sends packets around a ring of nodes connected by point-to-point
+ * links, first with the default simulator and then with the
+ * multithreaded simulator, and checks that every node receives the
+ * same packets, with the same tags, in the same order and at the
+ * same times. The simulation is either stopped at a fixed time or by
+ * one of the nodes, right away or after a delay longer than the
+ * lookahead.
+ */
+class MultithreadedPointToPointTestCase : public TestCase
+{
+public:
+  enum StopMode
+  {
+    STOP_AT_END,
+    STOP_FROM_NODE,
+    STOP_LATER_FROM_NODE
+  };
+  MultithreadedPointToPointTestCase (enum StopMode stopMode);
+
+private:
+  typedef std::vector<std::pair<uint64_t, uint32_t> > Records;
+
+  virtual void DoRun (void);
+  void RunOnce (std::string impl, std::vector<Records> &records, std::vector<uint32_t> &transmissions);
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+  void Transmit (Ptr<const Packet> packet, Ptr<NetDevice> src, Ptr<NetDevice> dst,
+                 Time txTime, Time rxTime);
+
+  enum StopMode m_stopMode;
+  uint64_t m_stopTs;
+  std::vector<Records> *m_records;
+  std::vector<uint32_t> *m_transmissions;
+  std::vector<Ptr<NetDevice> > m_next;
+};
+
+static const uint32_t STOP_HOPS = 60;
+
+MultithreadedPointToPointTestCase::MultithreadedPointToPointTestCase (enum StopMode stopMode)
+  : TestCase (stopMode == STOP_FROM_NODE ?
+              "Check that the multithreaded simulator stops like the default simulator when a node calls Stop" :
+              stopMode == STOP_LATER_FROM_NODE ?
+              "Check that the multithreaded simulator stops exactly when a node calls Stop with a delay" :
+              "Check that the multithreaded simulator delivers point-to-point packets like the default simulator"),
+    m_stopMode (stopMode)
+{
+}
+
+bool
+MultithreadedPointToPointTestCase::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                                            uint16_t protocol, const Address &from)
+{
+  uint32_t node = device->GetNode ()->GetId ();
+  Ptr<Packet> copy = packet->Copy ();
+  HopTag tag;
+  copy->RemovePacketTag (tag);
+  // only the thread which runs this node touches its records.
+  (*m_records)[node].push_back (std::make_pair (Simulator::Now ().GetTimeStep (),
+                                                tag.m_hops * 10000 + copy->GetSize ()));
+  if (m_stopMode != STOP_AT_END && node == 0 && tag.m_hops == STOP_HOPS && m_stopTs == 0)
+    {
+      if (m_stopMode == STOP_FROM_NODE)
+        {
+          m_stopTs = Simulator::Now ().GetTimeStep ();
+          Simulator::Stop ();
+        }
+      else
+        {
+          m_stopTs = (Simulator::Now () + MilliSeconds (5)).GetTimeStep ();
+          Simulator::Stop (MilliSeconds (5));
+        }
+    }
+  tag.m_hops++;
+  copy->AddPacketTag (tag);
+  m_next[node]->Send (copy, m_next[node]->GetBroadcast (), 0x0800);
+  return true;
+}
+
+void
+MultithreadedPointToPointTestCase::Transmit (Ptr<const Packet> packet,
+                                             Ptr<NetDevice> src, Ptr<NetDevice> dst,
+                                             Time txTime, Time rxTime)
+{
+  (*m_transmissions)[src->GetNode ()->GetId ()]++;
+}
+
+void
+MultithreadedPointToPointTestCase::RunOnce (std::string impl, std::vector<Records> &records,
+                                            std::vector<uint32_t> &transmissions)
+{
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue (impl));
+  records.clear ();
+  records.resize (N_NODES);
+  m_records = &records;
+  transmissions.assign (N_NODES, 0);
+  m_transmissions = &transmissions;
+  m_stopTs = 0;
+
+  NodeContainer nodes;
+  nodes.Create (N_NODES);
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  m_next.clear ();
+  m_next.resize (N_NODES);
+  for (uint32_t i = 0; i < N_NODES; i++)
+    {
+      // packets only travel from node i to node i + 1, so that each
+      // node receives them from a single thread.
+      NetDeviceContainer devices = p2p.Install (nodes.Get (i), nodes.Get ((i + 1) % N_NODES));
+      m_next[i] = devices.Get (0);
+      devices.Get (1)->SetReceiveCallback (MakeCallback (&MultithreadedPointToPointTestCase::Receive, this));
+      if (i % 2 == 0)
+        {
+          // the nodes of a traced channel are run by the same thread:
+          // leave the other channels between threads.
+          devices.Get (0)->GetChannel ()->TraceConnectWithoutContext
+            ("TxRxPointToPoint", MakeCallback (&MultithreadedPointToPointTestCase::Transmit, this));
+        }
+    }
+
+  for (uint32_t i = 0; i < N_NODES; i++)
+    {
+      for (uint32_t j = 0; j < 4; j++)
+        {
+          Ptr<Packet> p = Create<Packet> (100 + 37 * i + 11 * j);
+          p->AddPacketTag (HopTag ());
+          Simulator::ScheduleWithContext (i, MicroSeconds (7 * i + 100 * j), &NetDevice::Send, m_next[i],
+                                          p, m_next[i]->GetBroadcast (), 0x0800);
+        }
+    }
+  Simulator::Stop (Seconds (1));
+  Simulator::Run ();
+  m_next.clear ();
+  Simulator::Destroy ();
+}
+
+void
+MultithreadedPointToPointTestCase::DoRun (void)
+{
+  Simulator::Destroy ();
+  std::vector<Records> expected;
+  std::vector<uint32_t> expectedTransmissions;
+  RunOnce ("ns3::DefaultSimulatorImpl", expected, expectedTransmissions);
+  uint64_t expectedStopTs = m_stopTs;
+
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue (4));
+  std::vector<Records> got;
+  std::vector<uint32_t> gotTransmissions;
+  RunOnce ("ns3::MultithreadedSimulatorImpl", got, gotTransmissions);
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue (0));
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+
+  if (m_stopMode == STOP_LATER_FROM_NODE)
+    {
+      NS_TEST_ASSERT_MSG_NE (expectedStopTs, 0, "Node 0 did not stop the simulation");
+      NS_TEST_EXPECT_MSG_EQ (m_stopTs, expectedStopTs, "Stopped at a different time");
+      // no partition runs past the stop, and the events at the time of
+      // the stop may or may not have run with the default simulator.
+      for (uint32_t i = 0; i < N_NODES; i++)
+        {
+          for (Records::iterator k = got[i].begin (); k != got[i].end (); k++)
+            {
+              NS_TEST_EXPECT_MSG_EQ ((k->first <= expectedStopTs), true,
+                                     "Event run after the stop on node " << i);
+            }
+          while (!got[i].empty () && got[i].back ().first == expectedStopTs)
+            {
+              got[i].pop_back ();
+            }
+          while (!expected[i].empty () && expected[i].back ().first >= expectedStopTs)
+            {
+              expected[i].pop_back ();
+            }
+        }
+    }
+  else if (m_stopMode == STOP_FROM_NODE)
+    {
+      NS_TEST_ASSERT_MSG_NE (expectedStopTs, 0, "Node 0 did not stop the simulation");
+      NS_TEST_EXPECT_MSG_EQ (m_stopTs, expectedStopTs, "Stopped at a different time");
+      // the other threads may have run the events which follow the
+      // stop in the same window, but no event of a later window, and
+      // the events at the time of the stop on other nodes may or may
+      // not have run.
+      uint64_t lookAhead = MilliSeconds (2).GetTimeStep ();
+      for (uint32_t i = 0; i < N_NODES; i++)
+        {
+          Records::iterator j = got[i].begin ();
+          while (j != got[i].end () && j->first < expectedStopTs)
+            {
+              j++;
+            }
+          for (Records::iterator k = j; k != got[i].end (); k++)
+            {
+              NS_TEST_EXPECT_MSG_EQ ((k->first < expectedStopTs + lookAhead), true,
+                                     "Event run after the stop on node " << i);
+              // nodes 0 and 1 share a traced channel, hence a thread,
+              // which stops right away.
+              NS_TEST_EXPECT_MSG_EQ ((i > 1 || k->first == expectedStopTs), true,
+                                     "Event run after the stop on node " << i);
+            }
+          got[i].erase (j, got[i].end ());
+          j = expected[i].begin ();
+          while (j != expected[i].end () && j->first < expectedStopTs)
+            {
+              j++;
+            }
+          expected[i].erase (j, expected[i].end ());
+        }
+    }
+
+  for (uint32_t i = 0; i < N_NODES; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((expected[i].size () > 100), true, "Too few packets on node " << i);
+      NS_TEST_EXPECT_MSG_EQ (got[i].size (), expected[i].size (), "Wrong number of packets on node " << i);
+      NS_TEST_EXPECT_MSG_EQ ((got[i] == expected[i]), true, "Different packets on node " << i);
+      if (m_stopMode == STOP_AT_END)
+        {
+          NS_TEST_EXPECT_MSG_EQ (gotTransmissions[i], expectedTransmissions[i],
+                                 "Wrong number of transmissions by node " << i);
+        }
+    }
+}
+
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+public:
+  MultithreadedSimulatorTestSuite ()
+    : TestSuite ("multithreaded-simulator", SYSTEM)
+  {
+    AddTestCase (new MultithreadedSimulatorTestCase ());
+    AddTestCase (new MultithreadedPointToPointTestCase (MultithreadedPointToPointTestCase::STOP_AT_END));
+    AddTestCase (new MultithreadedPointToPointTestCase (MultithreadedPointToPointTestCase::STOP_FROM_NODE));
+    AddTestCase (new MultithreadedPointToPointTestCase (MultithreadedPointToPointTestCase::STOP_LATER_FROM_NODE));
+  }
+} g_multithreadedSimulatorTestSuite;
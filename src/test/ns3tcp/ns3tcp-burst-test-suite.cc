@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <deque>
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/csma-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/packet-sink.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/simulator.h"
+#include "ns3tcp-socket-writer.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("Ns3TcpBurstTest");
+
+// ===========================================================================
+// Tests of the bursts of back-to-back TCP segments given to the devices
+// ===========================================================================
+//
+//
+class Ns3TcpBurstTestCase : public TestCase
+{
+public:
+  Ns3TcpBurstTestCase (bool csma);
+  virtual ~Ns3TcpBurstTestCase () {}
+
+private:
+  virtual void DoRun (void);
+  void Ipv4Tx (Ptr<const Packet> p, Ptr<Ipv4> ipv4, uint32_t interface);
+  void MacTx (Ptr<const Packet> p);
+
+  bool m_csma;
+  // the packets traced by ipv4 which the device did not see yet.
+  std::deque<const Packet *> m_pending;
+  uint32_t m_ipv4Tx;
+  uint32_t m_macTx;
+  uint32_t m_reordered;
+  uint32_t m_maxPending;
+};
+
+Ns3TcpBurstTestCase::Ns3TcpBurstTestCase (bool csma)
+  : TestCase (csma ? "Check that the bursts of TCP segments reach the device in order (CSMA)" :
+              "Check that the bursts of TCP segments reach the device in order (point-to-point)"),
+    m_csma (csma)
+{
+}
+
+void
+Ns3TcpBurstTestCase::Ipv4Tx (Ptr<const Packet> p, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+  m_ipv4Tx++;
+  m_pending.push_back (PeekPointer (p));
+}
+
+void
+Ns3TcpBurstTestCase::MacTx (Ptr<const Packet> p)
+{
+  std::deque<const Packet *>::iterator i = std::find (m_pending.begin (), m_pending.end (), PeekPointer (p));
+  if (i == m_pending.end ())
+    {
+      // an arp packet
+      return;
+    }
+  if (i != m_pending.begin ())
+    {
+      m_reordered++;
+    }
+  m_pending.erase (i);
+  m_macTx++;
+  m_maxPending = std::max (m_maxPending, (uint32_t)m_pending.size ());
+}
+
+void
+Ns3TcpBurstTestCase::DoRun (void)
+{
+  uint16_t sinkPort = 50000;
+  uint32_t bytes = 50000;
+  m_pending.clear ();
+  m_ipv4Tx = 0;
+  m_macTx = 0;
+  m_reordered = 0;
+  m_maxPending = 0;
+
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  NetDeviceContainer devices;
+  if (m_csma)
+    {
+      CsmaHelper csma;
+      csma.SetChannelAttribute ("DataRate", StringValue ("10Mbps"));
+      csma.SetChannelAttribute ("Delay", StringValue ("2ms"));
+      devices = csma.Install (nodes);
+    }
+  else
+    {
+      PointToPointHelper pointToPoint;
+      pointToPoint.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+      pointToPoint.SetChannelAttribute ("Delay", StringValue ("2ms"));
+      devices = pointToPoint.Install (nodes);
+    }
+
+  InternetStackHelper internet;
+  internet.Install (nodes);
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.252");
+  Ipv4InterfaceContainer ifContainer = address.Assign (devices);
+
+  Ptr<SocketWriter> socketWriter = CreateObject<SocketWriter> ();
+  Address sinkAddress (InetSocketAddress (ifContainer.GetAddress (1), sinkPort));
+  socketWriter->Setup (nodes.Get (0), sinkAddress);
+  nodes.Get (0)->AddApplication (socketWriter);
+  socketWriter->SetStartTime (Seconds (0.));
+  socketWriter->SetStopTime (Seconds (20.));
+
+  PacketSinkHelper sink ("ns3::TcpSocketFactory",
+                         InetSocketAddress (Ipv4Address::GetAny (), sinkPort));
+  ApplicationContainer apps = sink.Install (nodes.Get (1));
+  apps.Start (Seconds (0.0));
+  apps.Stop (Seconds (30.));
+
+  nodes.Get (0)->GetObject<Ipv4L3Protocol> ()->TraceConnectWithoutContext ("Tx",
+    MakeCallback (&Ns3TcpBurstTestCase::Ipv4Tx, this));
+  devices.Get (0)->TraceConnectWithoutContext ("MacTx", MakeCallback (&Ns3TcpBurstTestCase::MacTx, this));
+
+  Simulator::Schedule (Seconds (1), &SocketWriter::Connect, socketWriter);
+  Simulator::Schedule (Seconds (2), &SocketWriter::Write, socketWriter, bytes);
+  Simulator::Schedule (Seconds (20), &SocketWriter::Close, socketWriter);
+
+  Simulator::Stop (Seconds (40));
+  Simulator::Run ();
+
+  uint32_t received = DynamicCast<PacketSink> (apps.Get (0))->GetTotalRx ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (received, bytes, "Incorrect number of bytes received");
+  NS_TEST_ASSERT_MSG_EQ (m_pending.size (), 0, "Some packets sent by ipv4 did not reach the device");
+  NS_TEST_ASSERT_MSG_EQ (m_macTx, m_ipv4Tx, "Some packets sent by ipv4 did not reach the device");
+  NS_TEST_ASSERT_MSG_EQ (m_reordered, 0, "The device saw the packets in another order than ipv4");
+  NS_TEST_ASSERT_MSG_GT (m_maxPending, 0, "No segments were sent as a burst");
+}
+
+class Ns3TcpBurstTestSuite : public TestSuite
+{
+public:
+  Ns3TcpBurstTestSuite ();
+};
+
+Ns3TcpBurstTestSuite::Ns3TcpBurstTestSuite ()
+  : TestSuite ("ns3-tcp-burst", SYSTEM)
+{
+  AddTestCase (new Ns3TcpBurstTestCase (false));
+  AddTestCase (new Ns3TcpBurstTestCase (true));
+}
+
+static Ns3TcpBurstTestSuite ns3TcpBurstTestSuite;
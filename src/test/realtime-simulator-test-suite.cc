@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/realtime-simulator-impl.h"
+#include "ns3/system-thread.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+#include "ns3/make-event.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Injects events from several threads, the way EmuNetDevice and
+ * TapBridge do, while the simulation thread runs its own events, and
+ * checks that every injected event runs exactly once, in order and
+ * with the right context.
+ */
+class RealtimeInjectionTestCase : public TestCase
+{
+public:
+  RealtimeInjectionTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void StartThreads (void);
+  void Inject (void);
+  void Injected (uint32_t thread, uint32_t seq);
+  void Local (uint32_t count);
+
+  Ptr<RealtimeSimulatorImpl> m_impl;
+  std::vector<Ptr<SystemThread> > m_threads;
+  uint32_t m_threadIds;
+  std::vector<uint32_t> m_next;
+  uint32_t m_outOfOrder;
+  uint32_t m_badContext;
+  uint32_t m_local;
+  uint64_t m_lastTs;
+  bool m_timeWentBackward;
+};
+
+static const uint32_t N_THREADS = 3;
+static const uint32_t N_INJECTED = 2000;
+
+RealtimeInjectionTestCase::RealtimeInjectionTestCase ()
+  : TestCase ("Check that the events injected by other threads are run by the realtime simulator")
+{
+}
+
+void
+RealtimeInjectionTestCase::Inject (void)
+{
+  uint32_t thread = __sync_fetch_and_add (&m_threadIds, 1);
+  for (uint32_t i = 0; i < N_INJECTED; i++)
+    {
+      m_impl->ScheduleRealtimeNowWithContext (thread, MakeEvent (&RealtimeInjectionTestCase::Injected,
+                                                                 this, thread, i));
+      if (i % 100 == 0)
+        {
+          usleep (1000);
+        }
+    }
+}
+
+void
+RealtimeInjectionTestCase::Injected (uint32_t thread, uint32_t seq)
+{
+  if (m_next[thread] != seq)
+    {
+      m_outOfOrder++;
+    }
+  m_next[thread] = seq + 1;
+  if (Simulator::GetContext () != thread)
+    {
+      m_badContext++;
+    }
+  uint64_t ts = Simulator::Now ().GetTimeStep ();
+  if (ts < m_lastTs)
+    {
+      m_timeWentBackward = true;
+    }
+  m_lastTs = ts;
+}
+
+void
+RealtimeInjectionTestCase::Local (uint32_t count)
+{
+  m_local++;
+  uint64_t ts = Simulator::Now ().GetTimeStep ();
+  if (ts < m_lastTs)
+    {
+      m_timeWentBackward = true;
+    }
+  m_lastTs = ts;
+  if (count > 0)
+    {
+      Simulator::Schedule (MicroSeconds (100), &RealtimeInjectionTestCase::Local, this, count - 1);
+    }
+}
+
+void
+RealtimeInjectionTestCase::StartThreads (void)
+{
+  for (uint32_t i = 0; i < N_THREADS; i++)
+    {
+      Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&RealtimeInjectionTestCase::Inject, this));
+      m_threads.push_back (thread);
+      thread->Start ();
+    }
+}
+
+void
+RealtimeInjectionTestCase::DoRun (void)
+{
+  Simulator::Destroy ();
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::RealtimeSimulatorImpl"));
+  m_impl = DynamicCast<RealtimeSimulatorImpl> (Simulator::GetImplementation ());
+  m_threadIds = 0;
+  m_next.assign (N_THREADS, 0);
+  m_outOfOrder = 0;
+  m_badContext = 0;
+  m_local = 0;
+  m_lastTs = 0;
+  m_timeWentBackward = false;
+
+  Simulator::Schedule (Seconds (0), &RealtimeInjectionTestCase::StartThreads, this);
+  Simulator::Schedule (Seconds (0), &RealtimeInjectionTestCase::Local, this, 1000);
+  Simulator::Stop (Seconds (0.3));
+  Simulator::Run ();
+  for (uint32_t i = 0; i < m_threads.size (); i++)
+    {
+      m_threads[i]->Join ();
+    }
+  m_threads.clear ();
+  // the events injected after the simulation stopped are still pending.
+  Simulator::Run ();
+  m_impl = 0;
+  Simulator::Destroy ();
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+
+  for (uint32_t i = 0; i < N_THREADS; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_next[i], N_INJECTED, "Lost events from thread " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_outOfOrder, 0, "Events of a thread were run out of order");
+  NS_TEST_EXPECT_MSG_EQ (m_badContext, 0, "Events were run with the wrong context");
+  NS_TEST_EXPECT_MSG_EQ (m_local, 1001, "Lost simulation thread events");
+  NS_TEST_EXPECT_MSG_EQ (m_timeWentBackward, false, "The simulation time went backward");
+}
+
+class RealtimeSimulatorTestSuite : public TestSuite
+{
+public:
+  RealtimeSimulatorTestSuite ()
+    : TestSuite ("realtime-simulator", SYSTEM)
+  {
+    AddTestCase (new RealtimeInjectionTestCase ());
+  }
+} g_realtimeSimulatorTestSuite;
@@ -181,17 +181,19 @@ UanChannel::TxPacket (Ptr<UanTransducer> src, Ptr<Packet> packet,
 
           uint32_t dstNodeId = i->first->GetNode ()->GetId ();
           Ptr<Packet> copy = packet->Copy ();
-          Simulator::ScheduleWithContext (dstNodeId, delay,
-                                          &UanChannel::SendUp,
-                                          this,
-                                          j,
-                                          copy,
-                                          rxPowerDb,
-                                          txMode,
-                                          pdp);
+          m_receptions.push_back (BatchEvent (dstNodeId, delay,
+                                              MakeEvent (&UanChannel::SendUp,
+                                                         this,
+                                                         j,
+                                                         copy,
+                                                         rxPowerDb,
+                                                         txMode,
+                                                         pdp)));
         }
       j++;
     }
+  Simulator::ScheduleWithContextBatch (m_receptions);
+  m_receptions.clear ();
 }
 
 void
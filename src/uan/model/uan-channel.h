@@ -24,6 +24,7 @@
 #include "ns3/net-device.h"
 #include "ns3/channel.h"
 #include "ns3/packet.h"
+#include "ns3/batch-event.h"
 #include "ns3/uan-prop-model.h"
 #include "ns3/uan-noise-model.h"
 
@@ -104,6 +105,10 @@ private:
   Ptr<UanPropModel> m_prop;
   Ptr<UanNoiseModel> m_noise;
   bool m_cleared;
+  // the SendUp events of the packet given to TxPacket, which empties
+  // this vector once it scheduled them. TxPacket must not be reentered
+  // from the propagation model in the meantime.
+  std::vector<BatchEvent> m_receptions;
 
   void SendUp (uint32_t i, Ptr<Packet> packet, double rxPowerDb, UanTxMode txMode, UanPdp pdp);
 protected:
@@ -38,7 +38,7 @@
 NS_LOG_COMPONENT_DEFINE ("MacLow");
 
 #undef NS_LOG_APPEND_CONTEXT
-#define NS_LOG_APPEND_CONTEXT std::clog << "[mac=" << m_self << "] "
+#define NS_LOG_APPEND_CONTEXT ns3::LogStream () << "[mac=" << m_self << "] "
 
 
 namespace ns3 {
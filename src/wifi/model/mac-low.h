@@ -26,6 +26,7 @@
 #include <stdint.h>
 #include <ostream>
 #include <map>
+#include <list>
 
 #include "wifi-mac-header.h"
 #include "wifi-mode.h"
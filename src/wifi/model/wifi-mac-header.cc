@@ -22,6 +22,7 @@
 #include "ns3/assert.h"
 #include "ns3/address-utils.h"
 #include "wifi-mac-header.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -1034,8 +1035,9 @@ WifiMacHeader::GetSerializedSize (void) const
   return GetSize ();
 }
 void 
-WifiMacHeader::Serialize (Buffer::Iterator i) const
+WifiMacHeader::Serialize (Buffer::Iterator start) const
 {
+  Buffer::WriteSpan i (start, GetSize ());
   i.WriteHtolsbU16 (GetFrameControl ());
   i.WriteHtolsbU16 (m_duration);
   WriteTo (i, m_addr1);
@@ -1086,41 +1088,45 @@ WifiMacHeader::Deserialize (Buffer::Iterator start)
   Buffer::Iterator i = start;
   uint16_t frame_control = i.ReadLsbtohU16 ();
   SetFrameControl (frame_control);
-  m_duration = i.ReadLsbtohU16 ();
-  ReadFrom (i, m_addr1);
+  // the frame control, duration and first address of the frames of
+  // an unknown type are read nonetheless.
+  uint32_t size = std::max (GetSize (), 2+2+6U);
+  Buffer::ReadSpan span (i, size - 2);
+  m_duration = span.ReadLsbtohU16 ();
+  ReadFrom (span, m_addr1);
   switch (m_ctrlType) {
   case TYPE_MGT:
-    ReadFrom (i, m_addr2);
-    ReadFrom (i, m_addr3);
-    SetSequenceControl (i.ReadLsbtohU16 ());
+    ReadFrom (span, m_addr2);
+    ReadFrom (span, m_addr3);
+    SetSequenceControl (span.ReadLsbtohU16 ());
     break;
   case TYPE_CTL:
     switch (m_ctrlSubtype) {
     case SUBTYPE_CTL_RTS:
-      ReadFrom (i, m_addr2);
+      ReadFrom (span, m_addr2);
       break;
     case SUBTYPE_CTL_CTS:
     case SUBTYPE_CTL_ACK:
       break;
     case SUBTYPE_CTL_BACKREQ:
     case SUBTYPE_CTL_BACKRESP:
-      ReadFrom (i, m_addr2);
+      ReadFrom (span, m_addr2);
       break;
     }
     break;
   case TYPE_DATA:
-    ReadFrom (i, m_addr2);
-    ReadFrom (i, m_addr3);
-    SetSequenceControl (i.ReadLsbtohU16 ());
+    ReadFrom (span, m_addr2);
+    ReadFrom (span, m_addr3);
+    SetSequenceControl (span.ReadLsbtohU16 ());
     if (m_ctrlToDs && m_ctrlFromDs) {
-      ReadFrom (i, m_addr4);
+      ReadFrom (span, m_addr4);
     }
     if (m_ctrlSubtype & 0x08) {
-      SetQosControl (i.ReadLsbtohU16 ());
+      SetQosControl (span.ReadLsbtohU16 ());
     }
     break;
   }
-  return i.GetDistanceFrom (start);
+  return size;
 }
 
 } // namespace ns3
@@ -79,6 +79,10 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double
 {
   Ptr<MobilityModel> senderMobility = sender->GetMobility ()->GetObject<MobilityModel> ();
   NS_ASSERT (senderMobility != 0);
+  // a local vector, so that this const method does not change the
+  // channel and can be reentered.
+  std::vector<BatchEvent> receptions;
+  receptions.reserve (m_phyList.size ());
   uint32_t j = 0;
   for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++, j++)
     { 
@@ -104,11 +108,12 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double
             {
               dstNode = dstNetDevice->GetObject<NetDevice> ()->GetNode ()->GetId ();
             }
-          Simulator::ScheduleWithContext (dstNode,
-                                          delay, &YansWifiChannel::Receive, this, 
-                                          j, copy, rxPowerDbm, wifiMode, preamble);
+          receptions.push_back (BatchEvent (dstNode, delay,
+                                            MakeEvent (&YansWifiChannel::Receive, this,
+                                                       j, copy, rxPowerDbm, wifiMode, preamble)));
         }
     }
+  Simulator::ScheduleWithContextBatch (receptions);
 }
 
 void
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/config.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/packet.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <string.h>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+// The startup cost of the trace sinks a simulation connects to all of
+// its nodes, through the Config paths.
+
+static void
+Sink (std::string context, Ptr<const Packet> p)
+{}
+
+static std::string
+DevicePath (uint32_t node, std::string source)
+{
+  std::ostringstream oss;
+  oss << "/NodeList/" << node << "/DeviceList/0/" << source;
+  return oss.str ();
+}
+
+static void
+benchConnectWildcard (uint32_t n)
+{
+  Config::Connect ("/NodeList/*/DeviceList/*/PhyRxDrop", MakeCallback (&Sink));
+}
+
+static void
+benchConnectPerNode (uint32_t n)
+{
+  // as helpers which connect a different sink to each node
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Config::Connect (DevicePath (i, "PhyRxDrop"), MakeCallback (&Sink));
+    }
+}
+
+static void
+benchConnectManyPerNode (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      std::vector<std::string> paths;
+      std::vector<CallbackBase> cbs;
+      paths.push_back (DevicePath (i, "PhyRxDrop"));
+      cbs.push_back (MakeCallback (&Sink));
+      paths.push_back (DevicePath (i, "PhyRxDrop"));
+      cbs.push_back (MakeCallback (&Sink));
+      Config::ConnectMany (paths, cbs);
+    }
+}
+
+static void
+benchPathReuse (uint32_t n)
+{
+  Config::Path path = Config::Path ("/NodeList/*/DeviceList/*/PhyRxDrop");
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      path.Connect (MakeCallback (&Sink));
+    }
+}
+
+static void
+runBench (void (*bench) (uint32_t), uint32_t n, char const *name)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      node->AddDevice (CreateObject<SimpleNetDevice> ());
+    }
+  SystemWallClockMs time;
+  time.Start ();
+  (*bench) (n);
+  uint64_t deltaMs = time.End ();
+  std::cout << name << " " << n << " " << deltaMs << std::endl;
+  Simulator::Destroy ();
+}
+
+int main (int argc, char *argv[])
+{
+  std::vector<uint32_t> sizes;
+  while (argc > 0) {
+      if (strncmp ("--nodes=", argv[0],strlen ("--nodes=")) == 0)
+        {
+          uint32_t n = 0;
+          std::istringstream iss;
+          iss.str (argv[0] + strlen ("--nodes="));
+          iss >> n;
+          sizes.push_back (n);
+        }
+      argc--;
+      argv++;
+  }
+  if (sizes.empty ())
+    {
+      sizes.push_back (10000);
+      sizes.push_back (50000);
+    }
+  std::cout << "# bench-config" << std::endl;
+  std::cout << "# name nodes ms" << std::endl;
+  for (uint32_t i = 0; i < sizes.size (); i++)
+    {
+      runBench (&benchConnectWildcard, sizes[i], "connect-wildcard");
+      runBench (&benchConnectPerNode, sizes[i], "connect-per-node");
+      runBench (&benchConnectManyPerNode, sizes[i], "connect-many-per-node");
+      runBench (&benchPathReuse, sizes[i], "path-reuse");
+    }
+
+  return 0;
+}
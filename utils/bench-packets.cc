@@ -17,16 +17,58 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
-#include "ns3/system-wall-clock-ms.h"
 #include "ns3/packet.h"
 #include "ns3/packet-metadata.h"
+#include "ns3/ethernet-header.h"
+#include "ns3/llc-snap-header.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/tcp-header.h"
+#include "ns3/udp-header.h"
+#include "ns3/wifi-mac-header.h"
 #include <iostream>
+#include <iomanip>
+#include <fstream>
 #include <sstream>
 #include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <new>
 #include <stdlib.h> // for exit ()
+#include <sys/time.h>
 
 using namespace ns3;
 
+// Count the heap allocations of the benchmarks
+static uint64_t g_nAllocations = 0;
+
+void *
+operator new (size_t size) throw (std::bad_alloc)
+{
+  g_nAllocations++;
+  void *p = malloc (size == 0 ? 1 : size);
+  if (p == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  return p;
+}
+void *
+operator new[] (size_t size) throw (std::bad_alloc)
+{
+  return operator new (size);
+}
+void
+operator delete (void *p) throw ()
+{
+  free (p);
+}
+void
+operator delete[] (void *p) throw ()
+{
+  free (p);
+}
+
 template <int N>
 class BenchHeader : public Header
 {
@@ -241,23 +283,408 @@ benchC (uint32_t n)
   }
 }
 
+static void
+benchE (uint32_t n)
+{
+  BenchHeader<20> ipv4;
+  BenchHeader<20> tcp;
+  uint8_t data[1024];
+  for (uint32_t i = 0; i < sizeof (data); i++)
+    {
+      data[i] = i;
+    }
+
+  for (uint32_t i = 0; i < n; i++) {
+    // a 64 KB TCP segment made of 1 KB application writes
+    Ptr<Packet> segment = Create<Packet> ();
+    for (uint32_t j = 0; j < 64; j++)
+      {
+        segment->AddAtEnd (Create<Packet> (data, sizeof (data)));
+      }
+    segment->AddHeader (tcp);
+    segment->AddHeader (ipv4);
+    // fragmented and reassembled by IP
+    Ptr<Packet> reassembled = Create<Packet> ();
+    for (uint32_t offset = 0; offset < segment->GetSize (); offset += 1480)
+      {
+        uint32_t length = std::min (segment->GetSize () - offset, 1480U);
+        reassembled->AddAtEnd (segment->CreateFragment (offset, length));
+      }
+    reassembled->RemoveHeader (ipv4);
+    reassembled->RemoveHeader (tcp);
+  }
+}
 
 static void
-runBench (void (*bench) (uint32_t), uint32_t n, char const *name)
+benchF (uint32_t n)
 {
-  SystemWallClockMs time;
-  time.Start ();
-  (*bench) (n);
-  uint64_t deltaMs = time.End ();
-  double ps = n;
-  ps *= 1000;
-  ps /= deltaMs;
-  std::cout << name<<"=" << ps << " packets/s" << std::endl;
+  BenchHeader<24> mac;
+
+  for (uint32_t i = 0; i < n; i++) {
+    // a broadcast channel with 20 receivers
+    Ptr<Packet> p = Create<Packet> (1000);
+    p->AddHeader (mac);
+    for (uint32_t j = 0; j < 20; j++)
+      {
+        Ptr<Packet> copy = p->Copy ();
+        copy->RemoveHeader (mac);
+      }
+  }
+}
+
+static void
+benchG (uint32_t n)
+{
+  BenchTag<1> qos;
+  BenchTag<4> flowId;
+  BenchTag<8> hwmp;
+  BenchTag<12> info;
+  BenchTag<20> address;
+
+  for (uint32_t i = 0; i < n; i++) {
+    // a packet which carries its packet tags across four hops, each of
+    // which looks at some of them and adds one for its own use.
+    Ptr<Packet> p = Create<Packet> (1000);
+    p->AddPacketTag (address);
+    p->AddPacketTag (info);
+    p->AddPacketTag (flowId);
+    p->AddPacketTag (qos);
+    for (uint32_t j = 0; j < 4; j++)
+      {
+        Ptr<Packet> copy = p->Copy ();
+        copy->PeekPacketTag (qos);
+        copy->PeekPacketTag (flowId);
+        copy->AddPacketTag (hwmp);
+        copy->PeekPacketTag (address);
+        copy->RemovePacketTag (hwmp);
+        p = copy;
+      }
+    p->RemovePacketTag (info);
+  }
+}
+
+static void
+benchH (uint32_t n)
+{
+  uint8_t data[1460];
+  for (uint32_t i = 0; i < sizeof (data); i++)
+    {
+      data[i] = i;
+    }
+  Buffer buffer;
+  buffer.AddAtStart (sizeof (data));
+  buffer.Begin ().Write (data, sizeof (data));
+  buffer.AddAtStart (20);
+  buffer.Begin ().WriteU8 (0, 20);
+  uint32_t sum = 0;
+
+  for (uint32_t i = 0; i < n; i++) {
+    // the TCP checksum of a full sized segment
+    Buffer::Iterator start = buffer.Begin ();
+    sum += start.CalculateIpChecksum (buffer.GetSize (), i);
+  }
+  if (sum == 0)
+    {
+      std::cout << std::flush;
+    }
+}
+
+static void
+benchI (uint32_t n)
+{
+  BenchHeader<24> mac;
+  BenchTag<4> flowId;
+  BenchTag<8> timestamp;
+
+  for (uint32_t i = 0; i < n; i++) {
+    // a broadcast channel with 20 receivers which forward the packets,
+    // which carry byte tags.
+    Ptr<Packet> p = Create<Packet> (1000);
+    p->AddByteTag (flowId);
+    p->AddByteTag (timestamp);
+    p->AddHeader (mac);
+    for (uint32_t j = 0; j < 20; j++)
+      {
+        Ptr<Packet> copy = p->Copy ();
+        copy->RemoveHeader (mac);
+        copy->AddHeader (mac);
+      }
+  }
+}
+
+static void
+benchCopy (uint32_t n)
+{
+  BenchHeader<25> ipv4;
+  Ptr<Packet> p = Create<Packet> (1000);
+  p->AddHeader (ipv4);
+
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> copy = p->Copy ();
+  }
+}
+
+static void
+benchCreateFragment (uint32_t n)
+{
+  BenchHeader<25> ipv4;
+  Ptr<Packet> p = Create<Packet> (10000);
+  p->AddHeader (ipv4);
+
+  for (uint32_t i = 0; i < n; i++) {
+    uint32_t offset = (i * 1000) % 9000;
+    Ptr<Packet> fragment = p->CreateFragment (offset, 1000);
+  }
+}
+
+static void
+benchAddAtEnd (uint32_t n)
+{
+  BenchHeader<8> udp;
+  Ptr<Packet> chunk = Create<Packet> (100);
+  chunk->AddHeader (udp);
+
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> ();
+    for (uint32_t j = 0; j < 10; j++)
+      {
+        p->AddAtEnd (chunk);
+      }
+  }
+}
+
+static void
+benchPacketTags (uint32_t n)
+{
+  BenchTag<4> flowId;
+  BenchTag<8> timestamp;
+  Ptr<Packet> p = Create<Packet> (1000);
+
+  for (uint32_t i = 0; i < n; i++) {
+    p->AddPacketTag (flowId);
+    p->AddPacketTag (timestamp);
+    p->PeekPacketTag (flowId);
+    p->RemovePacketTag (timestamp);
+    p->RemovePacketTag (flowId);
+  }
+}
+
+static void
+benchByteTags (uint32_t n)
+{
+  BenchTag<4> flowId;
+  BenchTag<8> timestamp;
+
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> (1000);
+    p->AddByteTag (flowId);
+    p->AddByteTag (timestamp);
+    p->FindFirstMatchingByteTag (timestamp);
+    p->FindFirstMatchingByteTag (flowId);
+  }
+}
+
+static void
+benchEthernetIpv4Tcp (uint32_t n)
+{
+  Mac48Address from = Mac48Address ("00:00:00:00:00:01");
+  Mac48Address to = Mac48Address ("00:00:00:00:00:02");
+
+  for (uint32_t i = 0; i < n; i++) {
+    // a TCP segment sent and received over an ethernet link
+    Ptr<Packet> p = Create<Packet> (1460);
+    TcpHeader tcp;
+    tcp.SetSourcePort (49153);
+    tcp.SetDestinationPort (80);
+    tcp.SetSequenceNumber (SequenceNumber32 (i));
+    tcp.SetFlags (TcpHeader::ACK);
+    p->AddHeader (tcp);
+    Ipv4Header ipv4;
+    ipv4.SetSource (Ipv4Address ("10.1.1.1"));
+    ipv4.SetDestination (Ipv4Address ("10.1.1.2"));
+    ipv4.SetProtocol (6);
+    ipv4.SetPayloadSize (p->GetSize ());
+    ipv4.SetTtl (64);
+    p->AddHeader (ipv4);
+    EthernetHeader ethernet (false);
+    ethernet.SetSource (from);
+    ethernet.SetDestination (to);
+    ethernet.SetLengthType (0x0800);
+    p->AddHeader (ethernet);
+
+    Ptr<Packet> received = p->Copy ();
+    received->RemoveHeader (ethernet);
+    received->RemoveHeader (ipv4);
+    received->RemoveHeader (tcp);
+  }
+}
+
+static void
+benchWifiLlcIpv4Udp (uint32_t n)
+{
+  Mac48Address from = Mac48Address ("00:00:00:00:00:01");
+  Mac48Address to = Mac48Address ("00:00:00:00:00:02");
+
+  for (uint32_t i = 0; i < n; i++) {
+    // a UDP datagram sent and received over a wifi link
+    Ptr<Packet> p = Create<Packet> (1000);
+    UdpHeader udp;
+    udp.SetSourcePort (49153);
+    udp.SetDestinationPort (9);
+    p->AddHeader (udp);
+    Ipv4Header ipv4;
+    ipv4.SetSource (Ipv4Address ("10.1.1.1"));
+    ipv4.SetDestination (Ipv4Address ("10.1.1.2"));
+    ipv4.SetProtocol (17);
+    ipv4.SetPayloadSize (p->GetSize ());
+    ipv4.SetTtl (64);
+    p->AddHeader (ipv4);
+    LlcSnapHeader llc;
+    llc.SetType (0x0800);
+    p->AddHeader (llc);
+    WifiMacHeader mac;
+    mac.SetTypeData ();
+    mac.SetDsNotFrom ();
+    mac.SetDsNotTo ();
+    mac.SetAddr1 (to);
+    mac.SetAddr2 (from);
+    mac.SetAddr3 (from);
+    mac.SetSequenceNumber (i);
+    p->AddHeader (mac);
+
+    Ptr<Packet> received = p->Copy ();
+    received->RemoveHeader (mac);
+    received->RemoveHeader (llc);
+    received->RemoveHeader (ipv4);
+    received->RemoveHeader (udp);
+  }
+}
+
+struct Bench
+{
+  // a stable name, used to compare the results of two builds
+  char const *name;
+  void (*function) (uint32_t);
+  // the number of iterations is n divided by this
+  uint32_t divisor;
+};
+
+static const struct Bench g_benchs[] = {
+  {"header-add-copy-remove", &benchA, 1},
+  {"header-add", &benchB, 1},
+  {"header-add-remove", &benchC, 1},
+  {"header-packet-tags", &benchD, 1},
+  {"tcp-segment-fragments", &benchE, 100},
+  {"broadcast-copy", &benchF, 10},
+  {"packet-tags-hops", &benchG, 1},
+  {"tcp-checksum", &benchH, 1},
+  {"byte-tags-broadcast", &benchI, 10},
+  {"copy", &benchCopy, 1},
+  {"create-fragment", &benchCreateFragment, 1},
+  {"add-at-end", &benchAddAtEnd, 1},
+  {"packet-tags", &benchPacketTags, 1},
+  {"byte-tags", &benchByteTags, 1},
+  {"stack-ethernet-ipv4-tcp", &benchEthernetIpv4Tcp, 1},
+  {"stack-wifi-llc-ipv4-udp", &benchWifiLlcIpv4Udp, 1},
+};
+
+struct Result
+{
+  double nsPerOp;
+  double allocationsPerOp;
+};
+
+static uint64_t
+nowUs (void)
+{
+  struct timeval tv;
+  gettimeofday (&tv, 0);
+  return tv.tv_sec * 1000000ULL + tv.tv_usec;
+}
+
+static Result
+runBench (struct Bench const &bench, uint32_t n, uint32_t runs)
+{
+  uint32_t iterations = std::max (n / bench.divisor, 1U);
+  Result best;
+  for (uint32_t run = 0; run < runs; run++)
+    {
+      uint64_t nAllocations = g_nAllocations;
+      uint64_t start = nowUs ();
+      (*bench.function) (iterations);
+      uint64_t deltaUs = nowUs () - start;
+      nAllocations = g_nAllocations - nAllocations;
+      Result result;
+      result.nsPerOp = deltaUs * 1000.0 / iterations;
+      result.allocationsPerOp = nAllocations / (double)iterations;
+      // keep the fastest run, the least disturbed by the rest of the system
+      if (run == 0 || result.nsPerOp < best.nsPerOp)
+        {
+          best = result;
+        }
+    }
+  return best;
+}
+
+// read the results printed by an earlier run, perhaps of another build
+static std::map<std::string, Result>
+readBaseline (std::string filename)
+{
+  std::map<std::string, Result> baseline;
+  std::ifstream is (filename.c_str ());
+  if (!is.is_open ())
+    {
+      std::cerr << "Error-- cannot read baseline " << filename << std::endl;
+      exit (1);
+    }
+  std::string line;
+  while (std::getline (is, line))
+    {
+      if (line.empty () || line[0] == '#')
+        {
+          continue;
+        }
+      std::istringstream iss (line);
+      std::string name;
+      Result result;
+      if (iss >> name >> result.nsPerOp >> result.allocationsPerOp)
+        {
+          baseline[name] = result;
+        }
+    }
+  return baseline;
+}
+
+static void
+runBenchs (uint32_t n, uint32_t runs, std::string filter, char const *suffix,
+           std::map<std::string, Result> const &baseline)
+{
+  for (uint32_t i = 0; i < sizeof (g_benchs) / sizeof (g_benchs[0]); i++)
+    {
+      std::string name = std::string (g_benchs[i].name) + suffix;
+      if (name.find (filter) == std::string::npos)
+        {
+          continue;
+        }
+      Result result = runBench (g_benchs[i], n, runs);
+      std::cout << name << " " << result.nsPerOp << " " << result.allocationsPerOp;
+      std::map<std::string, Result>::const_iterator base = baseline.find (name);
+      if (base != baseline.end ())
+        {
+          std::cout << " " << base->second.nsPerOp << " " << base->second.allocationsPerOp
+                    << " " << (result.nsPerOp / base->second.nsPerOp - 1) * 100 << "%";
+        }
+      std::cout << std::endl;
+    }
 }
 
 int main (int argc, char *argv[])
 {
   uint32_t n = 0;
+  uint32_t runs = 3;
+  std::string filter;
+  std::map<std::string, Result> baseline;
+  bool metadata = false;
   while (argc > 0) {
       if (strncmp ("--n=", argv[0],strlen ("--n=")) == 0) 
         {
@@ -266,25 +693,53 @@ int main (int argc, char *argv[])
           iss.str (nAscii);
           iss >> n;
         }
-      if (strncmp ("--enable-printing", argv[0], strlen ("--enable-printing")) == 0)
+      if (strncmp ("--runs=", argv[0],strlen ("--runs=")) == 0) 
+        {
+          std::istringstream iss;
+          iss.str (argv[0] + strlen ("--runs="));
+          iss >> runs;
+        }
+      if (strncmp ("--filter=", argv[0],strlen ("--filter=")) == 0) 
+        {
+          filter = argv[0] + strlen ("--filter=");
+        }
+      if (strncmp ("--baseline=", argv[0],strlen ("--baseline=")) == 0) 
+        {
+          baseline = readBaseline (argv[0] + strlen ("--baseline="));
+        }
+      if (strcmp ("--enable-printing", argv[0]) == 0)
         {
           Packet::EnablePrinting ();
+          metadata = true;
+        }
+      if (strcmp ("--enable-printing-on-demand", argv[0]) == 0)
+        {
+          // as if a trace point recorded the packets it sees
+          Packet::EnablePrintingOnDemand (MakeNullCallback<bool,uint64_t> ());
+          Packet::EnablePrinting ();
+          metadata = true;
         }
       argc--;
       argv++;
   }
-  if (n == 0)
+  if (n == 0 || runs == 0)
     {
       std::cerr << "Error-- number of packets must be specified " <<
         "by command-line argument --n=(number of packets)" << std::endl;
       exit (1);
     }
-  std::cout << "Running bench-packets with n=" << n << std::endl;
+  std::cout << std::fixed << std::setprecision (2);
+  std::cout << "# bench-packets n=" << n << " runs=" << runs << std::endl;
+  std::cout << "# name ns/op allocations/op";
+  if (!baseline.empty ())
+    {
+      std::cout << " baseline-ns/op baseline-allocations/op delta";
+    }
+  std::cout << std::endl;
 
-  runBench (&benchA, n, "a");
-  runBench (&benchB, n, "b");
-  runBench (&benchC, n, "c");
-  runBench (&benchD, n, "d");
+  // metadata must be enabled before the first packet is created: run
+  // again with --enable-printing to measure the packets with metadata.
+  runBenchs (n, runs, filter, metadata ? "+metadata" : "", baseline);
 
   return 0;
 }
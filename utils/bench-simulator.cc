@@ -80,6 +80,8 @@ Bench::RunBench (void)
 {
   SystemWallClockMs time;
   double init, simu;
+  uint64_t allocations = EventMemoryPool::GetAllocations ();
+  uint64_t systemAllocations = EventMemoryPool::GetSystemAllocations ();
   time.Start ();
   for (std::vector<uint64_t>::const_iterator i = m_distribution.begin ();
        i != m_distribution.end (); i++) 
@@ -95,6 +97,8 @@ Bench::RunBench (void)
   Simulator::Run ();
   simu = time.End ();
   simu /= 1000;
+  allocations = EventMemoryPool::GetAllocations () - allocations;
+  systemAllocations = EventMemoryPool::GetSystemAllocations () - systemAllocations;
 
   std::cout <<
       "init n=" << m_distribution.size () << ", time=" << init << "s" << std::endl <<
@@ -102,7 +106,9 @@ Bench::RunBench (void)
       "init " << ((double)m_distribution.size ()) / init << " insert/s, avg insert=" <<
       init / ((double)m_distribution.size ())<< "s" << std::endl <<
       "simu " << ((double)m_n) / simu<< " hold/s, avg hold=" << 
-      simu / ((double)m_n) << "s" << std::endl
+      simu / ((double)m_n) << "s" << std::endl <<
+      "mem events=" << allocations << ", mallocs=" << systemAllocations << 
+      ", avg mallocs/event=" << ((double)systemAllocations) / ((double)allocations) << std::endl
       ;
 }
 
@@ -135,6 +141,10 @@ PrintHelp (void)
   std::cout << "      --list: use std::list scheduler"<<std::endl;
   std::cout << "      --map: use std::map cheduler"<<std::endl;
   std::cout << "      --heap: use Binary Heap scheduler"<<std::endl;
+  std::cout << "      --calendar: use Calendar Queue scheduler"<<std::endl;
+  std::cout << "      --ladder: use Ladder Queue scheduler"<<std::endl;
+  std::cout << "      --dary=N: use N-ary Heap scheduler"<<std::endl;
+  std::cout << "      --no-event-pool: allocate events with the system allocator"<<std::endl;
   std::cout << "      --debug: enable some debugging"<<std::endl;
 }
 
@@ -159,6 +169,15 @@ int main (int argc, char *argv[])
     {
       input = new std::ifstream (filename);
     }
+  // the event pool is configured when the simulator is created
+  // so, this option must be handled before any other option.
+  for (int i = 0; i < argc; i++)
+    {
+      if (strcmp ("--no-event-pool", argv[i]) == 0)
+        {
+          Config::SetDefault ("ns3::DefaultSimulatorImpl::EnableEventPool", BooleanValue (false));
+        }
+    }
   while (argc > 0) 
     {
       ObjectFactory factory;
@@ -174,7 +193,7 @@ int main (int argc, char *argv[])
         } 
       else if (strcmp ("--map", argv[0]) == 0) 
         {
-          factory.SetTypeId ("ns3::HeapScheduler");
+          factory.SetTypeId ("ns3::MapScheduler");
           Simulator::SetScheduler (factory);
         } 
       else if (strcmp ("--calendar", argv[0]) == 0)
@@ -182,6 +201,17 @@ int main (int argc, char *argv[])
           factory.SetTypeId ("ns3::CalendarScheduler");
           Simulator::SetScheduler (factory);
         }
+      else if (strcmp ("--ladder", argv[0]) == 0)
+        {
+          factory.SetTypeId ("ns3::LadderScheduler");
+          Simulator::SetScheduler (factory);
+        }
+      else if (strncmp ("--dary=", argv[0], strlen("--dary=")) == 0)
+        {
+          factory.SetTypeId ("ns3::DaryHeapScheduler");
+          factory.Set ("Arity", UintegerValue (atoi (argv[0]+strlen ("--dary="))));
+          Simulator::SetScheduler (factory);
+        }
       else if (strcmp ("--debug", argv[0]) == 0) 
         {
           g_debug = true;
@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Measure the cost of the Time operations which the simulator and the
+// models use the most, and of the event loop itself. Compare the
+// output of a build configured with --enable-int64-time to the output
+// of a default build.
+
+#include "ns3/core-module.h"
+#include "ns3/core-config.h"
+#include <iostream>
+#include <string.h>
+#include <stdlib.h>
+
+using namespace ns3;
+
+static uint32_t g_n = 10000000;
+
+static void
+Report (const char *what, uint32_t n, double ms)
+{
+  std::cout << what << ": " << (ms * 1000000.0 / n) << " ns/op" << std::endl;
+}
+
+static void
+BenchArithmetic (void)
+{
+  SystemWallClockMs clock;
+  Time delay = NanoSeconds (3);
+  Time now = Seconds (1.0);
+  Time limit = Seconds (1000.0);
+  uint32_t count = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < g_n; i++)
+    {
+      // what the simulator does when an event is scheduled.
+      Time t = now + delay;
+      if (t < limit && t.IsPositive ())
+        {
+          count++;
+        }
+      now = TimeStep (t.GetTimeStep ());
+    }
+  Report ("add+compare", g_n, clock.End ());
+  if (count != g_n)
+    {
+      std::cerr << "unexpected result" << std::endl;
+    }
+}
+
+static void
+BenchConversions (void)
+{
+  SystemWallClockMs clock;
+  double sum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < g_n / 10; i++)
+    {
+      sum += Seconds (i * 1e-6).GetSeconds ();
+    }
+  Report ("Seconds+GetSeconds", g_n / 10, clock.End ());
+  clock.Start ();
+  Time scaled;
+  for (uint32_t i = 0; i < g_n / 10; i++)
+    {
+      scaled += Scalar (3) * MicroSeconds (i);
+    }
+  Report ("MicroSeconds+Scalar*Time", g_n / 10, clock.End ());
+  if (sum < 0 || scaled.IsStrictlyNegative ())
+    {
+      std::cerr << "unexpected result" << std::endl;
+    }
+}
+
+class EventLoop
+{
+public:
+  EventLoop ();
+  void Run (uint32_t n);
+private:
+  void Cb (void);
+  uint32_t m_n;
+  uint32_t m_total;
+};
+
+EventLoop::EventLoop ()
+  : m_n (0),
+    m_total (0)
+{}
+
+void
+EventLoop::Cb (void)
+{
+  m_n++;
+  if (m_n < m_total)
+    {
+      // a mix of integer and floating point delays, as in most models.
+      Simulator::Schedule ((m_n & 1) ? MicroSeconds (m_n % 1000) : Seconds ((m_n % 100) * 1e-5),
+                           &EventLoop::Cb, this);
+    }
+}
+
+void
+EventLoop::Run (uint32_t n)
+{
+  m_n = 0;
+  m_total = n;
+  SystemWallClockMs clock;
+  clock.Start ();
+  // keep 100 events in the event list.
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      Simulator::Schedule (NanoSeconds (i), &EventLoop::Cb, this);
+    }
+  Simulator::Run ();
+  Report ("event loop", m_n, clock.End ());
+  Simulator::Destroy ();
+}
+
+int main (int argc, char *argv[])
+{
+  for (int i = 1; i < argc; i++)
+    {
+      if (strncmp ("--n=", argv[i], strlen ("--n=")) == 0)
+        {
+          g_n = atoi (argv[i] + strlen ("--n="));
+        }
+      else
+        {
+          std::cout << "bench-time [--n=N]" << std::endl;
+          return 0;
+        }
+    }
+#ifdef USE_INT64_TIME
+  std::cout << "time representation: 64-bit integer" << std::endl;
+#else
+  std::cout << "time representation: high precision" << std::endl;
+#endif
+  BenchArithmetic ();
+  BenchConversions ();
+  EventLoop loop;
+  loop.Run (g_n / 10);
+  return 0;
+}
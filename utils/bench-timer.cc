@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Measure the cost of the protocol timers of many TCP-like flows: each
+// flow restarts its retransmission timer on every ACK it receives and
+// starts or cancels its delayed ACK timer on every segment, so that its
+// timers are restarted far more often than they expire. Compare the
+// output of "bench-timer" to that of "bench-timer --wheel".
+
+#include "ns3/core-module.h"
+#include <iostream>
+#include <vector>
+#include <string.h>
+#include <stdlib.h>
+
+using namespace ns3;
+
+class Flow
+{
+public:
+  Flow (uint32_t id);
+  void Start (void);
+  static uint64_t g_segments;
+  static uint64_t g_retransmits;
+  static uint64_t g_delayedAcks;
+private:
+  void Receive (void);
+  void Retransmit (void);
+  void DelayedAck (void);
+  uint32_t m_id;
+  Time m_rtt;
+  Timer m_rto;
+  Timer m_delAck;
+};
+
+uint64_t Flow::g_segments = 0;
+uint64_t Flow::g_retransmits = 0;
+uint64_t Flow::g_delayedAcks = 0;
+
+Flow::Flow (uint32_t id)
+  : m_id (id),
+    m_rtt (MicroSeconds (10000 + (id * 7919) % 90000)),
+    m_rto (Timer::CANCEL_ON_DESTROY),
+    m_delAck (Timer::CANCEL_ON_DESTROY)
+{
+  m_rto.SetFunction (&Flow::Retransmit, this);
+  m_rto.SetDelay (Seconds (1.0));
+  m_delAck.SetFunction (&Flow::DelayedAck, this);
+  m_delAck.SetDelay (MilliSeconds (200));
+}
+
+void
+Flow::Start (void)
+{
+  Simulator::ScheduleWithContext (m_id, m_rtt, &Flow::Receive, this);
+}
+
+void
+Flow::Receive (void)
+{
+  g_segments++;
+  m_rto.Cancel ();
+  m_rto.Schedule ();
+  // every other segment is acknowledged right away.
+  if (m_delAck.IsRunning ())
+    {
+      m_delAck.Cancel ();
+    }
+  else
+    {
+      m_delAck.Schedule ();
+    }
+  // one flow in a hundred stalls from time to time.
+  Time next = m_rtt;
+  if (m_id % 100 == 0 && g_segments % 7 == 0)
+    {
+      next = Seconds (1.5);
+    }
+  Simulator::Schedule (next, &Flow::Receive, this);
+}
+
+void
+Flow::Retransmit (void)
+{
+  g_retransmits++;
+}
+
+void
+Flow::DelayedAck (void)
+{
+  g_delayedAcks++;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nFlows = 100000;
+  double duration = 2.0;
+  bool wheel = false;
+  for (int i = 1; i < argc; i++)
+    {
+      if (strncmp ("--flows=", argv[i], strlen ("--flows=")) == 0)
+        {
+          nFlows = atoi (argv[i] + strlen ("--flows="));
+        }
+      else if (strncmp ("--duration=", argv[i], strlen ("--duration=")) == 0)
+        {
+          duration = atof (argv[i] + strlen ("--duration="));
+        }
+      else if (strcmp ("--wheel", argv[i]) == 0)
+        {
+          wheel = true;
+        }
+      else
+        {
+          std::cout << "bench-timer [--flows=N] [--duration=SECONDS] [--wheel]" << std::endl;
+          return 0;
+        }
+    }
+  GlobalValue::Bind ("TimerWheel", BooleanValue (wheel));
+
+  std::vector<Flow *> flows;
+  for (uint32_t i = 0; i < nFlows; i++)
+    {
+      flows.push_back (new Flow (i));
+      flows.back ()->Start ();
+    }
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (duration));
+  Simulator::Run ();
+  double ms = clock.End ();
+  std::cout << (wheel ? "timer wheel" : "simulator events") << ": "
+            << nFlows << " flows, " << Flow::g_segments << " segments, "
+            << Flow::g_retransmits << " retransmission timeouts, "
+            << Flow::g_delayedAcks << " delayed acks" << std::endl;
+  std::cout << ms << " ms, " << (ms * 1000000.0 / Flow::g_segments) << " ns/segment" << std::endl;
+  for (uint32_t i = 0; i < nFlows; i++)
+    {
+      delete flows[i];
+    }
+  Simulator::Destroy ();
+  return 0;
+}